@@ -8,6 +8,7 @@
 #include "VectorMath.h"
 #include <vector>
 #include <stack>
+#include <limits>
 
 #include "AABB.h"
 
@@ -77,6 +78,11 @@ struct PYBIND11_EXPORT AABBNode
                an update will only increase the volume of nodes. The tree should be rebuilt periodically instead of
                continually updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - Insert : Add a single particle to an existing tree. The particle is placed in the leaf that requires the least
+               enlargement. When that leaf is full, nearby leaves in the enclosing subtrees are tried. Runs in
+               O(log N) time. Returns false when no nearby leaf has room, in which case the tree must be rebuilt.
+    - Remove : Remove a single particle from the tree. A leaf that can hold all of its sibling's particles is merged
+               with its sibling into the parent node. Runs in O(log N) time.
 
     **Implementation details**
 
@@ -86,6 +92,11 @@ struct PYBIND11_EXPORT AABBNode
     are allocated as needed with allocate(). With multiple particles per leaf node, the total number of internal nodes
     needed is not known (but can be estimated) until build time.
 
+    Insert and remove never allocate nodes, so the in order layout needed by the stackless traversal is preserved.
+    When two sibling leaves are merged into their parent, the children are left in the array as dead nodes with no
+    particles and an empty AABB that never overlaps anything. The parent keeps its skip value, so traversals that
+    skip past it still skip over the dead nodes as well.
+
     For performance, no recursive calls are used. Instead, each function is either turned into a loop if it uses
     tail recursion, or it uses a local stack to traverse the tree. The stack is cached between calls to limit
     the amount of dynamic memory allocation.
@@ -167,6 +178,15 @@ class PYBIND11_EXPORT AABBTree
         //! Update the AABB of a particle
         inline void update(unsigned int idx, const AABB& aabb);
 
+        //! Insert a particle into the tree
+        inline bool insert(unsigned int idx, const AABB& aabb);
+
+        //! Remove a particle from the tree
+        inline void remove(unsigned int idx);
+
+        //! Change the index of a particle in the tree
+        inline void relabel(unsigned int old_idx, unsigned int new_idx);
+
         //! Get the height of a given particle's leaf node
         inline unsigned int height(unsigned int idx);
 
@@ -258,6 +278,31 @@ class PYBIND11_EXPORT AABBTree
 
         //! Update the skip value for a node
         inline unsigned int updateSkip(unsigned int idx);
+
+        //! Recompute the AABBs of all ancestors of a node
+        inline void updateParents(unsigned int node);
+
+        //! Merge two sibling leaves into their parent node
+        inline void mergeLeaves(unsigned int parent);
+
+        //! Find the leaf with room for another particle that needs the least enlargement to hold an AABB
+        inline unsigned int findLeaf(unsigned int node, const AABB& aabb) const;
+
+        //! Get an AABB that does not overlap anything and is the identity for merge()
+        static inline AABB emptyAABB()
+            {
+            Scalar big = std::numeric_limits<Scalar>::max();
+            return AABB(vec3<Scalar>(big, big, big), vec3<Scalar>(-big, -big, -big));
+            }
+
+        //! Get the volume of an AABB (zero for an empty AABB)
+        static inline Scalar volume(const AABB& aabb)
+            {
+            vec3<Scalar> len = aabb.getUpper() - aabb.getLower();
+            if (len.x < Scalar(0.0) || len.y < Scalar(0.0) || len.z < Scalar(0.0))
+                return Scalar(0.0);
+            return len.x*len.y*len.z;
+            }
     };
 
 
@@ -350,6 +395,151 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param idx Particle index to insert
+    \param aabb AABB of the new particle
+    \returns true if the particle was inserted, false if the tree needs to be rebuilt
+
+    insert() descends from the root into the child that needs the least volume enlargement to hold *aabb*. If the
+    leaf reached in this way is full, the subtrees of its ancestors (up to a fixed number of levels) are searched for
+    a leaf with room. No nodes are allocated, so when all of the nearby leaves are full the particle cannot be placed
+    and insert() returns false without modifying the tree.
+*/
+inline bool AABBTree::insert(unsigned int idx, const AABB& aabb)
+    {
+    if (m_num_nodes == 0 || m_root == INVALID_NODE)
+        return false;
+
+    if (idx >= m_mapping.size())
+        m_mapping.resize(idx+1, INVALID_NODE);
+
+    assert(m_mapping[idx] == INVALID_NODE);
+
+    // descend to the leaf that needs the least enlargement
+    unsigned int node = m_root;
+    while (!isNodeLeaf(node))
+        {
+        unsigned int left = m_nodes[node].left;
+        unsigned int right = m_nodes[node].right;
+
+        Scalar grow_left = volume(merge(m_nodes[left].aabb, aabb)) - volume(m_nodes[left].aabb);
+        Scalar grow_right = volume(merge(m_nodes[right].aabb, aabb)) - volume(m_nodes[right].aabb);
+
+        node = (grow_left <= grow_right) ? left : right;
+        }
+
+    // the leaf is full, look for room in the subtrees of the nearest ancestors
+    const unsigned int max_levels = 4;
+    unsigned int level = 0;
+    unsigned int subtree = node;
+    while (m_nodes[node].num_particles >= NODE_CAPACITY)
+        {
+        subtree = m_nodes[subtree].parent;
+        if (subtree == INVALID_NODE || level == max_levels)
+            return false;
+
+        unsigned int candidate = findLeaf(subtree, aabb);
+        if (candidate != INVALID_NODE)
+            node = candidate;
+        level++;
+        }
+
+    // add the particle to the leaf
+    AABBNode& leaf = m_nodes[node];
+    leaf.particles[leaf.num_particles] = idx;
+    leaf.particle_tags[leaf.num_particles] = aabb.tag;
+    leaf.num_particles++;
+    m_mapping[idx] = node;
+
+    if (!contains(leaf.aabb, aabb))
+        {
+        leaf.aabb = merge(leaf.aabb, aabb);
+        updateParents(node);
+        }
+
+    return true;
+    }
+
+/*! \param idx Particle index to remove
+
+    Remove the particle from its leaf. When the leaf and its sibling leaf together fit in a single node, both are
+    merged into the parent, which becomes a leaf. Merging repeats up the tree as long as possible.
+*/
+inline void AABBTree::remove(unsigned int idx)
+    {
+    assert(idx < m_mapping.size());
+
+    unsigned int node = m_mapping[idx];
+    assert(node != INVALID_NODE);
+
+    // remove the particle from the leaf, the last particle in the leaf takes its slot
+    AABBNode& leaf = m_nodes[node];
+    for (unsigned int i = 0; i < leaf.num_particles; i++)
+        {
+        if (leaf.particles[i] == idx)
+            {
+            leaf.particles[i] = leaf.particles[leaf.num_particles-1];
+            leaf.particle_tags[i] = leaf.particle_tags[leaf.num_particles-1];
+            leaf.num_particles--;
+            break;
+            }
+        }
+    m_mapping[idx] = INVALID_NODE;
+
+    // an empty leaf does not need to be visited by queries
+    if (leaf.num_particles == 0)
+        leaf.aabb = emptyAABB();
+
+    // merge sibling leaves as long as they fit in their parent
+    unsigned int parent = m_nodes[node].parent;
+    while (parent != INVALID_NODE)
+        {
+        unsigned int left = m_nodes[parent].left;
+        unsigned int right = m_nodes[parent].right;
+
+        if (!isNodeLeaf(left) || !isNodeLeaf(right)
+            || m_nodes[left].num_particles + m_nodes[right].num_particles > NODE_CAPACITY)
+            break;
+
+        mergeLeaves(parent);
+        node = parent;
+        parent = m_nodes[node].parent;
+        }
+
+    updateParents(node);
+    }
+
+/*! \param old_idx Current index of the particle in the tree
+    \param new_idx New index of the particle
+
+    Use relabel() to keep the tree consistent when the particle data moves a particle to a new index.
+*/
+inline void AABBTree::relabel(unsigned int old_idx, unsigned int new_idx)
+    {
+    assert(old_idx < m_mapping.size());
+
+    if (old_idx == new_idx)
+        return;
+
+    unsigned int node = m_mapping[old_idx];
+    assert(node != INVALID_NODE);
+
+    if (new_idx >= m_mapping.size())
+        m_mapping.resize(new_idx+1, INVALID_NODE);
+
+    AABBNode& leaf = m_nodes[node];
+    for (unsigned int i = 0; i < leaf.num_particles; i++)
+        {
+        if (leaf.particles[i] == old_idx)
+            {
+            leaf.particles[i] = new_idx;
+            break;
+            }
+        }
+
+    m_mapping[new_idx] = node;
+    m_mapping[old_idx] = INVALID_NODE;
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -573,6 +763,89 @@ inline unsigned int AABBTree::updateSkip(unsigned int idx)
         }
     }
 
+/*! \param node Index of the node to start from
+
+    Recompute the AABBs of all ancestors of *node* from their children. AABBs may shrink as well as grow.
+*/
+inline void AABBTree::updateParents(unsigned int node)
+    {
+    unsigned int current_node = m_nodes[node].parent;
+    while (current_node != INVALID_NODE)
+        {
+        unsigned int left_idx = m_nodes[current_node].left;
+        unsigned int right_idx = m_nodes[current_node].right;
+
+        m_nodes[current_node].aabb = merge(m_nodes[left_idx].aabb, m_nodes[right_idx].aabb);
+        current_node = m_nodes[current_node].parent;
+        }
+    }
+
+/*! \param parent Index of the internal node whose two leaf children are merged
+
+    All particles of the two children are moved into *parent*, which becomes a leaf. The children remain in the node
+    array as dead nodes. They keep their skip values and get an empty AABB, so traversals pass over them quickly.
+*/
+inline void AABBTree::mergeLeaves(unsigned int parent)
+    {
+    unsigned int children[2] = {m_nodes[parent].left, m_nodes[parent].right};
+
+    AABBNode& p = m_nodes[parent];
+    p.aabb = merge(m_nodes[children[0]].aabb, m_nodes[children[1]].aabb);
+    p.left = p.right = INVALID_NODE;
+    p.num_particles = 0;
+
+    for (unsigned int c = 0; c < 2; c++)
+        {
+        AABBNode& child = m_nodes[children[c]];
+        for (unsigned int i = 0; i < child.num_particles; i++)
+            {
+            p.particles[p.num_particles] = child.particles[i];
+            p.particle_tags[p.num_particles] = child.particle_tags[i];
+            m_mapping[child.particles[i]] = parent;
+            p.num_particles++;
+            }
+
+        child.num_particles = 0;
+        child.aabb = emptyAABB();
+        }
+    }
+
+/*! \param node Root of the subtree to search
+    \param aabb AABB to be inserted
+    \returns Index of the leaf, or INVALID_NODE if there is no room in the subtree
+
+    The nodes of a subtree are stored contiguously from *node* to *node* + skip, so the search is a linear scan that
+    steps over dead nodes.
+*/
+inline unsigned int AABBTree::findLeaf(unsigned int node, const AABB& aabb) const
+    {
+    unsigned int best_node = INVALID_NODE;
+    Scalar best_grow = std::numeric_limits<Scalar>::max();
+
+    unsigned int end = node + m_nodes[node].skip;
+    for (unsigned int cur = node; cur <= end; cur++)
+        {
+        const AABBNode& cur_node = m_nodes[cur];
+        if (cur_node.left != INVALID_NODE)
+            continue;
+
+        if (cur_node.num_particles < NODE_CAPACITY)
+            {
+            Scalar grow = volume(merge(cur_node.aabb, aabb)) - volume(cur_node.aabb);
+            if (grow < best_grow)
+                {
+                best_grow = grow;
+                best_node = cur;
+                }
+            }
+
+        // a leaf merged from a subtree is followed by the dead nodes of that subtree
+        cur += cur_node.skip;
+        }
+
+    return best_node;
+    }
+
 /*! Allocates a new node in the tree
 */
 inline unsigned int AABBTree::allocateNode()
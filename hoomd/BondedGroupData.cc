@@ -15,6 +15,8 @@
 
 #include "hoomd/extern/pybind/include/pybind11/numpy.h"
 
+#include <algorithm>
+
 #ifdef ENABLE_CUDA
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -44,7 +46,7 @@ template<unsigned int group_size, typename Group, const char *name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true), m_topology_version(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name<< "s, n=" << group_size << ") "
         << endl;
@@ -89,12 +91,18 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
 /*! \param exec_conf Execution configuration
     \param pdata The particle data to associate with
     \param snapshot Snapshot to initialize from
+    \param distributed True if every rank holds a slice of the groups (see initializeFromDistributedSnapshot())
+    \param tags (distributed only) Tags of the groups in the slice, empty to number them by slice
+    \param local (distributed only) True if every rank holds exactly the groups with members in its own domain
  */
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
-    const Snapshot& snapshot)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
+    const Snapshot& snapshot,
+    bool distributed,
+    const std::vector<unsigned int>& tags,
+    bool local)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true), m_topology_version(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
@@ -111,7 +119,12 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     #endif
 
     // initialize from snapshot
-    initializeFromSnapshot(snapshot);
+    #ifdef ENABLE_MPI
+    if (distributed && m_pdata->getDomainDecomposition())
+        initializeFromDistributedSnapshot(snapshot, tags, local);
+    else
+    #endif
+        initializeFromSnapshot(snapshot);
 
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
@@ -139,6 +152,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initialize()
     {
     // reset global number of groups
     m_nglobal = 0;
+    m_topology_version++;
 
     // reset local number of groups
     m_n_groups = 0;
@@ -303,15 +317,263 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+#ifdef ENABLE_MPI
+/*! \param snapshot Slice of the groups read by this rank
+
+    Every rank holds a different, contiguous slice of the global group list (see GSDReader). Group tags are
+    assigned in order of increasing rank. The particle data must already be initialized, and the groups
+    are routed to the ranks that own their members in two point-to-point exchanges: first to the rank that
+    resolves the owner of each member tag (tag / ceil(N/n_ranks)), and from there to the owner. No rank
+    ever holds the complete list of groups.
+
+    When any rank passes explicit \a tags (see CheckpointReader), all ranks must pass one tag per group of their
+    slice. The tags are kept as given, a group may appear in the slices of several ranks, and unused tags below
+    the maximum tag are recycled. With \a local, every rank holds exactly the groups with members in its own
+    domain, and they are stored without routing.
+
+    \pre The type mapping is identical on all ranks.
+*/
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
-unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromDistributedSnapshot(const Snapshot& snapshot,
+    const std::vector<unsigned int>& tags,
+    bool local)
     {
-    // we are changing the local number of groups, so remove ghosts
-    removeAllGhostGroups();
+    assert(m_pdata->getDomainDecomposition());
 
-    typeval_t typeval = g.get_typeval();
-    members_t member_tags = g.get_members();
+    // every rank checks its own slice
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid " << name << " data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+        }
+
+    // re-initialize data structures
+    initialize();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int size = m_exec_conf->getNRanks();
+    unsigned int my_rank = m_exec_conf->getRank();
+
+    unsigned int n_slice = snapshot.groups.size();
+
+    int explicit_tags = ! tags.empty();
+    MPI_Allreduce(MPI_IN_PLACE, &explicit_tags, 1, MPI_INT, MPI_LOR, mpi_comm);
+
+    // the first tag of this slice is the number of groups on all lower ranks
+    unsigned int tag_offset = 0;
+    unsigned int nglobal = 0;
+    std::vector<unsigned int> all_tags;
+    if (explicit_tags)
+        {
+        if (tags.size() != n_slice)
+            {
+            m_exec_conf->msg->error() << "init.*: Number of tags does not match the number of " << name << "s."
+                                      << std::endl;
+            throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+            }
+
+        // groups spanning several domains are held by more than one rank
+        std::vector<unsigned int> counts;
+        all_gather_array(tags.data(), n_slice, all_tags, counts, mpi_comm);
+        std::sort(all_tags.begin(), all_tags.end());
+        all_tags.erase(std::unique(all_tags.begin(), all_tags.end()), all_tags.end());
+        nglobal = all_tags.size();
+        }
+    else
+        {
+        MPI_Exscan(&n_slice, &tag_offset, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        if (my_rank == 0)
+            tag_offset = 0;
+
+        MPI_Allreduce(&n_slice, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        }
+
+    if (nglobal == 0)
+        return;
+
+    //! Group record exchanged between ranks
+    struct group_record_t
+        {
+        members_t members;      //!< Member tags
+        typeval_t typeval;      //!< Type or constraint value
+        unsigned int tag;       //!< Group tag
+        };
+
+    std::vector<group_record_t> slice_groups(n_slice);
+    for (unsigned int i = 0; i < n_slice; ++i)
+        {
+        group_record_t& g = slice_groups[i];
+        g.members = snapshot.groups[i];
+        if (has_type_mapping)
+            g.typeval.type = snapshot.type_id[i];
+        else
+            g.typeval.val = snapshot.val[i];
+        g.tag = explicit_tags ? tags[i] : tag_offset + i;
+
+        checkGroup(g.members, g.typeval);
+        }
+
+    std::vector<group_record_t> local_groups;
+    if (local)
+        {
+        // the groups are already on the ranks that own their members
+        local_groups.swap(slice_groups);
+        }
+    else
+        {
+        // every rank resolves the owners of a contiguous range of particle tags (which may have holes)
+        unsigned int n_particles = m_pdata->getRTags().size();
+        unsigned int n_dir = (n_particles + size - 1) / size;
+        unsigned int dir_begin = my_rank*n_dir;
+
+        std::vector<unsigned int> owner;
+            {
+            std::vector< std::vector<uint2> > send_owner(size);
+            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+            for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+                {
+                unsigned int tag = h_tag.data[idx];
+                send_owner[tag / n_dir].push_back(make_uint2(tag, my_rank));
+                }
+
+            std::vector<uint2> recv_owner;
+            exchange_v(send_owner, recv_owner, mpi_comm);
+
+            owner.resize(n_dir);
+            for (auto it = recv_owner.begin(); it != recv_owner.end(); ++it)
+                owner[it->x - dir_begin] = it->y;
+            }
+
+        // send the groups of this slice to the ranks resolving their members
+        std::vector<group_record_t> dir_groups;
+            {
+            std::vector< std::vector<group_record_t> > send_groups(size);
+            for (auto it = slice_groups.begin(); it != slice_groups.end(); ++it)
+                {
+                const group_record_t& g = *it;
+                for (unsigned int j = 0; j < group_size; ++j)
+                    {
+                    unsigned int dest = g.members.tag[j] / n_dir;
 
+                    // send every group only once to each rank
+                    bool sent = false;
+                    for (unsigned int k = 0; k < j; ++k)
+                        if (g.members.tag[k] / n_dir == dest)
+                            sent = true;
+
+                    if (! sent)
+                        send_groups[dest].push_back(g);
+                    }
+                }
+
+            slice_groups.clear();
+
+            exchange_v(send_groups, dir_groups, mpi_comm);
+            }
+
+        // forward the groups to the owners of their members
+            {
+            std::vector< std::vector<group_record_t> > send_groups(size);
+            for (auto it = dir_groups.begin(); it != dir_groups.end(); ++it)
+                {
+                unsigned int dest[group_size];
+                unsigned int n_dest = 0;
+
+                for (unsigned int j = 0; j < group_size; ++j)
+                    {
+                    unsigned int tag = it->members.tag[j];
+                    if (tag / n_dir != my_rank)
+                        continue;
+
+                    unsigned int rank = owner[tag - dir_begin];
+                    bool found = false;
+                    for (unsigned int k = 0; k < n_dest; ++k)
+                        if (dest[k] == rank)
+                            found = true;
+
+                    if (! found)
+                        dest[n_dest++] = rank;
+                    }
+
+                for (unsigned int k = 0; k < n_dest; ++k)
+                    send_groups[dest[k]].push_back(*it);
+                }
+            dir_groups.clear();
+
+            exchange_v(send_groups, local_groups, mpi_comm);
+            }
+        }
+
+    // groups with members resolved by different ranks (or held in several slices) arrive more than once
+    std::sort(local_groups.begin(), local_groups.end(),
+        [](const group_record_t& a, const group_record_t& b) { return a.tag < b.tag; });
+    local_groups.erase(std::unique(local_groups.begin(), local_groups.end(),
+        [](const group_record_t& a, const group_record_t& b) { return a.tag == b.tag; }), local_groups.end());
+
+    // store local groups
+    unsigned int n_tags = explicit_tags ? all_tags.back() + 1 : nglobal;
+    m_group_rtag.resize(n_tags);
+        {
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::overwrite);
+        for (unsigned int tag = 0; tag < n_tags; ++tag)
+            h_group_rtag.data[tag] = GROUP_NOT_LOCAL;
+        for (unsigned int i = 0; i < local_groups.size(); ++i)
+            h_group_rtag.data[local_groups[i].tag] = i;
+        }
+
+    for (auto it = local_groups.begin(); it != local_groups.end(); ++it)
+        {
+        m_groups.push_back(it->members);
+        m_group_typeval.push_back(it->typeval);
+        m_group_tag.push_back(it->tag);
+
+        ranks_t r;
+        // initialize with zero
+        for (unsigned int i = 0; i < group_size; ++i)
+            r.idx[i] = 0;
+
+        m_group_ranks.push_back(r);
+        }
+    m_n_groups = local_groups.size();
+
+    // update list of active tags
+    if (explicit_tags)
+        {
+        m_tag_set.insert(all_tags.begin(), all_tags.end());
+
+        // unused tags below the maximum tag are recycled, like the tags of removed groups
+        for (unsigned int tag = 0; tag < n_tags; ++tag)
+            if (! m_tag_set.count(tag))
+                m_recycled_tags.push(tag);
+        }
+    else
+        {
+        for (unsigned int tag = 0; tag < nglobal; ++tag)
+            m_tag_set.insert(tag);
+        }
+    m_invalid_cached_tags = true;
+
+    m_nglobal = nglobal;
+    m_topology_version++;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    }
+#endif
+
+/*! \param member_tags Tags of the group members
+    \param typeval Type (or constraint value) of the group
+
+    Throws an exception if a member tag is out of bounds, a particle occurs twice, or the type is invalid.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::checkGroup(const members_t& member_tags,
+    const typeval_t& typeval) const
+    {
     unsigned int max_tag = m_pdata->getMaximumTag();
 
     // check for some silly errors a user could make
@@ -350,6 +612,18 @@ unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBond
             throw std::runtime_error(std::string("Error adding ") + name);
             }
         }
+    }
+
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
+    {
+    // we are changing the local number of groups, so remove ghosts
+    removeAllGhostGroups();
+
+    typeval_t typeval = g.get_typeval();
+    members_t member_tags = g.get_members();
+
+    checkGroup(member_tags, typeval);
 
     unsigned int tag = 0;
 
@@ -422,6 +696,7 @@ unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBond
 
     // increment number of bonded groups
     m_nglobal++;
+    m_topology_version++;
 
     // notify observers
     m_group_num_change_signal.emit();
@@ -643,6 +918,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGro
     // maintain a stack of deleted group tags for future recycling
     m_recycled_tags.push(tag);
     m_nglobal--;
+    m_topology_version++;
 
     // notify observers
     m_group_num_change_signal.emit();
@@ -693,6 +969,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::setTypeName(uns
         }
 
     m_type_mapping[type] = new_name;
+    m_topology_version++;
     }
 
 /*! Rebuild the cached vector of active tags, if necessary
@@ -944,104 +1221,115 @@ std::map<unsigned int, unsigned int> BondedGroupData<group_size, Group, name, ha
     // map to lookup snapshot index by tag
     std::map<unsigned int, unsigned int> index;
 
-    std::map<unsigned int, unsigned int> rtag_map;
-    for (unsigned int group_idx = 0; group_idx < getN(); group_idx++)
-        {
-        unsigned int tag = m_group_tag[group_idx];
-        assert(m_group_rtag[tag] == group_idx);
-
-        rtag_map.insert(std::pair<unsigned int,unsigned int>(tag, group_idx));
-        }
-
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
-        // gather local data
-        std::vector<typeval_t> typevals; // Group types or constraint values
-        std::vector<members_t> members;  // Group members
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int root = 0;
 
-        for (unsigned int group_idx  = 0; group_idx < getN(); ++group_idx)
-            {
-            typevals.push_back(m_group_typeval[group_idx]);
-            members.push_back(m_groups[group_idx]);
-            }
-
-        std::vector< std::vector<typeval_t> > typevals_proc;     // Group types of every processor
-        std::vector< std::vector<members_t> > members_proc;      // Group members of every processor
-
-        std::vector< std::map<unsigned int, unsigned int> > rtag_map_proc; // List of reverse-lookup maps
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::read);
+        ArrayHandle<typeval_t> h_group_typeval(m_group_typeval, access_location::host, access_mode::read);
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
 
-        unsigned int size = m_exec_conf->getNRanks();
+        // gather the tags of all local groups to look up their snapshot indices
+        std::vector<unsigned int> tag_proc;      // Group tags, in rank order
+        std::vector<unsigned int> n_proc;        // Number of groups of every rank
+        gather_array(h_group_tag.data, getN(), tag_proc, n_proc, root, mpi_comm);
 
-        // resize arrays to accumulate group data of all ranks
-        typevals_proc.resize(size);
-        members_proc.resize(size);
-        rtag_map_proc.resize(size);
+        std::vector<unsigned int> snap_idx;      // Snapshot index of every group, in rank order
+        std::vector<unsigned int> rank_offset;   // Offset of every rank in snap_idx
 
-        // gather all processors' data
-        gather_v(typevals, typevals_proc, 0, m_exec_conf->getMPICommunicator());
-        gather_v(members, members_proc, 0, m_exec_conf->getMPICommunicator());
-        gather_v(rtag_map, rtag_map_proc, 0, m_exec_conf->getMPICommunicator());
-
-        if (m_exec_conf->getRank() == 0)
+        if (m_exec_conf->getRank() == root)
             {
             // allocate memory in snapshot
             snapshot.resize(getNGlobal());
 
-            assert(rtag_map_proc.size() == size);
-
-            // create single map of all group ranks and indices
-            // groups present on more than one processor will count as one group
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> > rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < size; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(std::make_pair(it->first, std::make_pair(irank, it->second)));
+            // the snapshot holds the groups in the order of the active tags
+            std::vector<unsigned int> tag_snap_idx(m_group_rtag.size(), GROUP_NOT_LOCAL);
+            unsigned int snap_id = 0;
+            std::set<unsigned int>::iterator active_tag_it;
+            for (active_tag_it = m_tag_set.begin(); active_tag_it != m_tag_set.end(); ++active_tag_it)
+                {
+                tag_snap_idx[*active_tag_it] = snap_id;
 
-            // add groups to snapshot
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> >::iterator rank_rtag_it;
+                // store tag in index
+                index.insert(std::make_pair(*active_tag_it, snap_id));
+                snap_id++;
+                }
 
-            // index in snapshot
-            unsigned int snap_id = 0;
+            // groups present on more than one processor are taken from the lowest rank
+            std::vector<bool> found(getNGlobal(), false);
+            snap_idx.resize(tag_proc.size());
+            for (unsigned int i = 0; i < tag_proc.size(); i++)
+                {
+                unsigned int group_snap_id = tag_snap_idx[tag_proc[i]];
+                if (group_snap_id != GROUP_NOT_LOCAL && !found[group_snap_id])
+                    {
+                    snap_idx[i] = group_snap_id;
+                    found[group_snap_id] = true;
+                    }
+                else
+                    {
+                    snap_idx[i] = GROUP_NOT_LOCAL;
+                    }
+                }
 
-            // loop through active tags
-            std::set<unsigned int>::iterator active_tag_it;
             for (active_tag_it = m_tag_set.begin(); active_tag_it != m_tag_set.end(); ++active_tag_it)
                 {
-                unsigned int group_tag = *active_tag_it;
-                rank_rtag_it = rank_rtag_map.find(group_tag);
-                if (rank_rtag_it == rank_rtag_map.end())
+                if (! found[tag_snap_idx[*active_tag_it]])
                     {
                     m_exec_conf->msg->error()
-                        << endl << "Could not find " << name << " " << group_tag << " on any processor. "
+                        << endl << "Could not find " << name << " " << *active_tag_it << " on any processor. "
                         << endl << endl;
                     throw std::runtime_error("Error gathering "+std::string(name)+"s");
                     }
+                }
 
-                // store tag in index
-                index.insert(std::make_pair(group_tag, snap_id));
+            rank_offset.resize(n_proc.size(), 0);
+            for (unsigned int irank = 1; irank < n_proc.size(); irank++)
+                rank_offset[irank] = rank_offset[irank-1] + n_proc[irank-1];
+            }
 
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
+        // gather the group data directly from the local arrays, writing every chunk into the snapshot
+        gather_array_chunked(h_group_typeval.data, getN(),
+            [&](unsigned int irank, unsigned int offset, const typeval_t *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                {
+                unsigned int snap_id = snap_idx[rank_offset[irank] + offset + i];
+                if (snap_id == GROUP_NOT_LOCAL)
+                    continue;
 
                 if (has_type_mapping)
-                    {
-                    snapshot.type_id[snap_id] = typevals_proc[rank][idx].type;
-                    }
+                    snapshot.type_id[snap_id] = data[i].type;
                 else
-                    {
-                    snapshot.val[snap_id] = typevals_proc[rank][idx].val;
-                    }
-                snapshot.groups[snap_id] = members_proc[rank][idx];
-                snap_id++;
+                    snapshot.val[snap_id] = data[i].val;
                 }
-            }
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_groups.data, getN(),
+            [&](unsigned int irank, unsigned int offset, const members_t *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                {
+                unsigned int snap_id = snap_idx[rank_offset[irank] + offset + i];
+                if (snap_id != GROUP_NOT_LOCAL)
+                    snapshot.groups[snap_id] = data[i];
+                }
+            }, root, mpi_comm);
         }
     else
     #endif
         {
+        std::map<unsigned int, unsigned int> rtag_map;
+        for (unsigned int group_idx = 0; group_idx < getN(); group_idx++)
+            {
+            unsigned int tag = m_group_tag[group_idx];
+            assert(m_group_rtag[tag] == group_idx);
+
+            rtag_map.insert(std::pair<unsigned int,unsigned int>(tag, group_idx));
+            }
+
         // allocate memory in snapshot
         snapshot.resize(getNGlobal());
 
@@ -43,6 +43,7 @@ const unsigned int GROUP_NOT_LOCAL ((unsigned int) 0xffffffff);
 #include <set>
 #include <vector>
 #include <map>
+#include <mutex>
 
 //! Storage data type for group members
 /*! We use a union to emphasize it that can contain either particle
@@ -239,13 +240,23 @@ class BondedGroupData
 
         //! Constructor to initialize from a snapshot
         BondedGroupData(std::shared_ptr<ParticleData> pdata,
-            const Snapshot& snapshot);
+            const Snapshot& snapshot,
+            bool distributed=false,
+            const std::vector<unsigned int>& tags=std::vector<unsigned int>(),
+            bool local=false);
 
         virtual ~BondedGroupData();
 
         //! Initialize from a snapshot
         virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from a snapshot slice held by every rank
+        void initializeFromDistributedSnapshot(const Snapshot& snapshot,
+            const std::vector<unsigned int>& tags=std::vector<unsigned int>(),
+            bool local=false);
+        #endif
+
         //! Take a snapshot
         virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
@@ -291,6 +302,15 @@ class BondedGroupData
             return m_nglobal;
             }
 
+        //! Get the topology version
+        /*! The version changes every time groups are added, removed, or reinitialized, or a type is renamed. It is
+            the same on all ranks, and does not change when groups migrate between domains.
+         */
+        uint64_t getTopologyVersion() const
+            {
+            return m_topology_version;
+            }
+
         //! Get the number of group types
         unsigned int getNTypes() const
             {
@@ -506,11 +526,7 @@ class BondedGroupData
         const GPUVector<members_t>& getGPUTable()
             {
             // rebuild lookup table if necessary
-            if (m_groups_dirty)
-                {
-                rebuildGPUTable();
-                m_groups_dirty = false;
-                }
+            checkUpdateGPUTable();
 
             return m_gpu_table;
             }
@@ -519,11 +535,7 @@ class BondedGroupData
         const GPUArray<unsigned >& getGPUPosTable()
             {
             // rebuild lookup table if necessary
-            if (m_groups_dirty)
-                {
-                rebuildGPUTable();
-                m_groups_dirty = false;
-                }
+            checkUpdateGPUTable();
 
             return m_gpu_pos_table;
             }
@@ -532,11 +544,7 @@ class BondedGroupData
         const Index2D& getGPUTableIndexer()
             {
             // rebuild lookup table if necessary
-            if (m_groups_dirty)
-                {
-                rebuildGPUTable();
-                m_groups_dirty = false;
-                }
+            checkUpdateGPUTable();
 
             return m_gpu_table_indexer;
             }
@@ -547,6 +555,55 @@ class BondedGroupData
             return m_gpu_n_groups;
             }
 
+        //! Loop over the groups of every local particle on the CPU
+        /*! \param f Called as f(idx, members, pos, type) for every group of every local particle \a idx, where
+                \a members holds the particle indices of the group members, members[pos] == idx, and \a type is the
+                group type (or the local group index for groups without a type mapping)
+
+            The loop uses the lookup-by-index table. With TBB, it is distributed over the particles, so every call may
+            write to the data of particle \a idx without synchronization.
+        */
+        template<class Func>
+        void forEachParticleGroup(const Func& f)
+            {
+            checkUpdateGPUTable();
+
+            ArrayHandle<members_t> h_table(m_gpu_table, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_pos_table(m_gpu_pos_table, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_n_groups(m_gpu_n_groups, access_location::host, access_mode::read);
+            const Index2D& table_indexer = m_gpu_table_indexer;
+
+            auto loop = [&](unsigned int begin, unsigned int end)
+                {
+                unsigned int members[group_size];
+                for (unsigned int idx = begin; idx < end; idx++)
+                    {
+                    for (unsigned int k = 0; k < h_n_groups.data[idx]; k++)
+                        {
+                        const members_t& g = h_table.data[table_indexer(idx, k)];
+                        unsigned int pos = h_pos_table.data[table_indexer(idx, k)];
+
+                        // the table lists the other members, insert idx at its position in the group
+                        unsigned int n = 0;
+                        for (unsigned int j = 0; j < group_size; ++j)
+                            members[j] = (j == pos) ? idx : g.idx[n++];
+
+                        f(idx, (const unsigned int *)members, pos, g.idx[group_size-1]);
+                        }
+                    }
+                };
+
+            #ifdef ENABLE_TBB
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                loop(r.begin(), r.end());
+                });
+            #else
+            loop(0, m_pdata->getN());
+            #endif
+            }
+
         /*
          * add/remove groups globally
          */
@@ -645,6 +702,7 @@ class BondedGroupData
 
     private:
         bool m_groups_dirty;                         //!< Is it necessary to rebuild the lookup-by-index table?
+        uint64_t m_topology_version;                 //!< Incremented on every global change of the groups
 
         Nano::Signal<void ()> m_group_num_change_signal; //!< Signal that is triggered when groups are added or deleted (globally)
         Nano::Signal<void ()> m_group_reorder_signal;    //!< Signal that is triggered when groups are added or deleted locally
@@ -652,12 +710,29 @@ class BondedGroupData
         //! Initialize internal memory
         void initialize();
 
+        //! Helper function to check the members and type of a group before it is added
+        void checkGroup(const members_t& member_tags, const typeval_t& typeval) const;
+
         //! Helper function to rebuild the active tag cache if necessary
         void maybe_rebuild_tag_cache();
 
         //! Helper function to rebuild lookup by index table
         void rebuildGPUTable();
 
+        //! Rebuild the lookup by index table if necessary
+        void checkUpdateGPUTable()
+            {
+            // the table may be requested by several force computes evaluated concurrently
+            std::lock_guard<std::mutex> lock(m_table_mutex);
+            if (m_groups_dirty)
+                {
+                rebuildGPUTable();
+                m_groups_dirty = false;
+                }
+            }
+
+        std::mutex m_table_mutex;                    //!< Serializes rebuilds of the lookup table
+
         //! Resize internal tables
         /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
          */
@@ -21,7 +21,7 @@ namespace py = pybind11;
 */
 CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     : Compute(sysdef),  m_nominal_width(Scalar(1.0)), m_radius(1), m_compute_xyzf(true), m_compute_tdb(false),
-      m_compute_orientation(false), m_compute_idx(false), m_flag_charge(false), m_flag_type(false), m_sort_cell_list(false),
+      m_compute_orientation(false), m_compute_idx(false), m_compute_offset(false), m_flag_charge(false), m_flag_type(false), m_sort_cell_list(false),
       m_compute_adj_list(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing CellList" << endl;
@@ -362,6 +362,19 @@ void CellList::initializeMemory()
         m_idx.swap(idx);
         }
 
+    if (m_compute_offset)
+        {
+        GlobalArray<float4> offset(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        m_offset.swap(offset);
+        TAG_ALLOCATION(m_offset);
+        }
+    else
+        {
+        // array is no longer needed, discard it
+        GlobalArray<float4> offset;
+        m_offset.swap(offset);
+        }
+
     if (m_prof)
         m_prof->pop();
 
@@ -454,6 +467,7 @@ void CellList::computeCellList()
     ArrayHandle<Scalar4> h_cell_orientation(m_orientation, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar4> h_tdb(m_tdb, access_location::host, access_mode::overwrite);
+    ArrayHandle<float4> h_offset(m_offset, access_location::host, access_mode::overwrite);
     uint3 conditions = make_uint3(0,0,0);
 
     // shorthand copies of the indexers
@@ -498,6 +512,9 @@ void CellList::computeCellList()
             continue;
             }
 
+        // the offset is taken from the cell before wrapping, so that it stays bounded by the cell width
+        int3 origin_cell = make_int3(ib, jb, kb);
+
         // need to handle the case where the particle is exactly at the box hi
         if (ib == (int)m_dim.x && periodic.x)
             ib = 0;
@@ -559,6 +576,13 @@ void CellList::computeCellList()
                 {
                 h_cell_idx.data[cli(offset, bin)] = n;
                 }
+
+            if (m_compute_offset)
+                {
+                // subtract in full precision, the difference is small enough for a float
+                Scalar3 d = p - getCellOrigin(box, origin_cell.x, origin_cell.y, origin_cell.z);
+                h_offset.data[cli(offset, bin)] = make_float4(float(d.x), float(d.y), float(d.z), __int_as_float(n));
+                }
             }
         else
             {
@@ -579,6 +603,23 @@ void CellList::computeCellList()
         m_prof->pop();
     }
 
+/*! \param box The local box
+    \param i Cell index in x
+    \param j Cell index in y
+    \param k Cell index in z
+    \returns The position of the corner of cell (i,j,k) with the smallest fractional coordinates, including the ghost
+              layer offset
+
+    The difference between the origins of two cells is an integer number of cell widths in fractional coordinates.
+*/
+Scalar3 CellList::getCellOrigin(const BoxDim& box, unsigned int i, unsigned int j, unsigned int k) const
+    {
+    Scalar3 ghost_frac = m_ghost_width / box.getNearestPlaneDistance();
+    Scalar3 f = make_scalar3(Scalar(i)/Scalar(m_dim.x), Scalar(j)/Scalar(m_dim.y), Scalar(k)/Scalar(m_dim.z));
+    f = f*(make_scalar3(1,1,1) + Scalar(2.0)*ghost_frac) - ghost_frac;
+    return box.makeCoordinates(f);
+    }
+
 bool CellList::checkConditions()
     {
     bool result = false;
@@ -687,6 +728,7 @@ void export_CellList(py::module& m)
         .def("setNominalWidth", &CellList::setNominalWidth)
         .def("setRadius", &CellList::setRadius)
         .def("setComputeTDB", &CellList::setComputeTDB)
+        .def("setComputeOffset", &CellList::setComputeOffset)
         .def("setFlagCharge", &CellList::setFlagCharge)
         .def("setFlagIndex", &CellList::setFlagIndex)
         .def("setSortCellList", &CellList::setSortCellList)
@@ -51,6 +51,11 @@
        It is only computed is requested to reduce the computation time when it is not needed.
      - The \c idx array contains unsigned int elements listing the index of each particle. It is useful when xyzf is
        set to hold type. It is only computed is requested to reduce the computation time when it is not needed.
+     - The \c offset array contains float4 elements each of which holds the x,y,z coordinates of the particle relative
+       to the origin of its cell (see getCellOrigin()) in single precision, and the particle index. Because the offsets
+       are bounded by the cell width, they keep the full single precision resolution regardless of the box size.
+       Particles exactly at the upper box boundary are wrapped into the first cell, but keep their offset from the
+       cell one past the last. It is only computed if requested, and only by the CPU implementation.
      - The cell_adj array lists indices of adjacent cells. A specified radius (3,5,7,...) of cells is included in the
        list.
 
@@ -71,7 +76,7 @@
      - <code>cell_size[cidx]</code> is the number of particles in the cell with index \c cidx
      - \c xyzf is Ncells x Nmax and <code>xyzf[cell_list_indexer(offset,cidx)]</code> is the data stored for particle
        \c offset in cell \c cidx (\c offset can vary from 0 to <code>cell_size[cidx]-1</code>)
-     - \c tbd, idx, and orientation is structured identically to \c xyzf
+     - \c tbd, idx, orientation, and offset is structured identically to \c xyzf
      - <code>cell_adj[cell_adj_indexer(offset,cidx)]</code> is the cell index for neighboring cell \c offset to \c cidx.
        \c offset can vary from 0 to (radius*2+1)^3-1 (typically 26 with radius 1)
 
@@ -148,6 +153,13 @@ class PYBIND11_EXPORT CellList : public Compute
             m_params_changed = true;
             }
 
+        //! Specify if the single precision offset cell list is to be computed
+        void setComputeOffset(bool compute_offset)
+            {
+            m_compute_offset = compute_offset;
+            m_params_changed = true;
+            }
+
         //! Specify that the flag is to be filled with the particle charge
         void setFlagCharge()
             {
@@ -272,6 +284,9 @@ class PYBIND11_EXPORT CellList : public Compute
             return m_actual_width;
             }
 
+        //! Get the position of the lower corner of a cell
+        Scalar3 getCellOrigin(const BoxDim& box, unsigned int i, unsigned int j, unsigned int k) const;
+
         // @}
         //! \name Get data
         // @{
@@ -324,6 +339,12 @@ class PYBIND11_EXPORT CellList : public Compute
             return m_idx;
             }
 
+        //! Get the cell list containing the single precision offsets from the cell origin and the index
+        const GlobalArray<float4>& getOffsetArray() const
+            {
+            return m_offset;
+            }
+
         //! Get the cell list containing index (per device)
         virtual const GlobalArray<unsigned int>& getIndexArrayPerDevice() const
             {
@@ -362,6 +383,7 @@ class PYBIND11_EXPORT CellList : public Compute
         bool m_compute_tdb;          //!< true if the tdb list should be computed
         bool m_compute_orientation;  //!< true if the orientation list should be computed
         bool m_compute_idx;          //!< true if the idx list should be computed
+        bool m_compute_offset;       //!< true if the offset list should be computed
         bool m_flag_charge;          //!< true if the flag should be set to the charge, it will be index (or type) otherwise
         bool m_flag_type;            //!< true if the flag should be set to type, it will be index otherwise
         bool m_params_changed;       //!< Set to true when parameters are changed
@@ -385,6 +407,7 @@ class PYBIND11_EXPORT CellList : public Compute
         GlobalArray<Scalar4> m_tdb;             //!< Cell list with type,diameter,body
         GlobalArray<Scalar4> m_orientation;     //!< Cell list with orientation
         GlobalArray<unsigned int> m_idx;        //!< Cell list with index
+        GlobalArray<float4> m_offset;           //!< Cell list with offset from the cell origin and index
         GlobalArray<uint3> m_conditions;        //!< Condition flags set during the computeCellList() call
 
         bool m_sort_cell_list;               //!< If true, sort cell list
@@ -0,0 +1,508 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CheckpointReader.cc
+    \brief Defines the CheckpointReader class
+*/
+
+#include "CheckpointReader.h"
+#include "SnapshotSystemData.h"
+#include "SystemDefinition.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#include "DomainDecomposition.h"
+#endif
+
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+using namespace std;
+namespace py = pybind11;
+
+namespace
+{
+//! Throw an exception for a file that cannot be read
+[[noreturn]] void read_error(const std::string& fname)
+    {
+    throw runtime_error("Error reading checkpoint file " + fname);
+    }
+
+//! Read a plain value
+template<class T>
+void read_value(std::istream& in, const std::string& fname, T& value)
+    {
+    in.read((char *) &value, sizeof(T));
+    if (! in)
+        read_error(fname);
+    }
+
+//! Read a vector of plain values prefixed by its length
+template<class T>
+void read_vector(std::istream& in, const std::string& fname, std::vector<T>& values)
+    {
+    uint64_t n = 0;
+    read_value(in, fname, n);
+    values.resize(n);
+    if (n)
+        {
+        in.read((char *) values.data(), n*sizeof(T));
+        if (! in)
+            read_error(fname);
+        }
+    }
+
+//! Read a string prefixed by its length
+void read_string(std::istream& in, const std::string& fname, std::string& s)
+    {
+    std::vector<char> chars;
+    read_vector(in, fname, chars);
+    s.assign(chars.begin(), chars.end());
+    }
+
+//! Read a list of type names
+void read_types(std::istream& in, const std::string& fname, std::vector<std::string>& types)
+    {
+    uint64_t n = 0;
+    read_value(in, fname, n);
+    types.resize(n);
+    for (unsigned int i = 0; i < n; ++i)
+        read_string(in, fname, types[i]);
+    }
+}
+
+/*! \param exec_conf The execution configuration
+    \param name Base name of the checkpoint files
+*/
+CheckpointReader::CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string &name)
+    : m_exec_conf(exec_conf), m_name(name)
+    {
+    memset(&m_header, 0, sizeof(m_header));
+
+    int ok = 1;
+    if (m_exec_conf->isRoot())
+        {
+        std::string fname = CheckpointWriter::getFileName(name, 0);
+        m_exec_conf->msg->notice(3) << "data.checkpoint_reader: reading " << fname << endl;
+        try
+            {
+            std::ifstream in(fname.c_str(), std::ios_base::in | std::ios_base::binary);
+            if (! in.good())
+                read_error(fname);
+            readHeader(in, fname, m_header, m_fractions);
+            }
+        catch (const std::runtime_error& e)
+            {
+            m_exec_conf->msg->error() << "init.read_checkpoint: " << e.what() << endl;
+            ok = 0;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Bcast(&ok, 1, MPI_INT, 0, mpi_comm);
+        MPI_Bcast(&m_header, sizeof(m_header), MPI_BYTE, 0, mpi_comm);
+        for (unsigned int dir = 0; dir < 3; ++dir)
+            bcast(m_fractions[dir], 0, mpi_comm);
+        }
+    #endif
+
+    if (! ok)
+        throw runtime_error("Error reading checkpoint");
+    }
+
+/*! \param in Stream to read from
+    \param fname Name of the file, for error messages
+    \param header Header to read into
+    \param fractions Cumulative domain fractions to read into (may be NULL)
+*/
+void CheckpointReader::readHeader(std::istream& in, const std::string& fname, checkpoint_header_t& header,
+    std::vector<double> *fractions)
+    {
+    read_value(in, fname, header);
+    if (strncmp(header.magic, "HOOMDCP1", 8) != 0)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " is not a checkpoint file" << endl;
+        read_error(fname);
+        }
+    if (header.scalar_size != sizeof(Scalar))
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " was written with a different precision"
+                                  << endl;
+        read_error(fname);
+        }
+
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        {
+        std::vector<double> cum;
+        read_vector(in, fname, cum);
+        if (fractions)
+            fractions[dir] = cum;
+        }
+    }
+
+BoxDim CheckpointReader::getBox() const
+    {
+    BoxDim box(make_scalar3(m_header.L[0], m_header.L[1], m_header.L[2]));
+    box.setTiltFactors(m_header.tilt[0], m_header.tilt[1], m_header.tilt[2]);
+    box.setPeriodic(make_uchar3(m_header.periodic[0], m_header.periodic[1], m_header.periodic[2]));
+    return box;
+    }
+
+/*! \param dir Direction (0: x, 1: y, 2: z)
+    \returns The widths of all domains but the last, in the format of comm.decomposition
+*/
+py::list CheckpointReader::getFractions(unsigned int dir) const
+    {
+    py::list result;
+    const std::vector<double>& cum = m_fractions[dir % 3];
+    for (unsigned int i = 0; i + 2 < cum.size(); ++i)
+        result.append(cum[i+1] - cum[i]);
+    return result;
+    }
+
+/*! \param file Index of the file to read
+    \param particles Particle records to append to
+    \param snapshot Snapshot to append the bonded groups, integrator data, and type mappings to
+    \param all_groups If false, read only the primary copy of every group
+*/
+void CheckpointReader::readFile(unsigned int file,
+                                std::vector<checkpoint_particle_t>& particles,
+                                SnapshotSystemData<double>& snapshot,
+                                bool all_groups)
+    {
+    std::string fname = CheckpointWriter::getFileName(m_name, file);
+    m_exec_conf->msg->notice(4) << "data.checkpoint_reader: reading " << fname << endl;
+
+    std::ifstream in(fname.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (! in.good())
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: Unable to open " << fname << endl;
+        read_error(fname);
+        }
+
+    checkpoint_header_t header;
+    readHeader(in, fname, header, NULL);
+    if (header.timestep != m_header.timestep || header.n_ranks != m_header.n_ranks)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " belongs to a different checkpoint"
+                                  << endl;
+        read_error(fname);
+        }
+
+    read_types(in, fname, snapshot.particle_data.type_mapping);
+
+    std::vector<checkpoint_particle_t> file_particles;
+    read_vector(in, fname, file_particles);
+    particles.insert(particles.end(), file_particles.begin(), file_particles.end());
+
+    readGroups<BondData>(in, fname, snapshot.bond_data, snapshot.bond_tags, all_groups);
+    readGroups<AngleData>(in, fname, snapshot.angle_data, snapshot.angle_tags, all_groups);
+    readGroups<DihedralData>(in, fname, snapshot.dihedral_data, snapshot.dihedral_tags, all_groups);
+    readGroups<ImproperData>(in, fname, snapshot.improper_data, snapshot.improper_tags, all_groups);
+    readGroups<ConstraintData>(in, fname, snapshot.constraint_data, snapshot.constraint_tags, all_groups);
+    readGroups<PairData>(in, fname, snapshot.pair_data, snapshot.pair_tags, all_groups);
+
+    // integrator variables are identical in all files
+    uint64_t n_integrators = 0;
+    read_value(in, fname, n_integrators);
+    snapshot.integrator_data.resize(n_integrators);
+    for (unsigned int i = 0; i < n_integrators; ++i)
+        {
+        std::vector<double> variable;
+        read_string(in, fname, snapshot.integrator_data[i].type);
+        read_vector(in, fname, variable);
+        snapshot.integrator_data[i].variable.assign(variable.begin(), variable.end());
+        }
+
+    uint64_t n_state = 0;
+    read_value(in, fname, n_state);
+    for (unsigned int i = 0; i < n_state; ++i)
+        {
+        std::string name;
+        read_string(in, fname, name);
+        read_vector(in, fname, m_state[name]);
+        }
+    }
+
+/*! \param in Stream to read from
+    \param fname Name of the file, for error messages
+    \param snapshot Group snapshot to append to
+    \param tags Group tags to append to
+    \param all_groups If false, read only the primary copy of every group
+*/
+template<class group_data>
+void CheckpointReader::readGroups(std::istream& in,
+                                  const std::string& fname,
+                                  typename group_data::Snapshot& snapshot,
+                                  std::vector<unsigned int>& tags,
+                                  bool all_groups)
+    {
+    read_types(in, fname, snapshot.type_mapping);
+
+    std::vector< checkpoint_group_t<group_data::size> > groups;
+    read_vector(in, fname, groups);
+
+    for (auto it = groups.begin(); it != groups.end(); ++it)
+        {
+        if (! all_groups && ! it->primary)
+            continue;
+
+        typename group_data::members_t members;
+        for (unsigned int j = 0; j < group_data::size; ++j)
+            members.tag[j] = it->members[j];
+        snapshot.groups.push_back(members);
+
+        if (group_data::typemap_val)
+            snapshot.type_id.push_back(it->type);
+        else
+            snapshot.val.push_back(it->val);
+
+        tags.push_back(it->tag);
+        }
+    snapshot.size = snapshot.groups.size();
+    }
+
+/*! \param particles Particle records, sorted on output
+    \param snapshot Snapshot with the bonded groups and their tags, sorted and deduplicated on output
+
+    Tags of particles, groups, group members, and rigid bodies are renumbered in order of the original tags, and
+    the group tags are cleared, so that the snapshot can initialize a system without explicit tags.
+*/
+void CheckpointReader::compactTags(std::vector<checkpoint_particle_t>& particles, SnapshotSystemData<double>& snapshot)
+    {
+    std::sort(particles.begin(), particles.end(),
+        [](const checkpoint_particle_t& a, const checkpoint_particle_t& b) { return a.tag < b.tag; });
+
+    unsigned int n_tags = particles.empty() ? 0 : particles.back().tag + 1;
+    std::vector<unsigned int> tag_map(n_tags, NOT_LOCAL);
+    for (unsigned int i = 0; i < particles.size(); ++i)
+        {
+        tag_map[particles[i].tag] = i;
+        particles[i].tag = i;
+        }
+
+    for (auto it = particles.begin(); it != particles.end(); ++it)
+        if (it->body < MIN_FLOPPY && it->body < n_tags)
+            it->body = tag_map[it->body];
+
+    compactGroups<BondData>(snapshot.bond_data, snapshot.bond_tags, tag_map);
+    compactGroups<AngleData>(snapshot.angle_data, snapshot.angle_tags, tag_map);
+    compactGroups<DihedralData>(snapshot.dihedral_data, snapshot.dihedral_tags, tag_map);
+    compactGroups<ImproperData>(snapshot.improper_data, snapshot.improper_tags, tag_map);
+    compactGroups<ConstraintData>(snapshot.constraint_data, snapshot.constraint_tags, tag_map);
+    compactGroups<PairData>(snapshot.pair_data, snapshot.pair_tags, tag_map);
+    }
+
+/*! \param snapshot Group snapshot to sort
+    \param tags Group tags, cleared on output
+    \param particle_tag_map New particle tag by old particle tag
+*/
+template<class group_data>
+void CheckpointReader::compactGroups(typename group_data::Snapshot& snapshot,
+                                     std::vector<unsigned int>& tags,
+                                     const std::vector<unsigned int>& particle_tag_map)
+    {
+    std::vector<unsigned int> order(tags.size());
+    for (unsigned int i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&tags](unsigned int a, unsigned int b) { return tags[a] < tags[b]; });
+    order.erase(std::unique(order.begin(), order.end(),
+        [&tags](unsigned int a, unsigned int b) { return tags[a] == tags[b]; }), order.end());
+
+    typename group_data::Snapshot sorted;
+    sorted.type_mapping = snapshot.type_mapping;
+    sorted.resize(order.size());
+    for (unsigned int i = 0; i < order.size(); ++i)
+        {
+        for (unsigned int j = 0; j < group_data::size; ++j)
+            {
+            unsigned int tag = snapshot.groups[order[i]].tag[j];
+            sorted.groups[i].tag[j] = tag < particle_tag_map.size() ? particle_tag_map[tag] : NOT_LOCAL;
+            }
+
+        if (group_data::typemap_val)
+            sorted.type_id[i] = snapshot.type_id[order[i]];
+        else
+            sorted.val[i] = snapshot.val[order[i]];
+        }
+
+    snapshot = sorted;
+    tags.clear();
+    }
+
+/*! \returns A snapshot of the checkpoint
+
+    In MPI runs, this is a collective call and every rank holds its own part of the snapshot.
+*/
+std::shared_ptr< SnapshotSystemData<double> > CheckpointReader::getSnapshot()
+    {
+    std::shared_ptr< SnapshotSystemData<double> > snapshot(new SnapshotSystemData<double>());
+
+    snapshot->dimensions = m_header.dimensions;
+    snapshot->global_box = getBox();
+
+    std::vector<checkpoint_particle_t> particles;
+    unsigned int n_files = m_header.n_ranks;
+
+    #ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int rank = m_exec_conf->getRank();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+        snapshot->distributed = true;
+
+        // reload in place if the domains are the same as in the checkpoint
+        uint3 grid_size = m_decomposition->getGridSize();
+        bool local = n_files == n_ranks
+            && grid_size.x == m_header.grid_size[0]
+            && grid_size.y == m_header.grid_size[1]
+            && grid_size.z == m_header.grid_size[2];
+        for (unsigned int dir = 0; dir < 3 && local; ++dir)
+            {
+            std::vector<Scalar> cum = m_decomposition->getCumulativeFractions(dir);
+            local = cum.size() == m_fractions[dir].size();
+            for (unsigned int i = 0; i < cum.size() && local; ++i)
+                local = std::abs(cum[i] - m_fractions[dir][i]) < Scalar(1e-6);
+            }
+
+        if (local)
+            {
+            // find the file that the domain at this rank's grid position was written to
+            std::string fname = CheckpointWriter::getFileName(m_name, rank);
+            std::ifstream in(fname.c_str(), std::ios_base::in | std::ios_base::binary);
+            checkpoint_header_t header;
+            readHeader(in, fname, header, NULL);
+
+            uint3 file_pos = make_uint3(header.grid_pos[0], header.grid_pos[1], header.grid_pos[2]);
+            std::vector<uint3> all_file_pos;
+            all_gather_v(file_pos, all_file_pos, mpi_comm);
+
+            uint3 grid_pos = m_decomposition->getGridPos();
+            unsigned int file = n_files;
+            for (unsigned int i = 0; i < n_files; ++i)
+                if (all_file_pos[i].x == grid_pos.x && all_file_pos[i].y == grid_pos.y
+                    && all_file_pos[i].z == grid_pos.z)
+                    file = i;
+
+            if (file == n_files)
+                {
+                m_exec_conf->msg->error() << "init.read_checkpoint: No file for the domain at (" << grid_pos.x << ","
+                                          << grid_pos.y << "," << grid_pos.z << ")" << endl;
+                throw runtime_error("Error reading checkpoint");
+                }
+
+            m_exec_conf->msg->notice(2) << "init.read_checkpoint: restoring the domains in place" << endl;
+            readFile(file, particles, *snapshot, true);
+            snapshot->local = true;
+            }
+        else
+            {
+            m_exec_conf->msg->notice(2) << "init.read_checkpoint: domain decomposition differs from the checkpoint, "
+                                        << "redistributing particles" << endl;
+            for (unsigned int file = rank; file < n_files; file += n_ranks)
+                readFile(file, particles, *snapshot, false);
+
+            // ranks without a file need the type mappings, integrator variables, and state of the first one
+            bcast(snapshot->particle_data.type_mapping, 0, mpi_comm);
+            bcast(snapshot->bond_data.type_mapping, 0, mpi_comm);
+            bcast(snapshot->angle_data.type_mapping, 0, mpi_comm);
+            bcast(snapshot->dihedral_data.type_mapping, 0, mpi_comm);
+            bcast(snapshot->improper_data.type_mapping, 0, mpi_comm);
+            bcast(snapshot->pair_data.type_mapping, 0, mpi_comm);
+            bcast(snapshot->integrator_data, 0, mpi_comm);
+            bcast(m_state, 0, mpi_comm);
+            }
+
+        for (auto it = particles.begin(); it != particles.end(); ++it)
+            snapshot->particle_tags.push_back(it->tag);
+        }
+    else
+    #endif
+        {
+        if (m_exec_conf->isRoot())
+            {
+            for (unsigned int file = 0; file < n_files; ++file)
+                readFile(file, particles, *snapshot, false);
+
+            compactTags(particles, *snapshot);
+            }
+        }
+
+    SnapshotParticleData<double>& pdata = snapshot->particle_data;
+    pdata.resize(particles.size());
+    for (unsigned int i = 0; i < particles.size(); ++i)
+        {
+        const checkpoint_particle_t& p = particles[i];
+        pdata.pos[i] = vec3<double>(p.pos[0], p.pos[1], p.pos[2]);
+        pdata.vel[i] = vec3<double>(p.vel[0], p.vel[1], p.vel[2]);
+        pdata.accel[i] = vec3<double>(p.accel[0], p.accel[1], p.accel[2]);
+        pdata.orientation[i] = quat<double>(p.orientation[0],
+                                            vec3<double>(p.orientation[1], p.orientation[2], p.orientation[3]));
+        pdata.angmom[i] = quat<double>(p.angmom[0], vec3<double>(p.angmom[1], p.angmom[2], p.angmom[3]));
+        pdata.inertia[i] = vec3<double>(p.inertia[0], p.inertia[1], p.inertia[2]);
+        pdata.mass[i] = p.mass;
+        pdata.charge[i] = p.charge;
+        pdata.diameter[i] = p.diameter;
+        pdata.image[i] = make_int3(p.image[0], p.image[1], p.image[2]);
+        pdata.type[i] = p.type;
+        pdata.body[i] = p.body;
+        }
+    pdata.is_accel_set = m_header.accel_set;
+
+    return snapshot;
+    }
+
+/*! \param sysdef System initialized from getSnapshot()
+
+    Restores the origin of the particle data, so that the particle positions in the box frame are unchanged.
+*/
+void CheckpointReader::restoreState(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    Scalar3 origin = make_scalar3(m_header.origin[0], m_header.origin[1], m_header.origin[2]);
+    int3 origin_image = make_int3(m_header.origin_image[0], m_header.origin_image[1], m_header.origin_image[2]);
+    sysdef->getParticleData()->setOrigin(origin, origin_image);
+    }
+
+/*! \param name Name of the state array
+    \returns The values of the array
+*/
+py::list CheckpointReader::getState(const std::string& name) const
+    {
+    auto it = m_state.find(name);
+    if (it == m_state.end())
+        {
+        m_exec_conf->msg->error() << "Checkpoint does not contain the state " << name << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    py::list result;
+    for (auto v : it->second)
+        result.append(v);
+    return result;
+    }
+
+void export_CheckpointReader(py::module& m)
+    {
+    py::class_< CheckpointReader, std::shared_ptr<CheckpointReader> >(m,"CheckpointReader")
+    .def(py::init< std::shared_ptr<const ExecutionConfiguration>, const string& >())
+    .def("getTimeStep", &CheckpointReader::getTimeStep)
+    .def("getNFiles", &CheckpointReader::getNFiles)
+    .def("getBox", &CheckpointReader::getBox)
+    .def("getFractions", &CheckpointReader::getFractions)
+    #ifdef ENABLE_MPI
+    .def("setDomainDecomposition", &CheckpointReader::setDomainDecomposition)
+    #endif
+    .def("getSnapshot", &CheckpointReader::getSnapshot)
+    .def("restoreState", &CheckpointReader::restoreState)
+    .def("hasState", &CheckpointReader::hasState)
+    .def("getState", &CheckpointReader::getState)
+    ;
+    }
@@ -0,0 +1,138 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CheckpointReader.h
+    \brief Declares the CheckpointReader class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_READER_H__
+#define __CHECKPOINT_READER_H__
+
+#include "CheckpointWriter.h"
+#include "ParticleData.h"
+
+#include <string>
+#include <map>
+#include <vector>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Forward declarations
+template <class Real> struct SnapshotSystemData;
+class SystemDefinition;
+#ifdef ENABLE_MPI
+class DomainDecomposition;
+#endif
+
+//! Reads checkpoint files written by CheckpointWriter
+/*! The constructor reads the metadata of the checkpoint: the root rank reads the header of the first file and
+    broadcasts it. getSnapshot() then reads the files in one of three ways:
+
+    - When the run has as many ranks as the checkpoint has files and the domain decomposition (set with
+      setDomainDecomposition()) has the same grid and cuts, every rank reads the file written by the domain at its
+      own grid position into a *local* distributed snapshot (see SnapshotSystemData). The particles and groups
+      stay where they are and keep their tags, so no data is communicated.
+    - Otherwise in MPI runs, rank r reads files r, r+P, r+2P, ... into a distributed snapshot with explicit tags,
+      which SystemDefinition redistributes to the domains.
+    - Without a domain decomposition, the root rank reads all files into a regular snapshot. Tags are renumbered
+      consecutively if there are unused tags.
+
+    restoreState() restores the parts of the state that are not part of a snapshot, and getState() returns the
+    user-defined state arrays written with the checkpoint.
+
+    \ingroup data_structs
+*/
+class PYBIND11_EXPORT CheckpointReader
+    {
+    public:
+        //! Read the metadata of the checkpoint
+        CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string &name);
+
+        //! Returns the timestep of the checkpoint
+        uint64_t getTimeStep() const
+            {
+            return m_header.timestep;
+            }
+
+        //! Returns the number of files (ranks) of the checkpoint
+        unsigned int getNFiles() const
+            {
+            return m_header.n_ranks;
+            }
+
+        //! Returns the global box of the checkpoint
+        BoxDim getBox() const;
+
+        //! Returns the fractional widths of the domains along a direction (all but the last)
+        pybind11::list getFractions(unsigned int dir) const;
+
+        #ifdef ENABLE_MPI
+        //! Set the domain decomposition of the run
+        void setDomainDecomposition(std::shared_ptr<DomainDecomposition> decomposition)
+            {
+            m_decomposition = decomposition;
+            }
+        #endif
+
+        //! Read the checkpoint files into a snapshot
+        std::shared_ptr< SnapshotSystemData<double> > getSnapshot();
+
+        //! Restore the state that is not part of the snapshot
+        void restoreState(std::shared_ptr<SystemDefinition> sysdef);
+
+        //! Test if a user-defined state array is present
+        bool hasState(const std::string& name) const
+            {
+            return m_state.count(name) > 0;
+            }
+
+        //! Get a user-defined state array
+        pybind11::list getState(const std::string& name) const;
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+        std::string m_name;                         //!< Base name of the checkpoint files
+        checkpoint_header_t m_header;               //!< Header of the first file
+        std::vector<double> m_fractions[3];         //!< Cumulative domain fractions of the checkpoint
+        std::map<std::string, std::vector<double> > m_state;  //!< User-defined state arrays
+        #ifdef ENABLE_MPI
+        std::shared_ptr<DomainDecomposition> m_decomposition; //!< The domain decomposition of the run
+        #endif
+
+        //! Read the header and domain fractions of a file
+        void readHeader(std::istream& in, const std::string& fname, checkpoint_header_t& header,
+                        std::vector<double> *fractions);
+
+        //! Append the contents of a file to the particle records and the snapshot
+        void readFile(unsigned int file,
+                      std::vector<checkpoint_particle_t>& particles,
+                      SnapshotSystemData<double>& snapshot,
+                      bool all_groups);
+
+        //! Read a section of bonded groups
+        template<class group_data>
+        void readGroups(std::istream& in,
+                        const std::string& fname,
+                        typename group_data::Snapshot& snapshot,
+                        std::vector<unsigned int>& tags,
+                        bool all_groups);
+
+        //! Sort the particles and groups by tag and renumber the tags consecutively
+        void compactTags(std::vector<checkpoint_particle_t>& particles, SnapshotSystemData<double>& snapshot);
+
+        //! Sort and renumber the groups of one kind
+        template<class group_data>
+        void compactGroups(typename group_data::Snapshot& snapshot,
+                           std::vector<unsigned int>& tags,
+                           const std::vector<unsigned int>& particle_tag_map);
+    };
+
+//! Exports CheckpointReader to python
+void export_CheckpointReader(pybind11::module& m);
+
+#endif
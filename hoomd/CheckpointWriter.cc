@@ -0,0 +1,283 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CheckpointWriter.cc
+    \brief Defines the CheckpointWriter class
+*/
+
+#include "CheckpointWriter.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include "hoomd/extern/pybind/include/pybind11/stl_bind.h"
+#include "hoomd/extern/pybind/include/pybind11/numpy.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <string.h>
+
+using namespace std;
+namespace py = pybind11;
+
+namespace
+{
+//! Write a plain value
+template<class T>
+void write_value(std::ostream& out, const T& value)
+    {
+    out.write((const char *) &value, sizeof(T));
+    }
+
+//! Write a vector of plain values prefixed by its length
+template<class T>
+void write_vector(std::ostream& out, const std::vector<T>& values)
+    {
+    uint64_t n = values.size();
+    write_value(out, n);
+    if (n)
+        out.write((const char *) values.data(), n*sizeof(T));
+    }
+
+//! Write a string prefixed by its length
+void write_string(std::ostream& out, const std::string& s)
+    {
+    uint64_t n = s.size();
+    write_value(out, n);
+    out.write(s.data(), n);
+    }
+}
+
+/*! \param sysdef SystemDefinition containing the system state to write
+    \param fname Base name of the checkpoint files
+*/
+CheckpointWriter::CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string &fname)
+    : Analyzer(sysdef), m_fname(fname)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointWriter: " << fname << endl;
+    }
+
+CheckpointWriter::~CheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CheckpointWriter" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Every rank writes its own file. The user-defined state callbacks are called collectively on all ranks.
+*/
+void CheckpointWriter::analyze(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("Checkpoint");
+
+    unsigned int rank = m_exec_conf->getRank();
+    std::string fname = getFileName(m_fname, rank);
+    std::string tmp_name = fname + ".tmp";
+
+    m_exec_conf->msg->notice(10) << "dump.checkpoint: writing " << tmp_name << endl;
+    std::ofstream out(tmp_name.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+
+    checkpoint_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "HOOMDCP1", 8);
+    header.scalar_size = sizeof(Scalar);
+    header.n_ranks = m_exec_conf->getNRanks();
+    header.rank = rank;
+    header.dimensions = m_sysdef->getNDimensions();
+    header.timestep = timestep;
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar3 L = global_box.getL();
+    uchar3 periodic = global_box.getPeriodic();
+    header.L[0] = L.x; header.L[1] = L.y; header.L[2] = L.z;
+    header.tilt[0] = global_box.getTiltFactorXY();
+    header.tilt[1] = global_box.getTiltFactorXZ();
+    header.tilt[2] = global_box.getTiltFactorYZ();
+    header.periodic[0] = periodic.x; header.periodic[1] = periodic.y; header.periodic[2] = periodic.z;
+
+    Scalar3 origin = m_pdata->getOrigin();
+    int3 origin_image = m_pdata->getOriginImage();
+    header.origin[0] = origin.x; header.origin[1] = origin.y; header.origin[2] = origin.z;
+    header.origin_image[0] = origin_image.x;
+    header.origin_image[1] = origin_image.y;
+    header.origin_image[2] = origin_image.z;
+    header.accel_set = m_pdata->isAccelSet();
+
+    header.grid_size[0] = header.grid_size[1] = header.grid_size[2] = 1;
+    std::vector<double> fractions[3];
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        uint3 grid_size = decomposition->getGridSize();
+        uint3 grid_pos = decomposition->getGridPos();
+        header.grid_size[0] = grid_size.x; header.grid_size[1] = grid_size.y; header.grid_size[2] = grid_size.z;
+        header.grid_pos[0] = grid_pos.x; header.grid_pos[1] = grid_pos.y; header.grid_pos[2] = grid_pos.z;
+
+        for (unsigned int dir = 0; dir < 3; ++dir)
+            {
+            std::vector<Scalar> cum = decomposition->getCumulativeFractions(dir);
+            fractions[dir].assign(cum.begin(), cum.end());
+            }
+        }
+    #endif
+
+    write_value(out, header);
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        write_vector(out, fractions[dir]);
+
+    // particle types
+    uint64_t n_types = m_pdata->getNTypes();
+    write_value(out, n_types);
+    for (unsigned int i = 0; i < n_types; ++i)
+        write_string(out, m_pdata->getNameByType(i));
+
+    // local particles in the internal frame
+    std::vector<checkpoint_particle_t> particles(m_pdata->getN());
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            {
+            checkpoint_particle_t& p = particles[i];
+
+            // particles that left the global box since the last migration step are wrapped back, as the
+            // communicator would do on the next step
+            Scalar3 pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            int3 img = h_image.data[i];
+            global_box.wrap(pos, img);
+
+            p.pos[0] = pos.x; p.pos[1] = pos.y; p.pos[2] = pos.z;
+            p.vel[0] = h_vel.data[i].x; p.vel[1] = h_vel.data[i].y; p.vel[2] = h_vel.data[i].z;
+            p.mass = h_vel.data[i].w;
+            p.accel[0] = h_accel.data[i].x; p.accel[1] = h_accel.data[i].y; p.accel[2] = h_accel.data[i].z;
+            p.orientation[0] = h_orientation.data[i].x; p.orientation[1] = h_orientation.data[i].y;
+            p.orientation[2] = h_orientation.data[i].z; p.orientation[3] = h_orientation.data[i].w;
+            p.angmom[0] = h_angmom.data[i].x; p.angmom[1] = h_angmom.data[i].y;
+            p.angmom[2] = h_angmom.data[i].z; p.angmom[3] = h_angmom.data[i].w;
+            p.inertia[0] = h_inertia.data[i].x; p.inertia[1] = h_inertia.data[i].y; p.inertia[2] = h_inertia.data[i].z;
+            p.charge = h_charge.data[i];
+            p.diameter = h_diameter.data[i];
+            p.image[0] = img.x; p.image[1] = img.y; p.image[2] = img.z;
+            p.type = __scalar_as_int(h_pos.data[i].w);
+            p.body = h_body.data[i];
+            p.tag = h_tag.data[i];
+            }
+        }
+    write_vector(out, particles);
+
+    writeGroups(out, m_sysdef->getBondData());
+    writeGroups(out, m_sysdef->getAngleData());
+    writeGroups(out, m_sysdef->getDihedralData());
+    writeGroups(out, m_sysdef->getImproperData());
+    writeGroups(out, m_sysdef->getConstraintData());
+    writeGroups(out, m_sysdef->getPairData());
+
+    // integrator variables are identical on all ranks
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    uint64_t n_integrators = integrator_data->getNumIntegrators();
+    write_value(out, n_integrators);
+    for (unsigned int i = 0; i < n_integrators; ++i)
+        {
+        const IntegratorVariables& v = integrator_data->getIntegratorVariables(i);
+        write_string(out, v.type);
+        write_vector(out, std::vector<double>(v.variable.begin(), v.variable.end()));
+        }
+
+    // user-defined state
+    uint64_t n_state = m_state.size();
+    write_value(out, n_state);
+    for (auto item : m_state)
+        {
+        m_exec_conf->msg->notice(10) << "dump.checkpoint: writing " << item.first << endl;
+        py::array_t<double, py::array::c_style | py::array::forcecast> arr(item.second(timestep));
+        write_string(out, item.first);
+        write_vector(out, std::vector<double>(arr.data(), arr.data() + arr.size()));
+        }
+
+    out.close();
+    int ok = ! out.fail();
+
+    // replace the previous checkpoint only once all ranks have written theirs
+    #ifdef ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (! ok)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Error writing " << m_fname << endl;
+        throw runtime_error("Error writing checkpoint file");
+        }
+
+    if (rename(tmp_name.c_str(), fname.c_str()) != 0)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Error renaming " << tmp_name << " to " << fname << endl;
+        throw runtime_error("Error writing checkpoint file");
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param out Stream to write to
+    \param gdata Bonded group data to write
+
+    Writes the type mapping and every group with a local member. A group spanning several domains is written by
+    each of the ranks; only the owner of its first member marks it as primary.
+*/
+template<class group_data>
+void CheckpointWriter::writeGroups(std::ostream& out, std::shared_ptr<group_data> gdata)
+    {
+    uint64_t n_types = gdata->getNTypes();
+    write_value(out, n_types);
+    for (unsigned int i = 0; i < n_types; ++i)
+        write_string(out, gdata->getNameByType(i));
+
+    std::vector< checkpoint_group_t<group_data::size> > groups(gdata->getN());
+
+    ArrayHandle<typename group_data::members_t> h_members(gdata->getMembersArray(), access_location::host,
+        access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(gdata->getTypeValArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_tag(gdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    for (unsigned int i = 0; i < gdata->getN(); ++i)
+        {
+        checkpoint_group_t<group_data::size>& g = groups[i];
+        memset(&g, 0, sizeof(g));
+
+        if (group_data::typemap_val)
+            g.type = h_typeval.data[i].type;
+        else
+            g.val = h_typeval.data[i].val;
+
+        g.tag = h_group_tag.data[i];
+        g.primary = h_rtag.data[h_members.data[i].tag[0]] < m_pdata->getN();
+        for (unsigned int j = 0; j < group_data::size; ++j)
+            g.members[j] = h_members.data[i].tag[j];
+        }
+
+    write_vector(out, groups);
+    }
+
+void export_CheckpointWriter(py::module& m)
+    {
+    py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter> >(m,"CheckpointWriter",py::base<Analyzer>())
+        .def(py::init< std::shared_ptr<SystemDefinition>, std::string >())
+        .def_readwrite("state", &CheckpointWriter::m_state)
+    ;
+    }
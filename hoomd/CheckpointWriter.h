@@ -0,0 +1,118 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifndef __CHECKPOINT_WRITER_H__
+#define __CHECKPOINT_WRITER_H__
+
+#include "Analyzer.h"
+
+#include <string>
+#include <memory>
+#include <map>
+#include <stdint.h>
+
+/*! \file CheckpointWriter.h
+    \brief Declares the CheckpointWriter class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Header at the start of every checkpoint file
+struct checkpoint_header_t
+    {
+    char magic[8];              //!< Magic bytes "HOOMDCP1"
+    uint32_t scalar_size;       //!< sizeof(Scalar) of the writer
+    uint32_t n_ranks;           //!< Number of ranks (and files) of the checkpoint
+    uint32_t rank;              //!< Rank that wrote the file
+    uint32_t dimensions;        //!< Dimensionality of the system
+    uint64_t timestep;          //!< Time step of the checkpoint
+    double L[3];                //!< Box lengths
+    double tilt[3];             //!< Box tilt factors xy, xz, yz
+    uint32_t periodic[3];       //!< Periodic flags of the box
+    int32_t origin_image[3];    //!< Image of the particle data origin
+    double origin[3];           //!< Origin of the particle data
+    uint32_t grid_size[3];      //!< Domain decomposition grid
+    uint32_t grid_pos[3];       //!< Position of the domain of the writing rank in the grid
+    uint32_t accel_set;         //!< Nonzero if the accelerations are valid
+    };
+
+//! Particle record in a checkpoint file
+struct checkpoint_particle_t
+    {
+    double pos[3];              //!< Position (in the internal frame, relative to the origin)
+    double vel[3];              //!< Velocity
+    double accel[3];            //!< Acceleration
+    double orientation[4];      //!< Orientation
+    double angmom[4];           //!< Angular momentum
+    double inertia[3];          //!< Principal moments of inertia
+    double mass;                //!< Mass
+    double charge;              //!< Charge
+    double diameter;            //!< Diameter
+    int32_t image[3];           //!< Image flags
+    uint32_t type;              //!< Type id
+    uint32_t body;              //!< Body id
+    uint32_t tag;               //!< Global tag
+    };
+
+//! Bonded group record in a checkpoint file
+template<unsigned int group_size>
+struct checkpoint_group_t
+    {
+    double val;                         //!< Constraint value (groups without type mapping)
+    uint32_t type;                      //!< Type id (groups with type mapping)
+    uint32_t tag;                       //!< Global group tag
+    uint32_t primary;                   //!< Nonzero on the one rank that owns the first member
+    uint32_t members[group_size];       //!< Member tags
+    };
+
+//! Analyzer for writing full state checkpoints
+/*! CheckpointWriter writes the complete local state of every rank to its own binary file getFileName(fname, rank)
+    in parallel: the header (box, particle data origin, and the domain decomposition), all local particles with
+    their tags, the bonded groups with local members, the integrator variables (IntegratorData), and user-defined
+    state arrays (such as HPMC move sizes) obtained from python callbacks. No data is communicated between ranks.
+
+    Every file is written to a temporary file first and renamed only once all ranks have written theirs, so an
+    interrupted write leaves the previous checkpoint intact.
+
+    CheckpointReader restarts from the files. On the same decomposition every rank reloads its own file in place.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CheckpointWriter : public Analyzer
+    {
+    public:
+        //! Construct the writer
+        CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string &fname);
+
+        //! Destructor
+        ~CheckpointWriter();
+
+        //! Write out the checkpoint for the current timestep
+        void analyze(unsigned int timestep);
+
+        //! Get the name of the checkpoint file written by the given rank
+        static std::string getFileName(const std::string& fname, unsigned int rank)
+            {
+            return fname + "." + std::to_string(rank);
+            }
+
+    private:
+        std::string m_fname;                                    //!< Base name of the checkpoint files
+        std::map<std::string, pybind11::function> m_state;      //!< Map of user-defined state arrays
+
+        //! Write the bonded groups with local members
+        template<class group_data>
+        void writeGroups(std::ostream& out, std::shared_ptr<group_data> gdata);
+
+        friend void export_CheckpointWriter(pybind11::module& m);
+    };
+
+//! Exports the CheckpointWriter class to python
+void export_CheckpointWriter(pybind11::module& m);
+
+#endif
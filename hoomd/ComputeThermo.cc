@@ -255,18 +255,18 @@ void ComputeThermo::computeProperties()
         }
     else
         {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        // total kinetic energy, summed in an order independent of the number of threads
+        ke_trans_total = m_group->sumOverMembers([&](unsigned int j) -> double
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
             // ignore rigid body constituent particles in the sum
             if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
                 {
-                ke_trans_total += (double)h_vel.data[j].w*( (double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                                    + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                                    + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
+                return (double)h_vel.data[j].w*( (double)h_vel.data[j].x * (double)h_vel.data[j].x
+                                               + (double)h_vel.data[j].y * (double)h_vel.data[j].y
+                                               + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
                 }
-            }
+            return 0.0;
+            });
 
         ke_trans_total *= Scalar(0.5);
         }
@@ -281,9 +281,10 @@ void ComputeThermo::computeProperties()
         ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
         ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        ke_rot_total = m_group->sumOverMembers([&](unsigned int j) -> double
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
+            double ke_rot = 0.0;
+
             // ignore rigid body constituent particles in the sum
             if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
                 {
@@ -295,18 +296,19 @@ void ComputeThermo::computeProperties()
                 // only if the moment of inertia along one principal axis is non-zero, that axis carries angular momentum
                 if (I.x >= EPSILON)
                     {
-                    ke_rot_total += s.v.x*s.v.x/I.x;
+                    ke_rot += s.v.x*s.v.x/I.x;
                     }
                 if (I.y >= EPSILON)
                     {
-                    ke_rot_total += s.v.y*s.v.y/I.y;
+                    ke_rot += s.v.y*s.v.y/I.y;
                     }
                 if (I.z >= EPSILON)
                     {
-                    ke_rot_total += s.v.z*s.v.z/I.z;
+                    ke_rot += s.v.z*s.v.z/I.z;
                     }
                 }
-            }
+            return ke_rot;
+            });
 
         ke_rot_total /= Scalar(2.0);
         }
@@ -53,6 +53,14 @@ class PYBIND11_EXPORT ConstForceCompute : public ForceCompute
             m_callback = py_callback;
             }
 
+        //! Returns true if compute() may run concurrently with other ForceComputes
+        /*! The python callback must be called from the main thread
+        */
+        virtual bool isConcurrent()
+            {
+            return !(m_callback && m_callback != pybind11::none());
+            }
+
     protected:
 
         //! Function that is called on every particle sort
@@ -151,6 +151,26 @@ class PYBIND11_EXPORT ForceCompute : public Compute
             return false;
             }
 
+        //! Get the computes that this ForceCompute brings up to date in compute()
+        /*! A ForceCompute that calls compute() on another Compute (such as a NeighborList shared between several
+            pair potentials) must declare it here. When Integrator evaluates forces concurrently, it computes the
+            dependencies first, one at a time, and starts the ForceCompute only after all of them are up to date.
+        */
+        virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+            {
+            return std::vector< std::shared_ptr<Compute> >();
+            }
+
+        //! Returns true if compute() may run concurrently with other ForceComputes
+        /*! compute() may run on a TBB worker thread concurrently with other ForceComputes when this returns true.
+            It may then only read the particle data and the state it shares with other computes, and must not
+            communicate with MPI or use the profiler. ForceComputes run in sequence unless they opt in.
+        */
+        virtual bool isConcurrent()
+            {
+            return false;
+            }
+
     protected:
         bool m_particles_sorted;    //!< Flag set to true when particles are resorted in memory
 
@@ -195,6 +215,12 @@ class PYBIND11_EXPORT ForceCompute : public Compute
             \param timestep Current time step
         */
         virtual void computeForces(unsigned int timestep){}
+
+        //! Compute the potential energies if the last computeForces() skipped them
+        /*! Sub-classes that only compute the energy when pdata_flag::potential_energy is set override this function
+            to compute it on demand. It is called before the energies are read from the force array.
+        */
+        virtual void ensureEnergies(){}
     };
 
 //! Exports the ForceCompute class to python
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <stdlib.h>
 #include <memory>
+#include <atomic>
 
 //! Specifies where to acquire the data
 struct access_location
@@ -170,6 +171,49 @@ class host_deleter
         bool m_use_device;     //!< Whether to use hostMallocManaged
         unsigned int m_N;      //!< Number of elements in array
     };
+
+//! Mark an array as acquired by a new handle
+/*! \param acquired Number of shared read handles of the array, or -1 if it is acquired exclusively
+    \param shared True if the new handle may be shared with other read handles
+
+    Throws if the new handle conflicts with a handle that is still outstanding, so that a scoping mistake or a data
+    race on the array is an error in all builds.
+*/
+inline void acquire_handle(std::atomic<int>& acquired, bool shared)
+    {
+    if (shared)
+        {
+        int n = acquired.load();
+        do
+            {
+            if (n < 0)
+                throw std::runtime_error("Array already acquired - ArrayHandle scoping mistake?");
+            }
+        while (!acquired.compare_exchange_weak(n, n+1));
+        }
+    else
+        {
+        int expected = 0;
+        if (!acquired.compare_exchange_strong(expected, -1))
+            throw std::runtime_error("Array already acquired - ArrayHandle scoping mistake?");
+        }
+    }
+
+//! Mark a handle of an array as released
+/*! \param acquired Number of shared read handles of the array, or -1 if it is acquired exclusively
+*/
+inline void release_handle(std::atomic<int>& acquired)
+    {
+    // only the owner of an exclusive handle can release it, shared handles are counted down
+    if (acquired.load() < 0)
+        acquired = 0;
+    else
+        {
+        assert(acquired.load() > 0);
+        acquired--;
+        }
+    }
+
 } // end namespace detail
 
 } // end namespace hoomd
@@ -307,8 +351,8 @@ class ArrayHandleDispatch
 //! Handle to access the data pointer handled by GPUArray
 /*! The data in GPUArray is only accessible via ArrayHandle. The pointer is accessible for the lifetime of the
     ArrayHandle. When the ArrayHandle is destroyed, the GPUArray is notified that the data has been released. This
-    tracking mechanism provides for error checking that will cause code assertions to fail if the data is acquired
-    more than once.
+    tracking mechanism provides for error checking that will throw an error if the data is acquired more than once
+    (other than by shared read only handles on the host).
 
     ArrayHandle is intended to be used within a scope limiting its use. For example:
     \code
@@ -436,6 +480,12 @@ ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::readwri
 h_handle.data[i*pitch + j] = 5;
 \endcode
 
+Only one handle to a GPUArray may exist at a time, with one exception: any number of threads may hold read only
+handles on the host at the same time, as long as no data needs to be copied from the device. This allows
+independent computations (e.g. the ForceComputes evaluated concurrently by Integrator) to read the same particle
+data. Acquiring a handle that conflicts with an outstanding one throws std::runtime_error in all builds. GlobalArray
+follows the same rules.
+
 A future modification of GPUArray will allow mirroring or splitting the data across multiple GPUs.
 
 \ingroup data_structs
@@ -539,13 +589,13 @@ class GPUArray : public GPUArrayBase<T, GPUArray<T> >
         //! Release the data pointer
         inline void release() const
             {
-            m_acquired = false;
+            hoomd::detail::release_handle(m_acquired);
             }
 
         //! Returns the acquire state
         inline bool isAcquired() const
             {
-            return m_acquired;
+            return m_acquired != 0;
             }
 
         //! Need to be friend with dispatch
@@ -562,7 +612,7 @@ class GPUArray : public GPUArrayBase<T, GPUArray<T> >
         unsigned int m_pitch;                   //!< Pitch of the rows in elements
         unsigned int m_height;                  //!< Number of allocated rows
 
-        mutable bool m_acquired;                //!< Tracks whether the data has been acquired
+        mutable std::atomic<int> m_acquired;    //!< Number of shared read handles, or -1 if acquired exclusively
         mutable data_location::Enum m_data_location;    //!< Tracks the current location of the data
 #ifdef ENABLE_CUDA
         bool m_mapped;                          //!< True if we are using mapped memory
@@ -655,7 +705,7 @@ class GPUArrayDispatch : public ArrayHandleDispatch<T>
 // *****************************************
 
 template<class T> GPUArray<T>::GPUArray() :
-        m_num_elements(0), m_pitch(0), m_height(0), m_acquired(false), m_data_location(data_location::host)
+        m_num_elements(0), m_pitch(0), m_height(0), m_acquired(0), m_data_location(data_location::host)
 #ifdef ENABLE_CUDA
         , m_mapped(false)
 #endif
@@ -663,7 +713,7 @@ template<class T> GPUArray<T>::GPUArray() :
     }
 
 template<class T> GPUArray<T>::GPUArray(std::shared_ptr<const ExecutionConfiguration> exec_conf) :
-        m_num_elements(0), m_pitch(0), m_height(0), m_acquired(false), m_data_location(data_location::host),
+        m_num_elements(0), m_pitch(0), m_height(0), m_acquired(0), m_data_location(data_location::host),
 #ifdef ENABLE_CUDA
         m_mapped(false),
 #endif
@@ -676,7 +726,7 @@ template<class T> GPUArray<T>::GPUArray(std::shared_ptr<const ExecutionConfigura
     \param exec_conf Shared pointer to the execution configuration for managing CUDA initialization and shutdown
 */
 template<class T> GPUArray<T>::GPUArray(unsigned int num_elements, std::shared_ptr<const ExecutionConfiguration> exec_conf) :
-        m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(false), m_data_location(data_location::host),
+        m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(0), m_data_location(data_location::host),
 #ifdef ENABLE_CUDA
         m_mapped(false),
 #endif
@@ -692,7 +742,7 @@ template<class T> GPUArray<T>::GPUArray(unsigned int num_elements, std::shared_p
     \param exec_conf Shared pointer to the execution configuration for managing CUDA initialization and shutdown
 */
 template<class T> GPUArray<T>::GPUArray(unsigned int width, unsigned int height, std::shared_ptr<const ExecutionConfiguration> exec_conf) :
-        m_height(height), m_acquired(false), m_data_location(data_location::host),
+        m_height(height), m_acquired(0), m_data_location(data_location::host),
 #ifdef ENABLE_CUDA
         m_mapped(false),
 #endif
@@ -715,7 +765,7 @@ template<class T> GPUArray<T>::GPUArray(unsigned int width, unsigned int height,
     \param mapped True if we are using mapped-pinned memory
 */
 template<class T> GPUArray<T>::GPUArray(unsigned int num_elements, std::shared_ptr<const ExecutionConfiguration> exec_conf, bool mapped) :
-        m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(false), m_data_location(data_location::host),
+        m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(0), m_data_location(data_location::host),
         m_mapped(mapped),
         m_exec_conf(exec_conf)
     {
@@ -730,7 +780,7 @@ template<class T> GPUArray<T>::GPUArray(unsigned int num_elements, std::shared_p
     \param mapped True if we are using mapped-pinned memory
 */
 template<class T> GPUArray<T>::GPUArray(unsigned int width, unsigned int height, std::shared_ptr<const ExecutionConfiguration> exec_conf, bool mapped) :
-        m_height(height), m_acquired(false), m_data_location(data_location::host),
+        m_height(height), m_acquired(0), m_data_location(data_location::host),
         m_mapped(mapped),
         m_exec_conf(exec_conf)
     {
@@ -748,7 +798,7 @@ template<class T> GPUArray<T>::GPUArray(unsigned int width, unsigned int height,
 
 template<class T> GPUArray<T>::GPUArray(const GPUArray& from) noexcept
     : m_num_elements(from.m_num_elements), m_pitch(from.m_pitch),
-      m_height(from.m_height), m_acquired(false), m_data_location(data_location::host),
+      m_height(from.m_height), m_acquired(0), m_data_location(data_location::host),
 #ifdef ENABLE_CUDA
         m_mapped(from.m_mapped),
 #endif
@@ -812,7 +862,7 @@ template<class T> GPUArray<T>::GPUArray(GPUArray&& from) noexcept
     : m_num_elements(std::move(from.m_num_elements)),
     m_pitch(std::move(from.m_pitch)),
     m_height(std::move(from.m_height)),
-    m_acquired(std::move(from.m_acquired)),
+    m_acquired(from.m_acquired.load()),
     m_data_location(std::move(from.m_data_location)),
 #ifdef ENABLE_CUDA
     m_mapped(std::move(from.m_mapped)),
@@ -837,7 +887,7 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
     #endif
         h_data = std::move(rhs.h_data);
         m_data_location = std::move(rhs.m_data_location);
-        m_acquired = std::move(rhs.m_acquired);
+        m_acquired = rhs.m_acquired.load();
         }
 
     return *this;
@@ -864,7 +914,9 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_num_elements, from.m_num_elements);
     std::swap(m_pitch, from.m_pitch);
     std::swap(m_height, from.m_height);
-    std::swap(m_acquired, from.m_acquired);
+    int acquired = m_acquired.load();
+    m_acquired = from.m_acquired.load();
+    from.m_acquired = acquired;
     std::swap(m_data_location, from.m_data_location);
     std::swap(m_exec_conf, from.m_exec_conf);
 #ifdef ENABLE_CUDA
@@ -1052,9 +1104,12 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
 #endif
                                         ) const
     {
-    // sanity check
-    assert(!m_acquired);
-    m_acquired = true;
+    // sanity check: read only handles on the host may be shared between threads when the data is not on the device
+    bool shared = (location == access_location::host && mode == access_mode::read);
+    #ifdef ENABLE_CUDA
+    shared = shared && m_data_location != data_location::device;
+    #endif
+    hoomd::detail::acquire_handle(m_acquired, shared);
 
     // base case - handle acquiring a NULL GPUArray by simply returning NULL to prevent any memcpys from being attempted
     if (isNull())
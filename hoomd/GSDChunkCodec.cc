@@ -0,0 +1,417 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file GSDChunkCodec.cc
+    \brief Defines the GSDChunkCodec class
+*/
+
+#include "GSDChunkCodec.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+    {
+    //! Magic bytes at the start of an encoded stream
+    const char codec_magic[4] = {'H', 'C', 'Z', '1'};
+
+    //! Call f(b) for every block b, in parallel when TBB is available
+    template<class F>
+    void for_each_block(uint32_t n_blocks, const F& f)
+        {
+        #ifdef ENABLE_TBB
+        tbb::parallel_for((uint32_t)0, n_blocks, f);
+        #else
+        for (uint32_t b = 0; b < n_blocks; b++)
+            f(b);
+        #endif
+        }
+
+    //! Throw on a malformed stream
+    [[noreturn]] void corrupt()
+        {
+        throw runtime_error("Error decoding compressed GSD chunk: data is corrupt");
+        }
+
+    //! Run length encode n bytes from src onto dst
+    /*! A control byte c < 128 is followed by c+1 literal bytes, a control byte c >= 128 is followed by one byte
+        that is repeated c-125 times.
+    */
+    void rle_encode(const unsigned char *src, size_t n, std::vector<char>& dst)
+        {
+        size_t i = 0;
+        while (i < n)
+            {
+            size_t run = 1;
+            while (i + run < n && run < 130 && src[i+run] == src[i])
+                run++;
+
+            if (run >= 3)
+                {
+                dst.push_back(char(128 + run - 3));
+                dst.push_back(char(src[i]));
+                i += run;
+                }
+            else
+                {
+                // collect literals until the next run of at least 3 bytes
+                size_t start = i;
+                size_t len = 0;
+                while (i < n && len < 128)
+                    {
+                    if (i + 2 < n && src[i] == src[i+1] && src[i] == src[i+2])
+                        break;
+                    i++;
+                    len++;
+                    }
+                dst.push_back(char(len - 1));
+                dst.insert(dst.end(), (const char *)src + start, (const char *)src + start + len);
+                }
+            }
+        }
+
+    //! Decode exactly n run length encoded bytes into dst, advancing pos
+    void rle_decode(const unsigned char *src, size_t size, size_t& pos, unsigned char *dst, size_t n)
+        {
+        size_t out = 0;
+        while (out < n)
+            {
+            if (pos >= size)
+                corrupt();
+            unsigned int c = src[pos++];
+            if (c < 128)
+                {
+                size_t len = c + 1;
+                if (pos + len > size || out + len > n)
+                    corrupt();
+                memcpy(dst + out, src + pos, len);
+                pos += len;
+                out += len;
+                }
+            else
+                {
+                size_t len = c - 125;
+                if (pos >= size || out + len > n)
+                    corrupt();
+                memset(dst + out, src[pos++], len);
+                out += len;
+                }
+            }
+        }
+
+    //! Zigzag encode a signed integer so that small magnitudes have small codes
+    inline uint32_t zigzag(int32_t v)
+        {
+        return (uint32_t(v) << 1) ^ uint32_t(v >> 31);
+        }
+
+    //! Invert zigzag()
+    inline int32_t unzigzag(uint32_t v)
+        {
+        return int32_t(v >> 1) ^ -int32_t(v & 1);
+        }
+
+    //! Write the header, quanta, and block table, then append the blocks
+    void assemble(const GSDChunkCodec::Header& header,
+                  const std::vector<double>& quantum,
+                  const std::vector< std::vector<char> >& blocks,
+                  std::vector<char>& out)
+        {
+        size_t total = sizeof(GSDChunkCodec::Header) + quantum.size()*sizeof(double) + blocks.size()*sizeof(uint64_t);
+        for (const auto& block : blocks)
+            total += block.size();
+
+        out.resize(total);
+        char *p = out.data();
+        memcpy(p, &header, sizeof(header));
+        p += sizeof(header);
+        if (quantum.size())
+            {
+            memcpy(p, quantum.data(), quantum.size()*sizeof(double));
+            p += quantum.size()*sizeof(double);
+            }
+        for (const auto& block : blocks)
+            {
+            uint64_t block_size = block.size();
+            memcpy(p, &block_size, sizeof(block_size));
+            p += sizeof(block_size);
+            }
+        for (const auto& block : blocks)
+            {
+            if (block.size())
+                memcpy(p, block.data(), block.size());
+            p += block.size();
+            }
+        }
+
+    //! Build a header for an N x M array
+    GSDChunkCodec::Header make_header(GSDChunkCodec::codec codec, gsd_type type, uint32_t N, uint32_t M)
+        {
+        GSDChunkCodec::Header header;
+        memcpy(header.magic, codec_magic, sizeof(codec_magic));
+        header.codec = uint8_t(codec);
+        header.type = uint8_t(type);
+        header.reserved = 0;
+        header.N = N;
+        header.M = M;
+        header.block_rows = GSDChunkCodec::getBlockRows();
+        header.n_blocks = uint32_t((uint64_t(N) + header.block_rows - 1) / header.block_rows);
+        return header;
+        }
+    }
+
+/*! \param data N x M array to encode
+    \param type Type of the array elements
+    \param N Number of rows
+    \param M Number of columns
+    \param out Encoded stream (output)
+*/
+void GSDChunkCodec::encodeLossless(const void *data, gsd_type type, uint32_t N, uint32_t M, std::vector<char>& out)
+    {
+    const size_t elem_size = gsd_sizeof_type(type);
+    if (elem_size == 0)
+        throw runtime_error("Error encoding GSD chunk: invalid type");
+
+    Header header = make_header(lossless, type, N, M);
+    std::vector< std::vector<char> > blocks(header.n_blocks);
+
+    for_each_block(header.n_blocks, [&](uint32_t b)
+        {
+        size_t first_row = size_t(b)*header.block_rows;
+        size_t n_elem = size_t(std::min(header.block_rows, uint32_t(N - first_row)))*M;
+        const unsigned char *src = (const unsigned char *)data + first_row*M*elem_size;
+
+        // shuffle the bytes of each element into planes and encode each plane
+        std::vector<unsigned char> plane(n_elem);
+        std::vector<char>& dst = blocks[b];
+        dst.reserve(n_elem);
+        for (size_t byte = 0; byte < elem_size; byte++)
+            {
+            for (size_t e = 0; e < n_elem; e++)
+                plane[e] = src[e*elem_size + byte];
+            rle_encode(plane.data(), n_elem, dst);
+            }
+        });
+
+    assemble(header, std::vector<double>(), blocks, out);
+    }
+
+/*! \param data N x M array to encode
+    \param N Number of rows
+    \param M Number of columns
+    \param quantum Quantum of each of the M columns
+    \param out Encoded stream (output)
+
+    Every value is stored as the nearest integer multiple of its column's quantum. Throws when a value is not finite or
+    is too large to be represented with the requested quantum.
+*/
+void GSDChunkCodec::encodeQuantized(const float *data,
+                                    uint32_t N,
+                                    uint32_t M,
+                                    const std::vector<double>& quantum,
+                                    std::vector<char>& out)
+    {
+    if (quantum.size() != M)
+        throw runtime_error("Error encoding GSD chunk: expected one quantum per column");
+    for (double q : quantum)
+        if (!(q > 0.0))
+            throw runtime_error("Error encoding GSD chunk: quantum must be positive");
+
+    Header header = make_header(quantized, GSD_TYPE_FLOAT, N, M);
+    std::vector< std::vector<char> > blocks(header.n_blocks);
+    std::vector<char> out_of_range(header.n_blocks, 0);
+
+    for_each_block(header.n_blocks, [&](uint32_t b)
+        {
+        size_t first_row = size_t(b)*header.block_rows;
+        size_t n_rows = std::min(header.block_rows, uint32_t(N - first_row));
+        const float *src = data + first_row*M;
+
+        std::vector<uint32_t> code(n_rows);
+        std::vector<char>& dst = blocks[b];
+        for (uint32_t j = 0; j < M; j++)
+            {
+            uint32_t max_code = 0;
+            for (size_t i = 0; i < n_rows; i++)
+                {
+                double v = double(src[i*M + j]) / quantum[j];
+                if (!(fabs(v) < 2147483647.0))
+                    {
+                    out_of_range[b] = 1;
+                    v = 0.0;
+                    }
+                code[i] = zigzag(int32_t(lround(v)));
+                max_code = std::max(max_code, code[i]);
+                }
+
+            // bit pack the column with the smallest width that holds max_code
+            unsigned int width = 0;
+            while (width < 32 && (max_code >> width) != 0)
+                width++;
+            dst.push_back(char(width));
+
+            uint64_t acc = 0;
+            unsigned int n_bits = 0;
+            for (size_t i = 0; i < n_rows && width > 0; i++)
+                {
+                acc |= uint64_t(code[i]) << n_bits;
+                n_bits += width;
+                while (n_bits >= 8)
+                    {
+                    dst.push_back(char(acc & 0xff));
+                    acc >>= 8;
+                    n_bits -= 8;
+                    }
+                }
+            if (n_bits > 0)
+                dst.push_back(char(acc & 0xff));
+            }
+        });
+
+    if (std::find(out_of_range.begin(), out_of_range.end(), 1) != out_of_range.end())
+        throw runtime_error("Error encoding GSD chunk: value is not finite or too large for the requested precision");
+
+    assemble(header, quantum, blocks, out);
+    }
+
+/*! \param in Encoded stream
+    \param size Size of the stream in bytes
+    \returns The validated header
+*/
+GSDChunkCodec::Header GSDChunkCodec::readHeader(const char *in, size_t size)
+    {
+    Header header;
+    if (size < sizeof(header))
+        corrupt();
+    memcpy(&header, in, sizeof(header));
+
+    if (memcmp(header.magic, codec_magic, sizeof(codec_magic)) != 0)
+        throw runtime_error("Error decoding compressed GSD chunk: unknown format");
+    if (header.codec != lossless && header.codec != quantized)
+        throw runtime_error("Error decoding compressed GSD chunk: unknown codec");
+    if (gsd_sizeof_type(gsd_type(header.type)) == 0 || (header.codec == quantized && header.type != GSD_TYPE_FLOAT))
+        corrupt();
+    if (header.block_rows == 0 || header.n_blocks != (uint64_t(header.N) + header.block_rows - 1) / header.block_rows)
+        corrupt();
+
+    size_t n_quantum = header.codec == quantized ? header.M : 0;
+    if (size < sizeof(header) + n_quantum*sizeof(double) + size_t(header.n_blocks)*sizeof(uint64_t))
+        corrupt();
+
+    return header;
+    }
+
+/*! \param in Encoded stream
+    \param size Size of the stream in bytes
+    \param first First row to decode
+    \param count Number of rows to decode
+    \param out Buffer of at least count*M*gsd_sizeof_type(type) bytes (output)
+
+    Only the blocks that overlap the requested rows are decoded.
+*/
+void GSDChunkCodec::decode(const char *in, size_t size, uint32_t first, uint32_t count, void *out)
+    {
+    Header header = readHeader(in, size);
+    if (uint64_t(first) + count > header.N)
+        throw runtime_error("Error decoding compressed GSD chunk: rows out of range");
+    if (count == 0)
+        return;
+
+    const size_t elem_size = gsd_sizeof_type(gsd_type(header.type));
+    const size_t row_size = elem_size*header.M;
+
+    // read the quanta and locate the blocks
+    const char *p = in + sizeof(header);
+    std::vector<double> quantum;
+    if (header.codec == quantized)
+        {
+        quantum.resize(header.M);
+        memcpy(quantum.data(), p, header.M*sizeof(double));
+        p += header.M*sizeof(double);
+        }
+
+    std::vector<uint64_t> block_offset(header.n_blocks+1);
+    block_offset[0] = (p - in) + size_t(header.n_blocks)*sizeof(uint64_t);
+    for (uint32_t b = 0; b < header.n_blocks; b++)
+        {
+        uint64_t block_size;
+        memcpy(&block_size, p + b*sizeof(uint64_t), sizeof(block_size));
+        block_offset[b+1] = block_offset[b] + block_size;
+        if (block_offset[b+1] > size || block_offset[b+1] < block_offset[b])
+            corrupt();
+        }
+
+    uint32_t first_block = first / header.block_rows;
+    uint32_t last_block = (first + count - 1) / header.block_rows;
+
+    for_each_block(last_block - first_block + 1, [&](uint32_t k)
+        {
+        uint32_t b = first_block + k;
+        size_t block_first_row = size_t(b)*header.block_rows;
+        size_t n_rows = std::min(header.block_rows, uint32_t(header.N - block_first_row));
+        size_t n_elem = n_rows*header.M;
+        const unsigned char *src = (const unsigned char *)in + block_offset[b];
+        size_t src_size = block_offset[b+1] - block_offset[b];
+        size_t pos = 0;
+
+        std::vector<unsigned char> rows(n_rows*row_size);
+        if (header.codec == lossless)
+            {
+            std::vector<unsigned char> plane(n_elem);
+            for (size_t byte = 0; byte < elem_size; byte++)
+                {
+                rle_decode(src, src_size, pos, plane.data(), n_elem);
+                for (size_t e = 0; e < n_elem; e++)
+                    rows[e*elem_size + byte] = plane[e];
+                }
+            }
+        else
+            {
+            float *dst = (float *)rows.data();
+            for (uint32_t j = 0; j < header.M; j++)
+                {
+                if (pos >= src_size)
+                    corrupt();
+                unsigned int width = src[pos++];
+                if (width > 32)
+                    corrupt();
+                if (pos + (n_rows*width + 7)/8 > src_size)
+                    corrupt();
+
+                uint64_t acc = 0;
+                unsigned int n_bits = 0;
+                uint64_t mask = (uint64_t(1) << width) - 1;
+                for (size_t i = 0; i < n_rows; i++)
+                    {
+                    while (n_bits < width)
+                        {
+                        acc |= uint64_t(src[pos++]) << n_bits;
+                        n_bits += 8;
+                        }
+                    uint32_t code = uint32_t(acc & mask);
+                    acc >>= width;
+                    n_bits -= width;
+                    dst[i*header.M + j] = float(quantum[j] * double(unzigzag(code)));
+                    }
+                }
+            }
+
+        // copy the requested rows of this block
+        size_t copy_first = std::max(size_t(first), block_first_row);
+        size_t copy_last = std::min(size_t(first) + count, block_first_row + n_rows);
+        memcpy((char *)out + (copy_first - first)*row_size,
+               rows.data() + (copy_first - block_first_row)*row_size,
+               (copy_last - copy_first)*row_size);
+        });
+    }
@@ -0,0 +1,98 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file GSDChunkCodec.h
+    \brief Declares the GSDChunkCodec class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __GSD_CHUNK_CODEC_H__
+#define __GSD_CHUNK_CODEC_H__
+
+#include "hoomd/extern/gsd.h"
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include <stddef.h>
+
+//! Encodes and decodes compressed GSD data chunks
+/*! GSD stores every data chunk as a raw N x M array. GSDChunkCodec packs such an array into a self describing
+    byte stream that GSDDumpWriter stores as a GSD_TYPE_UINT8 chunk with the suffix getSuffix() appended to the name
+    of the raw chunk (e.g. ``particles/image.z``). GSDReader looks for the suffixed chunk when the raw one is absent and
+    decodes it transparently.
+
+    Two codecs are available:
+
+    - *lossless*: the bytes of every element are shuffled into byte planes (all first bytes, then all second bytes, ...)
+      and each plane is run length encoded. Integer chunks such as type ids, images, and bond groups have mostly
+      constant high bytes, which collapse to a few bytes per block.
+    - *quantized*: float columns are rounded to integer multiples of a per column quantum, zigzag encoded, and bit
+      packed with the smallest width that holds the block. The absolute error of every decoded value is at most half
+      its column's quantum.
+
+    The rows are split into blocks of getBlockRows() rows that are encoded and decoded independently (in parallel with
+    TBB when available), and a reader can decode only the blocks that cover a range of rows.
+
+    Stream layout: a Header, M doubles with the quantum of each column (quantized codec only), n_blocks uint64 block
+    sizes in bytes, then the blocks.
+*/
+class GSDChunkCodec
+    {
+    public:
+        //! Codec identifiers stored in the stream header
+        enum codec
+            {
+            lossless=1,
+            quantized=2
+            };
+
+        //! Header at the start of every encoded stream
+        struct Header
+            {
+            char magic[4];          //!< Magic bytes "HCZ1"
+            uint8_t codec;          //!< Codec used to encode the data
+            uint8_t type;           //!< gsd_type of the decoded data
+            uint16_t reserved;      //!< Unused, set to 0
+            uint32_t N;             //!< Number of rows in the decoded data
+            uint32_t M;             //!< Number of columns in the decoded data
+            uint32_t block_rows;    //!< Number of rows per block
+            uint32_t n_blocks;      //!< Number of blocks
+            };
+
+        //! Suffix appended to the chunk name of an encoded chunk
+        static const char *getSuffix()
+            {
+            return ".z";
+            }
+
+        //! Number of rows encoded in one block
+        static uint32_t getBlockRows()
+            {
+            return 65536;
+            }
+
+        //! Losslessly encode an N x M array of the given type
+        static void encodeLossless(const void *data, gsd_type type, uint32_t N, uint32_t M, std::vector<char>& out);
+
+        //! Quantize and encode an N x M float array
+        static void encodeQuantized(const float *data,
+                                    uint32_t N,
+                                    uint32_t M,
+                                    const std::vector<double>& quantum,
+                                    std::vector<char>& out);
+
+        //! Read and validate the header of an encoded stream
+        static Header readHeader(const char *in, size_t size);
+
+        //! Decode rows [first, first+count) of an encoded stream
+        static void decode(const char *in, size_t size, uint32_t first, uint32_t count, void *out);
+    };
+
+#endif
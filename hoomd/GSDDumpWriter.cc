@@ -9,6 +9,7 @@
 */
 
 #include "GSDDumpWriter.h"
+#include "GSDChunkCodec.h"
 #include "Filesystem.h"
 #include "HOOMDVersion.h"
 
@@ -44,11 +45,61 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
+                        m_compress(false),
+                        m_precision(0.0),
+                        m_keyframe_period(0),
+                        m_tolerance(0.0),
+                        m_frames_since_keyframe(0),
                         m_group(group)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
     }
 
+/*! \param keyframe_period Write particles/position in full every keyframe_period frames (0 disables delta encoding)
+    \param tolerance Store a particle in a delta frame only when it moved further than this since it was last stored
+
+    The first frame written, and every frame in which the group members change, is also a keyframe. A reader
+    reconstructs the positions of a delta frame from the last keyframe and all delta frames since, and they are
+    within \a tolerance of the true positions.
+*/
+void GSDDumpWriter::setDelta(unsigned int keyframe_period, Scalar tolerance)
+    {
+    if (tolerance < Scalar(0.0))
+        {
+        m_exec_conf->msg->error() << "dump.gsd: tolerance must not be negative" << endl;
+        throw runtime_error("Error setting delta encoding");
+        }
+
+    m_keyframe_period = keyframe_period;
+    m_tolerance = tolerance;
+
+    // start with a keyframe
+    m_ref_pos.clear();
+    m_ref_tag.clear();
+    m_frames_since_keyframe = 0;
+    }
+
+/*! \param name Name of a per-particle chunk (particles/orientation, particles/velocity, particles/angmom or
+                 particles/image)
+    \param group Only write the chunk for the members of this group, or for all particles when null
+
+    Members of \a group that are not in the group of the writer are not written.
+*/
+void GSDDumpWriter::setFieldGroup(const std::string& name, std::shared_ptr<ParticleGroup> group)
+    {
+    if (name != "particles/orientation" && name != "particles/velocity" &&
+        name != "particles/angmom" && name != "particles/image")
+        {
+        m_exec_conf->msg->error() << "dump.gsd: cannot write " << name << " for a group" << endl;
+        throw runtime_error("Error setting field group");
+        }
+
+    if (group)
+        m_field_groups[name] = group;
+    else
+        m_field_groups.erase(name);
+    }
+
 void GSDDumpWriter::checkError(int retval)
     {
     // checkError prints errors and then throws exceptions for common gsd error codes
@@ -226,26 +277,12 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     // topology is only meaningful if this is the all group
     if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && (m_write_topology || nframes == 0))
         {
-        BondData::Snapshot bdata_snapshot;
-        m_sysdef->getBondData()->takeSnapshot(bdata_snapshot);
-
-        AngleData::Snapshot adata_snapshot;
-        m_sysdef->getAngleData()->takeSnapshot(adata_snapshot);
-
-        DihedralData::Snapshot ddata_snapshot;
-        m_sysdef->getDihedralData()->takeSnapshot(ddata_snapshot);
-
-        ImproperData::Snapshot idata_snapshot;
-        m_sysdef->getImproperData()->takeSnapshot(idata_snapshot);
-
-        ConstraintData::Snapshot cdata_snapshot;
-        m_sysdef->getConstraintData()->takeSnapshot(cdata_snapshot);
-
-        PairData::Snapshot pdata_snapshot;
-        m_sysdef->getPairData()->takeSnapshot(pdata_snapshot);
-
-        if (root)
-            writeTopology(bdata_snapshot, adata_snapshot, ddata_snapshot, idata_snapshot, cdata_snapshot, pdata_snapshot);
+        writeGroups("bonds", m_sysdef->getBondData(), nframes, root);
+        writeGroups("angles", m_sysdef->getAngleData(), nframes, root);
+        writeGroups("dihedrals", m_sysdef->getDihedralData(), nframes, root);
+        writeGroups("impropers", m_sysdef->getImproperData(), nframes, root);
+        writeGroups("constraints", m_sysdef->getConstraintData(), nframes, root);
+        writeGroups("pairs", m_sysdef->getPairData(), nframes, root);
         }
 
     // emit on all ranks, the slot needs to handle the mpi logic.
@@ -265,7 +302,171 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     }
 
 
-void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
+/*! \param name Name of the data chunk
+    \param type Type of the data
+    \param N Number of rows
+    \param M Number of columns
+    \param data N x M array to encode
+    \param quantum Quantum of each column when the chunk may be quantized, empty otherwise
+    \param out The encoded chunk (output)
+
+    Chunks are only encoded when compression is enabled. When a precision is set and \a quantum is given, quantize
+    the chunk. Otherwise, when the chunk holds integers, compress it losslessly. Encoded chunks are stored as bytes under the chunk name
+    with GSDChunkCodec::getSuffix() appended, all other chunks are copied as is.
+*/
+void GSDDumpWriter::encodeChunk(const char *name,
+                                gsd_type type,
+                                uint32_t N,
+                                uint32_t M,
+                                const void *data,
+                                const std::vector<double>& quantum,
+                                EncodedChunk& out)
+    {
+    bool quantize = m_compress && m_precision > Scalar(0.0) && quantum.size() == M && type == GSD_TYPE_FLOAT;
+    bool compress = m_compress && type != GSD_TYPE_FLOAT && type != GSD_TYPE_DOUBLE;
+
+    if (quantize || compress)
+        {
+        if (quantize)
+            GSDChunkCodec::encodeQuantized((const float *)data, N, M, quantum, out.data);
+        else
+            GSDChunkCodec::encodeLossless(data, type, N, M, out.data);
+
+        out.name = string(name) + GSDChunkCodec::getSuffix();
+        out.type = GSD_TYPE_UINT8;
+        out.N = out.data.size();
+        out.M = 1;
+        m_exec_conf->msg->notice(10) << "dump.gsd: encoded " << out.name << " (" << out.data.size() << " of "
+                                     << uint64_t(N)*M*gsd_sizeof_type(type) << " bytes)" << endl;
+        }
+    else
+        {
+        const char *begin = (const char *)data;
+        out.name = name;
+        out.type = type;
+        out.N = N;
+        out.M = M;
+        out.data.assign(begin, begin + uint64_t(N)*M*gsd_sizeof_type(type));
+        }
+    }
+
+/*! \param chunk Chunk to write
+*/
+void GSDDumpWriter::writeEncodedChunk(const EncodedChunk& chunk)
+    {
+    m_exec_conf->msg->notice(10) << "dump.gsd: writing " << chunk.name << endl;
+    int retval = gsd_write_chunk(&m_handle, chunk.name.c_str(), chunk.type, chunk.N, chunk.M, 0, (void *)chunk.data.data());
+    checkError(retval);
+    }
+
+/*! \param name Name of the data chunk
+    \param type Type of the data
+    \param N Number of rows
+    \param M Number of columns
+    \param data N x M array to write
+    \param quantum Quantum of each column when the chunk may be quantized, empty otherwise
+
+    Encode the chunk with encodeChunk() and write it. Chunks that are not encoded are written without a copy.
+*/
+void GSDDumpWriter::writeChunk(const char *name,
+                               gsd_type type,
+                               uint32_t N,
+                               uint32_t M,
+                               const void *data,
+                               const std::vector<double>& quantum)
+    {
+    bool quantize = m_compress && m_precision > Scalar(0.0) && quantum.size() == M && type == GSD_TYPE_FLOAT;
+    bool compress = m_compress && type != GSD_TYPE_FLOAT && type != GSD_TYPE_DOUBLE;
+
+    if (quantize || compress)
+        {
+        EncodedChunk chunk;
+        encodeChunk(name, type, N, M, data, quantum, chunk);
+        writeEncodedChunk(chunk);
+        }
+    else
+        {
+        int retval = gsd_write_chunk(&m_handle, name, type, N, M, 0, (void *)data);
+        checkError(retval);
+        }
+    }
+
+/*! \param name Name of the data chunk
+    \param type Type of the data
+    \param M Number of columns
+    \param data N x M array to write, one row per member of the group
+    \param quantum Quantum of each column when the chunk may be quantized, empty otherwise
+
+    When a field group is set for \a name, write only the rows of its members with writeSparseChunk(). Otherwise,
+    write the whole chunk with writeChunk().
+*/
+void GSDDumpWriter::writeParticleChunk(const char *name,
+                                       gsd_type type,
+                                       uint32_t M,
+                                       const void *data,
+                                       const std::vector<double>& quantum)
+    {
+    uint32_t N = m_group->getNumMembersGlobal();
+    auto field_group = m_field_groups.find(name);
+    if (field_group == m_field_groups.end())
+        {
+        writeChunk(name, type, N, M, data, quantum);
+        return;
+        }
+
+    // both groups list their members in ascending tag order, find the rows of the field group members
+    std::vector<uint32_t> rows;
+    unsigned int n_field = field_group->second->getNumMembersGlobal();
+    unsigned int j = 0;
+    for (unsigned int group_idx = 0; group_idx < N && j < n_field; group_idx++)
+        {
+        unsigned int t = m_group->getMemberTag(group_idx);
+        while (j < n_field && field_group->second->getMemberTag(j) < t)
+            j++;
+        if (j < n_field && field_group->second->getMemberTag(j) == t)
+            rows.push_back(group_idx);
+        }
+
+    writeSparseChunk(name, type, M, data, rows);
+    }
+
+/*! \param name Name of the data chunk
+    \param type Type of the data
+    \param M Number of columns
+    \param data N x M array with one row per member of the group
+    \param rows Rows of \a data to write
+
+    Writes the uint32 chunk <name>/subset_index with \a rows and <name>/subset_value with the selected rows of \a data.
+    Rows not listed keep the value of frame 0 (or the default) when the file is read.
+*/
+void GSDDumpWriter::writeSparseChunk(const std::string& name,
+                                     gsd_type type,
+                                     uint32_t M,
+                                     const void *data,
+                                     const std::vector<uint32_t>& rows)
+    {
+    size_t row_size = M*gsd_sizeof_type(type);
+    std::vector<char> values(rows.size()*row_size);
+    for (unsigned int i = 0; i < rows.size(); i++)
+        memcpy(&values[i*row_size], (const char *)data + size_t(rows[i])*row_size, row_size);
+
+    m_exec_conf->msg->notice(10) << "dump.gsd: writing " << name << " for " << rows.size() << " particles" << endl;
+    string index_name = name + "/subset_index";
+    int retval = gsd_write_chunk(&m_handle, index_name.c_str(), GSD_TYPE_UINT32, rows.size(), 1, 0, (void *)rows.data());
+    checkError(retval);
+
+    string value_name = name + "/subset_value";
+    retval = gsd_write_chunk(&m_handle, value_name.c_str(), type, rows.size(), M, 0, (void *)values.data());
+    checkError(retval);
+    }
+
+/*! \param chunk Name of the data chunk
+    \param type_mapping Type names
+    \param out The encoded chunk (output)
+
+    Type names are stored as a uint8 array with one null terminated name per row.
+*/
+void GSDDumpWriter::encodeTypeMapping(const std::string& chunk, const std::vector< std::string >& type_mapping, EncodedChunk& out)
     {
     int max_len = 0;
     for (unsigned int i = 0; i < type_mapping.size(); i++)
@@ -274,15 +475,20 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
         }
     max_len += 1;  // for null
 
-        {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << chunk << endl;
-        std::vector<char> types(max_len * type_mapping.size());
-        for (unsigned int i = 0; i < type_mapping.size(); i++)
-            strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle, chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
-        checkError(retval);
-        }
+    out.name = chunk;
+    out.type = GSD_TYPE_UINT8;
+    out.N = type_mapping.size();
+    out.M = max_len;
+    out.data.assign(max_len * type_mapping.size(), 0);
+    for (unsigned int i = 0; i < type_mapping.size(); i++)
+        strncpy(&out.data[max_len*i], type_mapping[i].c_str(), max_len);
+    }
 
+void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
+    {
+    EncodedChunk out;
+    encodeTypeMapping(chunk, type_mapping, out);
+    writeEncodedChunk(out);
     }
 
 /*! \param timestep
@@ -361,8 +567,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
-            checkError(retval);
+            writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, &type[0]);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
             }
@@ -468,8 +673,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
-            checkError(retval);
+            writeChunk("particles/body", GSD_TYPE_INT32, N, 1, &body[0]);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
             }
@@ -518,7 +722,6 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
     uint64_t nframes = gsd_get_nframes(&m_handle);
 
         {
@@ -538,9 +741,64 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             data[group_idx*3+2] = float(snapshot.pos[it->second].z);
             }
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-        checkError(retval);
+        // in delta mode, write a keyframe at the start, every m_keyframe_period frames, and when the members change
+        bool keyframe = m_keyframe_period == 0 || nframes == 0 || m_ref_pos.size() != N
+                        || m_frames_since_keyframe + 1 >= m_keyframe_period;
+        for (unsigned int group_idx = 0; group_idx < N && !keyframe; group_idx++)
+            {
+            if (m_ref_tag[group_idx] != m_group->getMemberTag(group_idx))
+                keyframe = true;
+            }
+
+        if (keyframe)
+            {
+            // quantize positions to the given precision relative to the box length
+            Scalar3 L = m_pdata->getGlobalBox().getL();
+            std::vector<double> quantum {2.0*m_precision*L.x, 2.0*m_precision*L.y, 2.0*m_precision*L.z};
+
+            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
+            writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, &data[0], quantum);
+
+            if (m_keyframe_period > 0)
+                {
+                m_ref_pos.resize(N);
+                m_ref_tag.resize(N);
+                for (unsigned int group_idx = 0; group_idx < N; group_idx++)
+                    {
+                    m_ref_pos[group_idx] = vec3<float>(data[group_idx*3+0], data[group_idx*3+1], data[group_idx*3+2]);
+                    m_ref_tag[group_idx] = m_group->getMemberTag(group_idx);
+                    }
+                m_frames_since_keyframe = 0;
+                }
+            }
+        else
+            {
+            // store the particles that moved beyond the tolerance since they were last stored
+            std::vector<uint32_t> rows;
+            std::vector<float> values;
+            float tol_sq = float(m_tolerance*m_tolerance);
+            for (unsigned int group_idx = 0; group_idx < N; group_idx++)
+                {
+                vec3<float> p(data[group_idx*3+0], data[group_idx*3+1], data[group_idx*3+2]);
+                vec3<float> d = p - m_ref_pos[group_idx];
+                if (dot(d, d) > tol_sq)
+                    {
+                    rows.push_back(group_idx);
+                    values.push_back(p.x);
+                    values.push_back(p.y);
+                    values.push_back(p.z);
+                    m_ref_pos[group_idx] = p;
+                    }
+                }
+
+            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position/delta for " << rows.size()
+                                         << " particles" << endl;
+            int retval = gsd_write_chunk(&m_handle, "particles/position/delta_index", GSD_TYPE_UINT32, rows.size(), 1, 0, (void *)rows.data());
+            checkError(retval);
+            retval = gsd_write_chunk(&m_handle, "particles/position/delta_value", GSD_TYPE_FLOAT, rows.size(), 3, 0, (void *)values.data());
+            checkError(retval);
+            m_frames_since_keyframe++;
+            }
         }
 
         {
@@ -573,8 +831,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
-            checkError(retval);
+            writeParticleChunk("particles/orientation", GSD_TYPE_FLOAT, 4, &data[0], std::vector<double>(4, 2.0*m_precision));
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
             }
@@ -588,7 +845,6 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
     uint64_t nframes = gsd_get_nframes(&m_handle);
 
         {
@@ -618,9 +874,15 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
+            // quantize velocities to the given precision relative to the largest velocity component
+            std::vector<double> quantum(3, 0.0);
+            for (uint64_t i = 0; i < uint64_t(N)*3; i++)
+                quantum[i % 3] = std::max(quantum[i % 3], fabs(double(data[i])));
+            for (unsigned int j = 0; j < 3; j++)
+                quantum[j] = quantum[j] > 0.0 ? 2.0*m_precision*quantum[j] : 1.0;
+
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-            checkError(retval);
+            writeParticleChunk("particles/velocity", GSD_TYPE_FLOAT, 3, &data[0], quantum);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
             }
@@ -656,8 +918,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
-            checkError(retval);
+            writeParticleChunk("particles/angmom", GSD_TYPE_FLOAT, 4, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
             }
@@ -691,139 +952,111 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
-            checkError(retval);
+            writeParticleChunk("particles/image", GSD_TYPE_INT32, 3, &data[0]);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
             }
         }
     }
 
-/*! \param bond Bond data snapshot
-    \param angle Angle data snapshot
-    \param dihedral Dihedral data snapshot
-    \param improper Improper data snapshot
-    \param constraint Constraint data snapshot
-    \param pair Special pair data snapshot
+/*! \param prefix Prefix of the chunk names (bonds, angles, ...)
+    \param gdata The bonded group data
+    \param nframes Number of frames in the file before this one
+    \param root True on the rank that writes the file
 
-    Write out all the snapshot data to the GSD file
+    Frames without topology chunks use the topology of frame 0. When this writer wrote frame 0 and the topology
+    version is the same as then, write nothing. Otherwise, write the cached chunks, and gather and encode them again
+    first when the topology has changed since they were cached. The decisions only depend on values that are the same
+    on all ranks, so the collective gather in takeSnapshot() is entered by all ranks or none.
 */
-void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
-                                  AngleData::Snapshot& angle,
-                                  DihedralData::Snapshot& dihedral,
-                                  ImproperData::Snapshot& improper,
-                                  ConstraintData::Snapshot& constraint,
-                                  PairData::Snapshot& pair)
+template<class group_data>
+void GSDDumpWriter::writeGroups(const std::string& prefix, std::shared_ptr<group_data> gdata, uint64_t nframes, bool root)
     {
-    if (bond.size > 0)
-        {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/N" << endl;
-        uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        checkError(retval);
+    TopologyCache& cache = m_topology_cache[prefix];
+    uint64_t version = gdata->getTopologyVersion();
+    bool same_gdata = cache.gdata.lock().get() == (void *)gdata.get();
 
-        writeTypeMapping("bonds/types", bond.type_mapping);
-
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
-        checkError(retval);
-
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
-        checkError(retval);
-        }
-    if (angle.size > 0)
+    if (nframes > 0 && same_gdata && cache.in_frame0 && cache.version_frame0 == version)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/N" << endl;
-        uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        checkError(retval);
-
-        writeTypeMapping("angles/types", angle.type_mapping);
-
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
-        checkError(retval);
-
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
-        checkError(retval);
+        m_exec_conf->msg->notice(10) << "dump.gsd: " << prefix << " unchanged since frame 0" << endl;
+        return;
         }
-    if (dihedral.size > 0)
-        {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/N" << endl;
-        uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        checkError(retval);
-
-        writeTypeMapping("dihedrals/types", dihedral.type_mapping);
-
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
-        checkError(retval);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
-        checkError(retval);
-        }
-    if (improper.size > 0)
+    if (!same_gdata || !cache.valid || cache.version != version)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/N" << endl;
-        uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        checkError(retval);
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking " << prefix << " snapshot" << endl;
+        typename group_data::Snapshot snapshot;
+        gdata->takeSnapshot(snapshot);
 
-        writeTypeMapping("impropers/types", improper.type_mapping);
+        cache.chunks.clear();
+        if (root)
+            encodeGroups<group_data>(prefix, snapshot, cache.chunks);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
-        checkError(retval);
+        cache.gdata = gdata;
+        cache.version = version;
+        cache.valid = true;
+        cache.in_frame0 = false;
+        }
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
-        checkError(retval);
+    if (nframes == 0)
+        {
+        cache.in_frame0 = true;
+        cache.version_frame0 = version;
         }
 
-    if (constraint.size > 0)
+    if (root)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/N" << endl;
-        uint32_t N = constraint.size;
-        int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        checkError(retval);
+        for (auto const& chunk : cache.chunks)
+            writeEncodedChunk(chunk);
+        }
+    }
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/value" << endl;
-            {
-            std::vector<float> data(N);
-            data.reserve(1); //! make sure we allocate
-            for (unsigned int i = 0; i < N; i++)
-                data[i] = float(constraint.val[i]);
+/*! \param prefix Prefix of the chunk names (bonds, angles, ...)
+    \param snapshot Snapshot of the bonded groups
+    \param chunks The encoded chunks (output)
 
-            retval = gsd_write_chunk(&m_handle, "constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
-            checkError(retval);
-            }
+    Encode the chunks <prefix>/N, and <prefix>/types and <prefix>/typeid, or <prefix>/value, and <prefix>/group.
+    Nothing is encoded when there are no groups.
+*/
+template<class group_data>
+void GSDDumpWriter::encodeGroups(const std::string& prefix,
+                                 const typename group_data::Snapshot& snapshot,
+                                 std::vector<EncodedChunk>& chunks)
+    {
+    if (snapshot.size == 0)
+        return;
+
+    uint32_t N = snapshot.size;
+    EncodedChunk chunk;
+    chunk.name = prefix + "/N";
+    chunk.type = GSD_TYPE_UINT32;
+    chunk.N = 1;
+    chunk.M = 1;
+    chunk.data.assign((const char *)&N, (const char *)&N + sizeof(N));
+    chunks.push_back(chunk);
+
+    if (group_data::typemap_val)
+        {
+        encodeTypeMapping(prefix + "/types", snapshot.type_mapping, chunk);
+        chunks.push_back(chunk);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
-        checkError(retval);
+        encodeChunk((prefix + "/typeid").c_str(), GSD_TYPE_UINT32, N, 1, &snapshot.type_id[0],
+                    std::vector<double>(), chunk);
+        chunks.push_back(chunk);
         }
-
-    if (pair.size > 0)
+    else
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/N" << endl;
-        uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
-        checkError(retval);
-
-        writeTypeMapping("pairs/types", pair.type_mapping);
-
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
-        checkError(retval);
+        std::vector<float> data(N);
+        for (unsigned int i = 0; i < N; i++)
+            data[i] = float(snapshot.val[i]);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
-        checkError(retval);
+        encodeChunk((prefix + "/value").c_str(), GSD_TYPE_FLOAT, N, 1, &data[0], std::vector<double>(), chunk);
+        chunks.push_back(chunk);
         }
+
+    encodeChunk((prefix + "/group").c_str(), GSD_TYPE_UINT32, N, group_data::size, &snapshot.groups[0],
+                std::vector<double>(), chunk);
+    chunks.push_back(chunk);
     }
 
 /*! Perform the user-provided callbacks and write out the resulting data
@@ -972,6 +1205,8 @@ void GSDDumpWriter::populateNonDefault()
     for (auto const& chunk : chunks)
         {
         const gsd_index_entry *entry = gsd_find_chunk(&m_handle, 0, chunk.c_str());
+        if (entry == nullptr)
+            entry = gsd_find_chunk(&m_handle, 0, (chunk + GSDChunkCodec::getSuffix()).c_str());
         m_nondefault[chunk] = (entry != nullptr);
         }
 
@@ -989,6 +1224,10 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setCompress", &GSDDumpWriter::setCompress)
+        .def("setPrecision", &GSDDumpWriter::setPrecision)
+        .def("setDelta", &GSDDumpWriter::setDelta)
+        .def("setFieldGroup", &GSDDumpWriter::setFieldGroup)
         .def_readwrite("user_log", &GSDDumpWriter::m_user_log)
     ;
     }
@@ -11,6 +11,8 @@
 
 #include <string>
 #include <memory>
+#include <map>
+#include <vector>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -31,6 +33,16 @@
     On the first call to analyze() \a fname is created with a dcd header. If it already
     exists, append to the file (unless the user specifies overwrite=True).
 
+    In delta mode (see setDelta()), particles/position is written in full only in keyframes. The frames between
+    keyframes store the rows of the particles that moved more than the tolerance since their position was last
+    stored, in the sparse chunks particles/position/delta_index and particles/position/delta_value. A per-particle
+    chunk with a field group (see setFieldGroup()) is written only for the members of that group, in the sparse
+    chunks <name>/subset_index and <name>/subset_value. GSDReader reconstructs the full frames.
+
+    Topology is gathered and encoded only when the topology version of the BondedGroupData changes (see
+    BondedGroupData::getTopologyVersion()). Frames in which it is the same as in frame 0 do not store it at all,
+    otherwise the cached chunks are written again.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -67,6 +79,24 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Enable the HOOMD specific encoding of chunks (integer chunks are compressed losslessly)
+        void setCompress(bool b)
+            {
+            m_compress = b;
+            }
+
+        //! Set the precision of quantized chunks when encoding is enabled (0 does not quantize)
+        void setPrecision(Scalar precision)
+            {
+            m_precision = precision;
+            }
+
+        //! Enable delta encoding of positions
+        void setDelta(unsigned int keyframe_period, Scalar tolerance);
+
+        //! Write a per-particle chunk only for the members of a group
+        void setFieldGroup(const std::string& name, std::shared_ptr<ParticleGroup> group);
+
         //! Destructor
         ~GSDDumpWriter();
 
@@ -76,6 +106,29 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal() { return m_write_signal; }
 
     private:
+        //! A data chunk ready to be written to the file
+        struct EncodedChunk
+            {
+            std::string name;               //!< Name of the chunk
+            gsd_type type;                  //!< Type of the data
+            uint64_t N;                     //!< Number of rows
+            uint32_t M;                     //!< Number of columns
+            std::vector<char> data;         //!< N x M data
+            };
+
+        //! Cached topology chunks of one BondedGroupData
+        struct TopologyCache
+            {
+            TopologyCache() : version(0), valid(false), version_frame0(0), in_frame0(false) { }
+
+            std::weak_ptr<void> gdata;          //!< The group data the chunks were taken from
+            uint64_t version;                   //!< Topology version of the chunks
+            bool valid;                         //!< True if the chunks have been taken
+            uint64_t version_frame0;            //!< Topology version written to frame 0
+            bool in_frame0;                     //!< True if this writer wrote frame 0 of the file
+            std::vector<EncodedChunk> chunks;   //!< Chunks to write (only on the root rank)
+            };
+
         std::string m_fname;                //!< The file name we are writing to
         bool m_overwrite;                   //!< True if file should be overwritten
         bool m_truncate;                    //!< True if we should truncate the file on every analyze()
@@ -84,20 +137,66 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         bool m_write_property;              //!< True if properties should be written
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
+        bool m_compress;                    //!< True if integer chunks should be compressed
+        Scalar m_precision;                 //!< Relative precision of quantized chunks (0 disables quantization)
+        unsigned int m_keyframe_period;     //!< Number of frames between keyframes (0 disables delta encoding)
+        Scalar m_tolerance;                 //!< Displacement below which positions are not stored in delta frames
+        unsigned int m_frames_since_keyframe; //!< Number of delta frames written since the last keyframe
+        std::vector< vec3<float> > m_ref_pos; //!< Last stored position of each group member
+        std::vector<unsigned int> m_ref_tag;  //!< Tag of each group member when the last keyframe was written
         gsd_handle m_handle;                //!< Handle to the file
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
         std::map<std::string, bool> m_nondefault; //!< Map of quantities (true when non-default in frame 0)
+        std::map<std::string, std::shared_ptr<ParticleGroup> > m_field_groups; //!< Groups of subset-only chunks
+        std::map<std::string, TopologyCache> m_topology_cache; //!< Cached topology chunks by prefix
         std::map<std::string, pybind11::function> m_user_log;   //!< Map of user-defined quantities to log
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
+        //! Encode a type mapping
+        void encodeTypeMapping(const std::string& chunk, const std::vector< std::string >& type_mapping, EncodedChunk& out);
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
         //! Initializes the output file for writing
         void initFileIO();
 
+        //! Encode a data chunk, compressed when requested
+        void encodeChunk(const char *name,
+                         gsd_type type,
+                         uint32_t N,
+                         uint32_t M,
+                         const void *data,
+                         const std::vector<double>& quantum,
+                         EncodedChunk& out);
+
+        //! Write an encoded data chunk
+        void writeEncodedChunk(const EncodedChunk& chunk);
+
+        //! Write a data chunk, compressed when requested
+        void writeChunk(const char *name,
+                        gsd_type type,
+                        uint32_t N,
+                        uint32_t M,
+                        const void *data,
+                        const std::vector<double>& quantum=std::vector<double>());
+
+        //! Write a per-particle data chunk, or only the rows of its field group
+        void writeParticleChunk(const char *name,
+                                gsd_type type,
+                                uint32_t M,
+                                const void *data,
+                                const std::vector<double>& quantum=std::vector<double>());
+
+        //! Write the sparse rows of a per-particle quantity
+        void writeSparseChunk(const std::string& name,
+                              gsd_type type,
+                              uint32_t M,
+                              const void *data,
+                              const std::vector<uint32_t>& rows);
+
         //! Write frame header
         void writeFrameHeader(unsigned int timestep);
 
@@ -110,13 +209,15 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         //! Write particle momenta
         void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
 
-        //! Write bond topology
-        void writeTopology(BondData::Snapshot& bond,
-                           AngleData::Snapshot& angle,
-                           DihedralData::Snapshot& dihedral,
-                           ImproperData::Snapshot& improper,
-                           ConstraintData::Snapshot& constraint,
-                           PairData::Snapshot& pair);
+        //! Write the topology chunks of one kind of bonded groups
+        template<class group_data>
+        void writeGroups(const std::string& prefix, std::shared_ptr<group_data> gdata, uint64_t nframes, bool root);
+
+        //! Encode the topology chunks of one kind of bonded groups
+        template<class group_data>
+        void encodeGroups(const std::string& prefix,
+                          const typename group_data::Snapshot& snapshot,
+                          std::vector<EncodedChunk>& chunks);
 
         //! Write user defined log data
         void writeUser(unsigned int timestep, bool root);
@@ -9,12 +9,17 @@
 */
 
 #include "GSDReader.h"
+#include "GSDChunkCodec.h"
 #include "SnapshotSystemData.h"
 #include "ExecutionConfiguration.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
 
 #include <stdexcept>
+#include <algorithm>
 using namespace std;
 
 namespace py = pybind11;
@@ -23,21 +28,26 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed If true, every rank reads its own slice of the particles and groups
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
-    memory (on the root rank).
+    memory (on the root rank, or a slice on every rank in a distributed read).
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_distributed(false), m_n_particles(0)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
+    m_distributed = distributed && m_exec_conf->getNRanks() > 1;
+    m_snapshot->distributed = m_distributed;
+
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -81,7 +91,7 @@ GSDReader::~GSDReader()
     {
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -90,6 +100,188 @@ GSDReader::~GSDReader()
     gsd_close(&m_handle);
     }
 
+/*! \returns The number of frames in the file, on all ranks
+*/
+uint64_t GSDReader::getNFrames() const
+    {
+    uint64_t nframes = 0;
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->isRoot() || m_distributed)
+    #endif
+        {
+        nframes = gsd_get_nframes(const_cast<gsd_handle*>(&m_handle));
+        }
+
+    #ifdef ENABLE_MPI
+    bcast(nframes, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    return nframes;
+    }
+
+/*! \param frame Frame index to read
+
+    Read \a frame into a new snapshot, replacing the current one. Snapshots previously obtained with getSnapshot()
+    are not modified. The file is not reopened, so reading a sequence of frames only costs the reads of their data
+    chunks. readFrame() does not communicate; call getTimeStep() afterwards to obtain the time step on all ranks.
+*/
+void GSDReader::readFrame(uint64_t frame)
+    {
+    m_frame = frame;
+    m_timestep = 0;
+    m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
+    m_snapshot->distributed = m_distributed;
+
+    #ifdef ENABLE_MPI
+    // if we are not the root processor, do not perform file I/O
+    if (!m_exec_conf->isRoot() && !m_distributed)
+        {
+        return;
+        }
+    #endif
+
+    uint64_t nframes = gsd_get_nframes(&m_handle);
+    if (m_frame >= nframes)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Cannot read frame " << m_frame << " " << m_name << " only has " << nframes << " frames" << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    readHeader();
+    readParticles();
+    readTopology();
+    }
+
+/*! \param frame Frame index to prefetch
+
+    Advise the operating system that the data chunks of \a frame will be read soon. The kernel reads them into the
+    page cache in the background, so that the file I/O of the next frame overlaps with the work on the current one
+    and the following readFrame() does not wait on the disk. Prefetching is only a hint and does nothing on systems
+    without posix_fadvise().
+*/
+void GSDReader::prefetchFrame(uint64_t frame) const
+    {
+    #ifdef POSIX_FADV_WILLNEED
+    #ifdef ENABLE_MPI
+    if (!m_exec_conf->isRoot() && !m_distributed)
+        return;
+    #endif
+
+    // the index is sorted by frame, find the first entry of the frame
+    const gsd_index_entry *begin = m_handle.file_index.data;
+    const gsd_index_entry *end = begin + m_handle.file_index.size;
+    const gsd_index_entry *entry = std::lower_bound(begin, end, frame,
+        [](const gsd_index_entry& e, uint64_t f) { return e.frame < f; });
+
+    for (; entry != end && entry->frame == frame; ++entry)
+        {
+        size_t size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+        posix_fadvise(m_handle.fd, entry->location, size, POSIX_FADV_WILLNEED);
+        }
+    #endif
+    }
+
+/*! \param frame Frame index to check
+    \returns true if any topology chunk is stored at \a frame itself, false on ranks that do not read the file
+
+    Frames without topology chunks use the topology of frame 0 (see findChunk()).
+*/
+bool GSDReader::hasTopology(uint64_t frame) const
+    {
+    #ifdef ENABLE_MPI
+    if (!m_exec_conf->isRoot() && !m_distributed)
+        return false;
+    #endif
+
+    const char *names[] = {"bonds/N", "angles/N", "dihedrals/N", "impropers/N", "constraints/N", "pairs/N"};
+    gsd_handle *handle = const_cast<gsd_handle*>(&m_handle);
+    for (unsigned int i = 0; i < sizeof(names)/sizeof(names[0]); i++)
+        {
+        if (gsd_find_chunk(handle, frame, names[i]) != NULL)
+            return true;
+        }
+    return false;
+    }
+
+/*! \param frame Frame index to search
+    \param name Name of the data chunk
+    \param encoded Set to true when the chunk is stored in compressed form (output)
+
+    Find the data chunk of the given name at the given frame, or its compressed form written by GSDDumpWriter (see
+    GSDChunkCodec). If neither is present at this frame, search frame 0. Return NULL if the chunk is not found.
+*/
+const gsd_index_entry* GSDReader::findChunk(uint64_t frame, const char *name, bool& encoded)
+    {
+    std::string encoded_name = std::string(name) + GSDChunkCodec::getSuffix();
+
+    const struct gsd_index_entry* entry = NULL;
+    uint64_t frames[2] = {frame, 0};
+    for (unsigned int i = 0; i < (frame != 0 ? 2 : 1) && entry == NULL; i++)
+        {
+        encoded = false;
+        entry = gsd_find_chunk(&m_handle, frames[i], name);
+        if (entry == NULL)
+            {
+            encoded = true;
+            entry = gsd_find_chunk(&m_handle, frames[i], encoded_name.c_str());
+            }
+        }
+
+    return entry;
+    }
+
+/*! \param data Pointer to data to read into
+    \param entry Index entry of the compressed chunk
+    \param name Name of the data chunk
+    \param expected_size Expected size of the data chunk in bytes, or of one row when \a slice is true.
+    \param cur_n N in the current frame.
+    \param slice If true, read only the rows of this rank's slice (see getSlice())
+
+    Read a compressed chunk and decode it into \a data. Only the blocks that cover the requested rows are decoded.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readEncodedChunk(void *data,
+                                 const gsd_index_entry* entry,
+                                 const char *name,
+                                 size_t expected_size,
+                                 unsigned int cur_n,
+                                 bool slice)
+    {
+    if (entry->type != GSD_TYPE_UINT8 || entry->M != 1)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid compressed chunk " << name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    std::vector<char> encoded(entry->N);
+    int retval = gsd_read_chunk(&m_handle, encoded.data(), entry);
+    checkError(retval);
+
+    GSDChunkCodec::Header header = GSDChunkCodec::readHeader(encoded.data(), encoded.size());
+    if (cur_n != 0 && header.N != cur_n)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    size_t row_size = header.M * gsd_sizeof_type((enum gsd_type)header.type);
+    if ((slice && row_size != expected_size) || (!slice && row_size*header.N != expected_size))
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << (slice ? expected_size*header.N : expected_size) << " bytes in " << name << " but found " << row_size*header.N << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    unsigned int first = 0, count = header.N;
+    if (slice)
+        getSlice(header.N, first, count);
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: decoding chunk " << name << endl;
+    GSDChunkCodec::decode(encoded.data(), encoded.size(), first, count, data);
+    return true;
+    }
+
 /*! \param data Pointer to data to read into
     \param frame Frame index to read from
     \param name Name of the data chunk
@@ -98,7 +290,8 @@ GSDReader::~GSDReader()
 
     Attempts to read the data chunk of the given name at the given frame. If it is not present at this
     frame, attempt to read from frame 0. If it is also not present at frame 0, return false.
-    If the found data chunk is not the expected size, throw an exception.
+    If the found data chunk is not the expected size, throw an exception. Compressed chunks are decoded
+    transparently.
 
     Per the GSD spec, keep the default when the frame 0 N does not match the current N.
 
@@ -106,9 +299,11 @@ GSDReader::~GSDReader()
 */
 bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n)
     {
-    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
-    if (entry == NULL && frame != 0)
-        entry = gsd_find_chunk(&m_handle, 0, name);
+    bool encoded = false;
+    const struct gsd_index_entry* entry = findChunk(frame, name, encoded);
+
+    if (entry != NULL && encoded)
+        return readEncodedChunk(data, entry, name, expected_size, cur_n, false);
 
     if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
         {
@@ -131,6 +326,91 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
         }
     }
 
+/*! \param N Number of rows in the chunk
+    \param first First row read by this rank
+    \param count Number of rows read by this rank
+
+    In a distributed read, rank r reads rows [r*N/n_ranks, (r+1)*N/n_ranks). Otherwise, all rows are read.
+*/
+void GSDReader::getSlice(unsigned int N, unsigned int& first, unsigned int& count) const
+    {
+    first = 0;
+    count = N;
+
+    #ifdef ENABLE_MPI
+    if (m_distributed)
+        {
+        uint64_t rank = m_exec_conf->getRank();
+        uint64_t n_ranks = m_exec_conf->getNRanks();
+        first = rank*N/n_ranks;
+        count = (rank+1)*N/n_ranks - first;
+        }
+    #endif
+    }
+
+/*! \param data Pointer to data to read into
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param row_size Expected size of one row of the data chunk in bytes.
+    \param cur_n N in the current frame.
+
+    Like readChunk(), but reads only the rows of this rank's slice (see getSlice()) with a single
+    positioned read of the byte range, instead of the whole chunk. \a data must hold count*row_size bytes.
+    Compressed chunks are read whole, and only the blocks that cover the slice are decoded.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readChunkSlice(void *data, uint64_t frame, const char *name, size_t row_size, unsigned int cur_n)
+    {
+    if (!m_distributed)
+        return readChunk(data, frame, name, cur_n*row_size, cur_n);
+
+    bool encoded = false;
+    const struct gsd_index_entry* entry = findChunk(frame, name, encoded);
+
+    if (entry != NULL && encoded)
+        return readEncodedChunk(data, entry, name, row_size, cur_n, true);
+
+    if (entry == NULL || entry->N != cur_n)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading slice of chunk " << name << endl;
+    size_t actual_row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_row_size != row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << row_size*cur_n << " bytes in " << name << " but found " << actual_row_size*entry->N << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    unsigned int first, count;
+    getSlice(cur_n, first, count);
+
+    int64_t offset = entry->location + int64_t(first)*row_size;
+    size_t size = size_t(count)*row_size;
+    if (entry->location == 0 || offset + int64_t(size) > m_handle.file_size)
+        checkError(GSD_ERROR_FILE_CORRUPT);
+
+    // positioned read of the byte range, retrying on partial reads
+    char *buf = (char *)data;
+    while (size > 0)
+        {
+        ssize_t bytes_read = ::pread(m_handle.fd, buf, size, offset);
+        if (bytes_read == -1 && errno == EINTR)
+            continue;
+        if (bytes_read <= 0)
+            checkError(GSD_ERROR_IO);
+
+        buf += bytes_read;
+        offset += bytes_read;
+        size -= bytes_read;
+        }
+
+    return true;
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -195,98 +475,243 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_n_particles = N;
+
+    unsigned int first, count;
+    getSlice(N, first, count);
+    m_snapshot->particle_data.resize(count);
     }
 
 /*! Read the same data chunks for particles
 */
 void GSDReader::readParticles()
     {
-    uint64_t N = m_snapshot->particle_data.size;
+    unsigned int N = m_n_particles;
     m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
 
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
-    readChunk(&m_snapshot->particle_data.type[0], m_frame, "particles/typeid", N*4, N);
-    readChunk(&m_snapshot->particle_data.mass[0], m_frame, "particles/mass", N*4, N);
-    readChunk(&m_snapshot->particle_data.charge[0], m_frame, "particles/charge", N*4, N);
-    readChunk(&m_snapshot->particle_data.diameter[0], m_frame, "particles/diameter", N*4, N);
-    readChunk(&m_snapshot->particle_data.body[0], m_frame, "particles/body", N*4, N);
-    readChunk(&m_snapshot->particle_data.inertia[0], m_frame, "particles/moment_inertia", N*12, N);
-    readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N*12, N);
-    readChunk(&m_snapshot->particle_data.orientation[0], m_frame, "particles/orientation", N*16, N);
-    readChunk(&m_snapshot->particle_data.vel[0], m_frame, "particles/velocity", N*12, N);
-    readChunk(&m_snapshot->particle_data.angmom[0], m_frame, "particles/angmom", N*16, N);
-    readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N*12, N);
+    readChunkSlice(m_snapshot->particle_data.type.data(), m_frame, "particles/typeid", 4, N);
+    readChunkSlice(m_snapshot->particle_data.mass.data(), m_frame, "particles/mass", 4, N);
+    readChunkSlice(m_snapshot->particle_data.charge.data(), m_frame, "particles/charge", 4, N);
+    readChunkSlice(m_snapshot->particle_data.diameter.data(), m_frame, "particles/diameter", 4, N);
+    readChunkSlice(m_snapshot->particle_data.body.data(), m_frame, "particles/body", 4, N);
+    readChunkSlice(m_snapshot->particle_data.inertia.data(), m_frame, "particles/moment_inertia", 12, N);
+    readChunkSlice(m_snapshot->particle_data.orientation.data(), m_frame, "particles/orientation", 16, N);
+    readChunkSlice(m_snapshot->particle_data.vel.data(), m_frame, "particles/velocity", 12, N);
+    readChunkSlice(m_snapshot->particle_data.angmom.data(), m_frame, "particles/angmom", 16, N);
+    readChunkSlice(m_snapshot->particle_data.image.data(), m_frame, "particles/image", 12, N);
+
+    readSubset(m_snapshot->particle_data.orientation.data(), "particles/orientation", 16);
+    readSubset(m_snapshot->particle_data.vel.data(), "particles/velocity", 12);
+    readSubset(m_snapshot->particle_data.angmom.data(), "particles/angmom", 16);
+    readSubset(m_snapshot->particle_data.image.data(), "particles/image", 12);
+
+    readPositions();
+    }
+
+/*! Read particles/position at the current frame. When the frame is a delta frame (it stores
+    particles/position/delta_index), read the positions of the last keyframe before it and apply the
+    sparse rows of all delta frames after the keyframe in order.
+*/
+void GSDReader::readPositions()
+    {
+    unsigned int N = m_n_particles;
+    uint64_t keyframe = m_frame;
+    while (keyframe > 0 && gsd_find_chunk(&m_handle, keyframe, "particles/position/delta_index") != NULL)
+        keyframe--;
+
+    readChunkSlice(m_snapshot->particle_data.pos.data(), keyframe, "particles/position", 12, N);
+
+    std::vector<uint32_t> rows;
+    std::vector<char> values;
+    for (uint64_t frame = keyframe+1; frame <= m_frame; frame++)
+        {
+        if (readSparseChunk(frame, "particles/position", "/delta", 12, rows, values))
+            applySparseRows(m_snapshot->particle_data.pos.data(), 12, rows, values);
+        }
+
+    // quantized positions may round onto the box boundary, wrap them back into the box
+    bool encoded = false;
+    if (findChunk(keyframe, "particles/position", encoded) != NULL && encoded)
+        {
+        const BoxDim& box = m_snapshot->global_box;
+        for (unsigned int i = 0; i < m_snapshot->particle_data.size; i++)
+            {
+            vec3<float>& p = m_snapshot->particle_data.pos[i];
+            Scalar3 pos = make_scalar3(p.x, p.y, p.z);
+            box.wrap(pos, m_snapshot->particle_data.image[i]);
+            p = vec3<float>(pos.x, pos.y, pos.z);
+            }
+        }
+    }
+
+/*! \param frame Frame index to read from
+    \param name Name of the per-particle quantity
+    \param suffix Suffix of the sparse chunks (/delta or /subset)
+    \param row_size Expected size of one row of the values in bytes
+    \param rows Rows of the quantity stored in the frame (output)
+    \param values Values of the stored rows (output)
+
+    Read the sparse chunks <name><suffix>_index and <name><suffix>_value stored exactly at \a frame. Unlike
+    readChunk(), this does not fall back to frame 0.
+
+    Return true if the sparse chunks are present in the frame.
+*/
+bool GSDReader::readSparseChunk(uint64_t frame,
+                                const std::string& name,
+                                const char *suffix,
+                                size_t row_size,
+                                std::vector<uint32_t>& rows,
+                                std::vector<char>& values)
+    {
+    std::string index_name = name + suffix + "_index";
+    std::string value_name = name + suffix + "_value";
+    const gsd_index_entry *index_entry = gsd_find_chunk(&m_handle, frame, index_name.c_str());
+    if (index_entry == NULL)
+        return false;
+
+    const gsd_index_entry *value_entry = gsd_find_chunk(&m_handle, frame, value_name.c_str());
+    if (value_entry == NULL || index_entry->type != GSD_TYPE_UINT32 || index_entry->M != 1
+        || value_entry->N != index_entry->N
+        || value_entry->M * gsd_sizeof_type((enum gsd_type)value_entry->type) != row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid sparse chunks " << index_name << " and "
+                                  << value_name << " in frame " << frame << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading " << index_entry->N << " rows of " << name << suffix
+                                << " in frame " << frame << endl;
+    rows.resize(index_entry->N);
+    values.resize(index_entry->N*row_size);
+    if (index_entry->N > 0)
+        {
+        int retval = gsd_read_chunk(&m_handle, rows.data(), index_entry);
+        checkError(retval);
+        retval = gsd_read_chunk(&m_handle, values.data(), value_entry);
+        checkError(retval);
+        }
+
+    for (unsigned int i = 0; i < rows.size(); i++)
+        {
+        if (rows[i] >= m_n_particles)
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid row " << rows[i] << " in " << index_name
+                                      << " in frame " << frame << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+        }
+
+    return true;
+    }
+
+/*! \param data Per-particle array of this rank's slice to update
+    \param row_size Size of one row in bytes
+    \param rows Rows to update
+    \param values Values of the rows
+*/
+void GSDReader::applySparseRows(void *data, size_t row_size, const std::vector<uint32_t>& rows, const std::vector<char>& values)
+    {
+    unsigned int first, count;
+    getSlice(m_n_particles, first, count);
+
+    for (unsigned int i = 0; i < rows.size(); i++)
+        {
+        if (rows[i] >= first && rows[i] < first + count)
+            memcpy((char *)data + size_t(rows[i] - first)*row_size, &values[i*row_size], row_size);
+        }
+    }
+
+/*! \param data Per-particle array of this rank's slice, already read with readChunkSlice()
+    \param name Name of the per-particle quantity
+    \param row_size Size of one row in bytes
+
+    When the quantity is written only for a group of particles in the current frame, replace the rows of the members.
+*/
+void GSDReader::readSubset(void *data, const char *name, size_t row_size)
+    {
+    std::vector<uint32_t> rows;
+    std::vector<char> values;
+    if (readSparseChunk(m_frame, name, "/subset", row_size, rows, values))
+        applySparseRows(data, row_size, rows, values);
     }
 
 /*! Read the same data chunks for topology
 */
 void GSDReader::readTopology()
     {
-    uint64_t N = 0;
+    unsigned int first, count;
+
+    unsigned int N = 0;
     readChunk(&N, m_frame, "bonds/N", 4);
+    getSlice(N, first, count);
     if (N > 0)
         {
-        m_snapshot->bond_data.resize(N);
+        m_snapshot->bond_data.resize(count);
         m_snapshot->bond_data.type_mapping = readTypes(m_frame, "bonds/types");
-        readChunk(&m_snapshot->bond_data.type_id[0], m_frame, "bonds/typeid", N*4, N);
-        readChunk(&m_snapshot->bond_data.groups[0], m_frame, "bonds/group", N*8, N);
+        readChunkSlice(m_snapshot->bond_data.type_id.data(), m_frame, "bonds/typeid", 4, N);
+        readChunkSlice(m_snapshot->bond_data.groups.data(), m_frame, "bonds/group", 8, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "angles/N", 4);
+    getSlice(N, first, count);
     if (N > 0)
         {
-        m_snapshot->angle_data.resize(N);
+        m_snapshot->angle_data.resize(count);
         m_snapshot->angle_data.type_mapping = readTypes(m_frame, "angles/types");
-        readChunk(&m_snapshot->angle_data.type_id[0], m_frame, "angles/typeid", N*4, N);
-        readChunk(&m_snapshot->angle_data.groups[0], m_frame, "angles/group", N*12, N);
+        readChunkSlice(m_snapshot->angle_data.type_id.data(), m_frame, "angles/typeid", 4, N);
+        readChunkSlice(m_snapshot->angle_data.groups.data(), m_frame, "angles/group", 12, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "dihedrals/N", 4);
+    getSlice(N, first, count);
     if (N > 0)
         {
-        m_snapshot->dihedral_data.resize(N);
+        m_snapshot->dihedral_data.resize(count);
         m_snapshot->dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
-        readChunk(&m_snapshot->dihedral_data.type_id[0], m_frame, "dihedrals/typeid", N*4, N);
-        readChunk(&m_snapshot->dihedral_data.groups[0], m_frame, "dihedrals/group", N*16, N);
+        readChunkSlice(m_snapshot->dihedral_data.type_id.data(), m_frame, "dihedrals/typeid", 4, N);
+        readChunkSlice(m_snapshot->dihedral_data.groups.data(), m_frame, "dihedrals/group", 16, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "impropers/N", 4);
+    getSlice(N, first, count);
     if (N > 0)
         {
-        m_snapshot->improper_data.resize(N);
+        m_snapshot->improper_data.resize(count);
         m_snapshot->improper_data.type_mapping = readTypes(m_frame, "impropers/types");
-        readChunk(&m_snapshot->improper_data.type_id[0], m_frame, "impropers/typeid", N*4, N);
-        readChunk(&m_snapshot->improper_data.groups[0], m_frame, "impropers/group", N*16, N);
+        readChunkSlice(m_snapshot->improper_data.type_id.data(), m_frame, "impropers/typeid", 4, N);
+        readChunkSlice(m_snapshot->improper_data.groups.data(), m_frame, "impropers/group", 16, N);
         }
 
     N = 0;
     readChunk(&N, m_frame, "constraints/N", 4);
+    getSlice(N, first, count);
     if (N > 0)
         {
-        m_snapshot->constraint_data.resize(N);
-        std::vector<float> data(N);
-        readChunk(&data[0], m_frame, "constraints/value", N*4, N);
-        for (unsigned int i=0; i < N; i++)
+        m_snapshot->constraint_data.resize(count);
+        std::vector<float> data(count);
+        readChunkSlice(data.data(), m_frame, "constraints/value", 4, N);
+        for (unsigned int i=0; i < count; i++)
             m_snapshot->constraint_data.val[i] = Scalar(data[i]);
 
-        readChunk(&m_snapshot->constraint_data.groups[0], m_frame, "constraints/group", N*8, N);
+        readChunkSlice(m_snapshot->constraint_data.groups.data(), m_frame, "constraints/group", 8, N);
         }
 
     if (m_handle.header.schema_version >= gsd_make_version(1,1))
         {
         N = 0;
         readChunk(&N, m_frame, "pairs/N", 4);
+        getSlice(N, first, count);
         if (N > 0)
             {
-            m_snapshot->pair_data.resize(N);
+            m_snapshot->pair_data.resize(count);
             m_snapshot->pair_data.type_mapping = readTypes(m_frame, "pairs/types");
-            readChunk(&m_snapshot->pair_data.type_id[0], m_frame, "pairs/typeid", N*4, N);
-            readChunk(&m_snapshot->pair_data.groups[0], m_frame, "pairs/group", N*8, N);
+            readChunkSlice(m_snapshot->pair_data.type_id.data(), m_frame, "pairs/typeid", 4, N);
+            readChunkSlice(m_snapshot->pair_data.groups.data(), m_frame, "pairs/group", 8, N);
             }
         }
     }
@@ -360,9 +785,11 @@ void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
     .def("readTypeShapesPy", &GSDReader::readTypeShapesPy)
+    .def("getNFrames", &GSDReader::getNFrames)
     ;
     }
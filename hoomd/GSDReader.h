@@ -30,6 +30,17 @@ template <class Real> struct SnapshotSystemData;
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    The file stays open for the lifetime of the reader, and readFrame() reads further frames into new snapshots
+    through the (memory mapped) index without reopening it. System::replay() uses this to stream a trajectory.
+
+    Frames written by GSDDumpWriter in delta mode are reconstructed: the positions of a delta frame are read from the
+    last keyframe and updated with the sparse rows of all delta frames since. The sparse rows of chunks written only
+    for a group of particles replace the rows of the values read from frame 0 (or the defaults).
+
+    By default, only the root rank reads the file. In a *distributed* read, every rank opens the file and
+    reads only its own contiguous slice of the per-particle and per-group chunks into a distributed
+    snapshot (see SnapshotSystemData), which SystemDefinition then moves to the owning domains.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -39,7 +50,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool distributed=false);
 
         //! Destructor
         ~GSDReader();
@@ -70,9 +82,24 @@ class PYBIND11_EXPORT GSDReader
             return m_frame;
             }
 
+        //! Returns the number of frames in the file
+        uint64_t getNFrames() const;
+
+        //! Read another frame of the open file into a new snapshot
+        void readFrame(uint64_t frame);
+
+        //! Ask the operating system to read the data chunks of a frame ahead
+        void prefetchFrame(uint64_t frame) const;
+
+        //! Test if the topology is stored at the given frame (and not only in frame 0)
+        bool hasTopology(uint64_t frame) const;
+
         //! Helper function to read a quantity from the file
         bool readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n=0);
 
+        //! Helper function to read this rank's slice of a per-particle or per-group quantity
+        bool readChunkSlice(void *data, uint64_t frame, const char *name, size_t row_size, unsigned int cur_n);
+
         //! clears the snapshot object
         void clearSnapshot()
             {
@@ -94,10 +121,43 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_distributed;                                          //!< True if every rank reads a slice of the file
+        unsigned int m_n_particles;                                  //!< Global number of particles in the frame
+
+        //! Find a data chunk or its compressed form
+        const gsd_index_entry* findChunk(uint64_t frame, const char *name, bool& encoded);
+
+        //! Helper function to decode rows of a compressed data chunk
+        bool readEncodedChunk(void *data,
+                              const gsd_index_entry* entry,
+                              const char *name,
+                              size_t expected_size,
+                              unsigned int cur_n,
+                              bool slice);
+
+        //! Helper function to read the rows of a sparse chunk stored at a frame
+        bool readSparseChunk(uint64_t frame,
+                             const std::string& name,
+                             const char *suffix,
+                             size_t row_size,
+                             std::vector<uint32_t>& rows,
+                             std::vector<char>& values);
+
+        //! Copy the rows of a sparse chunk that are in this rank's slice
+        void applySparseRows(void *data, size_t row_size, const std::vector<uint32_t>& rows, const std::vector<char>& values);
+
+        //! Overlay the rows of a per-particle quantity written only for a group
+        void readSubset(void *data, const char *name, size_t row_size);
+
+        //! Read the positions, reconstructing delta frames from the last keyframe
+        void readPositions();
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
 
+        //! Get the range of rows of an N row chunk read by this rank
+        void getSlice(unsigned int N, unsigned int& first, unsigned int& count) const;
+
         // helper functions to read sections of the file
         void readHeader();
         void readParticles();
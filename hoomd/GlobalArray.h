@@ -220,7 +220,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
     public:
         //! Empty constructor
         GlobalArray()
-            : m_num_elements(0), m_pitch(0), m_height(0), m_acquired(false), m_align_bytes(0), m_is_managed(false)
+            : m_num_elements(0), m_pitch(0), m_height(0), m_acquired(0), m_align_bytes(0), m_is_managed(false)
             { }
 
         /*! Allocate a 1D array in managed memory
@@ -235,7 +235,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             m_fallback((exec_conf->allConcurrentManagedAccess() || (force_managed && exec_conf->isCUDAEnabled())) ?
                 GPUArray<T>() : GPUArray<T>(num_elements, exec_conf)),
             #endif
-            m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(false), m_tag(tag),
+            m_num_elements(num_elements), m_pitch(num_elements), m_height(1), m_acquired(0), m_tag(tag),
             m_align_bytes(0),
             m_is_managed(exec_conf->allConcurrentManagedAccess() || (force_managed && exec_conf->isCUDAEnabled()))
             {
@@ -269,7 +269,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
               m_fallback(from.m_fallback),
               #endif
               m_num_elements(from.m_num_elements),
-              m_pitch(from.m_pitch), m_height(from.m_height), m_acquired(false),
+              m_pitch(from.m_pitch), m_height(from.m_height), m_acquired(0),
               m_tag(from.m_tag), m_align_bytes(from.m_align_bytes),
               m_is_managed(false)
             {
@@ -307,7 +307,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                 m_num_elements = rhs.m_num_elements;
                 m_pitch = rhs.m_pitch;
                 m_height = rhs.m_height;
-                m_acquired = false;
+                m_acquired = 0;
                 m_align_bytes = rhs.m_align_bytes;
                 m_tag = rhs.m_tag;
 
@@ -349,7 +349,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
               m_num_elements(std::move(other.m_num_elements)),
               m_pitch(std::move(other.m_pitch)),
               m_height(std::move(other.m_height)),
-              m_acquired(std::move(other.m_acquired)),
+              m_acquired(other.m_acquired.load()),
               m_tag(std::move(other.m_tag)),
               m_align_bytes(std::move(other.m_align_bytes)),
               m_is_managed(std::move(other.m_is_managed))
@@ -373,7 +373,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                 m_num_elements = std::move(other.m_num_elements);
                 m_pitch = std::move(other.m_pitch);
                 m_height = std::move(other.m_height);
-                m_acquired = std::move(other.m_acquired);
+                m_acquired = other.m_acquired.load();
                 m_tag = std::move(other.m_tag);
                 m_align_bytes = std::move(other.m_align_bytes);
                 m_is_managed = std::move(other.m_is_managed);
@@ -397,7 +397,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             m_fallback((exec_conf->allConcurrentManagedAccess() || (force_managed && exec_conf->isCUDAEnabled())) ?
                 GPUArray<T>() : GPUArray<T>(width, height, exec_conf)),
             #endif
-            m_height(height), m_acquired(false), m_align_bytes(0),
+            m_height(height), m_acquired(0), m_align_bytes(0),
             m_is_managed(exec_conf->allConcurrentManagedAccess() || (force_managed && exec_conf->isCUDAEnabled()))
             {
             #ifndef ALWAYS_USE_MANAGED_MEMORY
@@ -640,13 +640,13 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
         //! Release the data pointer
         inline void release() const
             {
-            m_acquired = false;
+            hoomd::detail::release_handle(m_acquired);
             }
 
         //! Returns the acquire state
         inline bool isAcquired() const
             {
-            return m_acquired;
+            return m_acquired != 0;
             }
 
         //! Need to be friends with ArrayHandle
@@ -671,7 +671,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
         unsigned int m_pitch;  //!< Pitch of 2D array
         unsigned int m_height; //!< Height of 2D array
 
-        mutable bool m_acquired;       //!< Tracks if the array is already acquired
+        mutable std::atomic<int> m_acquired;   //!< Number of shared read handles, or -1 if acquired exclusively
 
         std::string m_tag;     //!< Name tag of this buffer (optional)
 
@@ -810,8 +810,8 @@ inline ArrayHandleDispatch<T> GlobalArray<T>::acquire(const access_location::Enu
             );
     #endif
 
-    checkAcquired(*this);
-    m_acquired = true;
+    // read only handles on the host may be shared between threads, like those of GPUArray
+    hoomd::detail::acquire_handle(m_acquired, location == access_location::host && mode == access_mode::read);
 
     // make sure a null array can be acquired
     if (!this->m_exec_conf || isNull() )
@@ -24,6 +24,10 @@
 
 #include <sstream>
 #include <vector>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+#include <limits>
 
 #include <cereal/types/set.hpp>
 #include <cereal/types/string.hpp>
@@ -416,6 +420,219 @@ void all_gather_v(const T& in_value, std::vector<T> & out_values, const MPI_Comm
     delete[] rbuf;
     }
 
+//! Committed MPI derived datatype describing one element of a trivially copyable type
+/*! The typed collectives below send arrays of plain data (Scalar3, int3, unsigned int, ...) directly from
+    their memory, one element of this datatype per array entry, without serialization.
+*/
+template<typename T>
+class MPIContiguousType
+    {
+    public:
+        MPIContiguousType()
+            {
+            static_assert(std::is_trivially_copyable<T>::value, "MPIContiguousType requires trivially copyable types");
+            MPI_Type_contiguous(sizeof(T), MPI_BYTE, &m_type);
+            MPI_Type_commit(&m_type);
+            }
+
+        ~MPIContiguousType()
+            {
+            MPI_Type_free(&m_type);
+            }
+
+        //! Get the MPI datatype
+        operator MPI_Datatype() const
+            {
+            return m_type;
+            }
+
+    private:
+        MPI_Datatype m_type;     //!< The committed datatype
+
+        MPIContiguousType(const MPIContiguousType&) = delete;
+        MPIContiguousType& operator=(const MPIContiguousType&) = delete;
+    };
+
+//! Scatter contiguous arrays of plain data from the root to all ranks
+/*! \param in_values (root only) Values for all ranks, concatenated in rank order
+    \param counts (root only) Number of values for every rank
+    \param out_values Values received by this rank
+    \param root Rank that scatters the data
+    \param mpi_comm The MPI communicator
+*/
+template<typename T>
+void scatter_array(const T *in_values, const std::vector<unsigned int>& counts, std::vector<T>& out_values,
+    unsigned int root, const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    std::vector<int> send_counts;
+    std::vector<int> displs;
+    if (rank == (int) root)
+        {
+        assert(counts.size() == (unsigned int) size);
+        send_counts.resize(size);
+        displs.resize(size);
+        for (int i = 0; i < size; ++i)
+            {
+            send_counts[i] = counts[i];
+            displs[i] = (i > 0) ? displs[i-1] + send_counts[i-1] : 0;
+            }
+        }
+
+    int recv_count;
+    MPI_Scatter(send_counts.data(), 1, MPI_INT, &recv_count, 1, MPI_INT, root, mpi_comm);
+
+    out_values.resize(recv_count);
+
+    MPIContiguousType<T> type;
+    MPI_Scatterv((void *) in_values, send_counts.data(), displs.data(), type,
+        out_values.data(), recv_count, type, root, mpi_comm);
+    }
+
+//! Gather contiguous arrays of plain data from all ranks on the root
+/*! \param in_values Values of this rank
+    \param count Number of values of this rank
+    \param out_values (root only) Values of all ranks, concatenated in rank order
+    \param counts (root only) Number of values of every rank
+    \param root Rank that gathers the data
+    \param mpi_comm The MPI communicator
+*/
+template<typename T>
+void gather_array(const T *in_values, unsigned int count, std::vector<T>& out_values, std::vector<unsigned int>& counts,
+    unsigned int root, const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    int send_count = count;
+    std::vector<int> recv_counts;
+    std::vector<int> displs;
+    if (rank == (int) root)
+        {
+        recv_counts.resize(size);
+        displs.resize(size);
+        }
+
+    MPI_Gather(&send_count, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, root, mpi_comm);
+
+    if (rank == (int) root)
+        {
+        counts.resize(size);
+        unsigned int len = 0;
+        for (int i = 0; i < size; ++i)
+            {
+            displs[i] = len;
+            counts[i] = recv_counts[i];
+            len += recv_counts[i];
+            }
+        out_values.resize(len);
+        }
+
+    MPIContiguousType<T> type;
+    MPI_Gatherv((void *) in_values, send_count, type, out_values.data(), recv_counts.data(), displs.data(), type,
+        root, mpi_comm);
+    }
+
+//! Gather contiguous arrays of plain data from all ranks on the root, in bounded chunks
+/*! \param in_values Values of this rank
+    \param count Number of values of this rank
+    \param process (root only) Called as process(rank, offset, values, n) for every chunk received
+    \param root Rank that gathers the data
+    \param mpi_comm The MPI communicator
+    \param max_chunk_bytes Maximum size of a single chunk
+
+    The root never holds more than one chunk of the other ranks' data at a time, \a process is expected to
+    copy the values to their final destination. The root's own values are passed to \a process directly.
+*/
+template<typename T, typename F>
+void gather_array_chunked(const T *in_values, unsigned int count, F process, unsigned int root,
+    const MPI_Comm mpi_comm, size_t max_chunk_bytes = 64*1024*1024)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    unsigned int max_chunk = std::max(max_chunk_bytes / sizeof(T), size_t(1));
+
+    std::vector<unsigned int> counts;
+    if (rank == (int) root)
+        counts.resize(size);
+    MPI_Gather(&count, 1, MPI_UNSIGNED, counts.data(), 1, MPI_UNSIGNED, root, mpi_comm);
+
+    MPIContiguousType<T> type;
+
+    if (rank == (int) root)
+        {
+        std::vector<T> buf;
+        for (int i = 0; i < size; ++i)
+            {
+            if (i == (int) root)
+                {
+                process(i, 0u, in_values, count);
+                continue;
+                }
+
+            buf.resize(std::min(counts[i], max_chunk));
+            for (unsigned int offset = 0; offset < counts[i]; offset += max_chunk)
+                {
+                unsigned int n = std::min(counts[i] - offset, max_chunk);
+                MPI_Recv(buf.data(), n, type, i, 0, mpi_comm, MPI_STATUS_IGNORE);
+                process(i, offset, (const T *) buf.data(), n);
+                }
+            }
+        }
+    else
+        {
+        for (unsigned int offset = 0; offset < count; offset += max_chunk)
+            {
+            unsigned int n = std::min(count - offset, max_chunk);
+            MPI_Send((void *) (in_values + offset), n, type, root, 0, mpi_comm);
+            }
+        }
+    }
+
+//! Gather contiguous arrays of plain data from all ranks on all ranks
+/*! \param in_values Values of this rank
+    \param count Number of values of this rank
+    \param out_values Values of all ranks, concatenated in rank order
+    \param counts Number of values of every rank
+    \param mpi_comm The MPI communicator
+*/
+template<typename T>
+void all_gather_array(const T *in_values, unsigned int count, std::vector<T>& out_values, std::vector<unsigned int>& counts,
+    const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+
+    int send_count = count;
+    std::vector<int> recv_counts(size);
+    std::vector<int> displs(size);
+
+    MPI_Allgather(&send_count, 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+    counts.resize(size);
+    unsigned int len = 0;
+    for (int i = 0; i < size; ++i)
+        {
+        displs[i] = len;
+        counts[i] = recv_counts[i];
+        len += recv_counts[i];
+        }
+    out_values.resize(len);
+
+    MPIContiguousType<T> type;
+    MPI_Allgatherv((void *) in_values, send_count, type, out_values.data(), recv_counts.data(), displs.data(), type,
+        mpi_comm);
+    }
+
 //! Wrapper around MPI_Send that handles any serializable object
 template<typename T>
 void send(const T& val,const unsigned int dest, const MPI_Comm mpi_comm)
@@ -476,5 +693,85 @@ void recv(T& val,const unsigned int src, const MPI_Comm mpi_comm)
     }
 
 
+//! Exchange variable-length lists of plain data between all pairs of ranks
+/*! \param send_values Per-destination-rank lists of values to send (size == number of ranks)
+    \param recv_values Values received from all ranks, concatenated in order of the source rank
+    \param mpi_comm The MPI communicator
+
+    Unlike scatter_v() and gather_v(), no rank acts as a root: the per-pair counts are exchanged
+    with MPI_Alltoall and the payload is then sent with nonblocking point-to-point messages only
+    between pairs of ranks that actually have data for each other. T must be trivially copyable,
+    the values are sent with MPIContiguousType<T> without serialization. The counts are exchanged
+    as 64 bit integers and lists of more than INT_MAX values are split into several messages.
+*/
+template<typename T>
+void exchange_v(const std::vector< std::vector<T> >& send_values, std::vector<T>& recv_values, const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    assert(send_values.size() == (unsigned int) size);
+
+    std::vector<unsigned long long> send_counts(size);
+    for (int i = 0; i < size; ++i)
+        send_counts[i] = send_values[i].size();
+
+    std::vector<unsigned long long> recv_counts(size);
+    MPI_Alltoall(&send_counts.front(), 1, MPI_UNSIGNED_LONG_LONG, &recv_counts.front(), 1, MPI_UNSIGNED_LONG_LONG,
+        mpi_comm);
+
+    std::vector<size_t> recv_offsets(size);
+    size_t n_recv = 0;
+    for (int i = 0; i < size; ++i)
+        {
+        recv_offsets[i] = n_recv;
+        n_recv += recv_counts[i];
+        }
+
+    recv_values.resize(n_recv);
+
+    // MPI counts are int, larger lists are sent in several messages that arrive in order
+    const unsigned long long max_count = std::numeric_limits<int>::max();
+
+    MPIContiguousType<T> type;
+    std::vector<MPI_Request> reqs;
+
+    for (int i = 0; i < size; ++i)
+        {
+        if (i == rank)
+            continue;
+
+        for (unsigned long long offset = 0; offset < recv_counts[i]; offset += max_count)
+            {
+            MPI_Request req;
+            MPI_Irecv(recv_values.data() + recv_offsets[i] + offset, std::min(recv_counts[i] - offset, max_count),
+                type, i, 0, mpi_comm, &req);
+            reqs.push_back(req);
+            }
+        }
+
+    for (int i = 0; i < size; ++i)
+        {
+        if (i == rank)
+            continue;
+
+        for (unsigned long long offset = 0; offset < send_counts[i]; offset += max_count)
+            {
+            MPI_Request req;
+            MPI_Isend((void *) (send_values[i].data() + offset), std::min(send_counts[i] - offset, max_count),
+                type, i, 0, mpi_comm, &req);
+            reqs.push_back(req);
+            }
+        }
+
+    // values destined for this rank are copied directly
+    std::copy(send_values[rank].begin(), send_values[rank].end(), recv_values.begin() + recv_offsets[rank]);
+
+    if (reqs.size())
+        MPI_Waitall(reqs.size(), &reqs.front(), MPI_STATUSES_IGNORE);
+    }
+
 #endif // ENABLE_MPI
 #endif // __HOOMD_MPI_H__
@@ -20,6 +20,12 @@ namespace py = pybind11;
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#include <tbb/flow_graph.h>
+#include <map>
+#endif
+
 using namespace std;
 
 /*! \param sysdef System to update
@@ -48,6 +54,7 @@ void Integrator::addForceCompute(std::shared_ptr<ForceCompute> fc)
     {
     assert(fc);
     m_forces.push_back(fc);
+    m_force_periods.push_back(1);
     fc->setDeltaT(m_deltaT);
     }
 
@@ -74,6 +81,7 @@ void Integrator::setHalfStepHook(std::shared_ptr<HalfStepHook> hook)
 void Integrator::removeForceComputes()
     {
     m_forces.clear();
+    m_force_periods.clear();
     m_constraint_forces.clear();
     }
 
@@ -309,9 +317,16 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    bool concurrent = useConcurrentForces(timestep);
+
+    if (!concurrent)
+        {
+        for (unsigned int i = 0; i < m_forces.size(); i++)
+            {
+            if (isForceActive(i, timestep))
+                m_forces[i]->compute(timestep);
+            }
+        }
 
     if (m_prof)
         {
@@ -341,51 +356,23 @@ void Integrator::computeNetForce(unsigned int timestep)
         external_energy = Scalar(0.0);
 
         // now, add up the net forces
-        // also sum up forces for ghosts, in case they are needed by the communicator
-        unsigned int nparticles = m_pdata->getN()+m_pdata->getNGhosts();
         unsigned int net_virial_pitch = net_virial.getPitch();
 
-        assert(nparticles <= net_force.getNumElements());
-        assert(6*nparticles <= net_virial.getNumElements());
-        assert(nparticles <= net_torque.getNumElements());
-
-        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        #ifdef ENABLE_TBB
+        if (concurrent)
             {
-            GlobalArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
-            GlobalArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
-            GlobalArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
-
-            assert(nparticles <= h_force_array.getNumElements());
-            assert(6*nparticles <= h_virial_array.getNumElements());
-            assert(nparticles <= h_torque_array.getNumElements());
-
-            ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
-            ArrayHandle<Scalar4> h_torque(h_torque_array,access_location::host,access_mode::read);
-
-            unsigned int virial_pitch = h_virial_array.getPitch();
-            for (unsigned int j = 0; j < nparticles; j++)
+            computeConcurrentForces(timestep, h_net_force.data, h_net_virial.data, h_net_torque.data,
+                                    net_virial_pitch, external_virial, external_energy);
+            }
+        else
+        #endif
+            {
+            for (unsigned int i = 0; i < m_forces.size(); i++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
-
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
-
-                for (unsigned int k = 0; k < 6; k++)
-                    {
-                    h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
-                    }
+                if (isForceActive(i, timestep))
+                    addNetForce(i, timestep, h_net_force.data, h_net_virial.data, h_net_torque.data,
+                                net_virial_pitch, external_virial, external_energy);
                 }
-
-            for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_compute)->getExternalVirial(k);
-
-            external_energy += (*force_compute)->getExternalEnergy();
             }
         }
 
@@ -486,6 +473,203 @@ void Integrator::computeNetForce(unsigned int timestep)
         }
     }
 
+/*! \param i Index of the force compute in \a m_forces
+    \param timestep Current time step of the simulation
+    \param h_net_force Net force to add to
+    \param h_net_virial Net virial to add to
+    \param h_net_torque Net torque to add to
+    \param net_virial_pitch Pitch of the net virial array
+    \param external_virial External virial to add to
+    \param external_energy External energy to add to
+
+    Forces are also summed up for ghosts, in case they are needed by the communicator.
+*/
+void Integrator::addNetForce(unsigned int i, unsigned int timestep, Scalar4 *h_net_force, Scalar *h_net_virial,
+                             Scalar4 *h_net_torque, unsigned int net_virial_pitch, Scalar *external_virial,
+                             Scalar& external_energy)
+    {
+    unsigned int nparticles = m_pdata->getN()+m_pdata->getNGhosts();
+
+    assert(nparticles <= m_pdata->getNetForce().getNumElements());
+    assert(6*nparticles <= m_pdata->getNetVirial().getNumElements());
+    assert(nparticles <= m_pdata->getNetTorqueArray().getNumElements());
+
+    // forces and torques of multiple time step force computes are scaled, energies and virials are not
+    Scalar scale = getForceScale(i, timestep);
+    std::shared_ptr<ForceCompute> force_compute = m_forces[i];
+
+    GlobalArray<Scalar4>& h_force_array = force_compute->getForceArray();
+    GlobalArray<Scalar>& h_virial_array = force_compute->getVirialArray();
+    GlobalArray<Scalar4>& h_torque_array = force_compute->getTorqueArray();
+
+    assert(nparticles <= h_force_array.getNumElements());
+    assert(6*nparticles <= h_virial_array.getNumElements());
+    assert(nparticles <= h_torque_array.getNumElements());
+
+    ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
+    ArrayHandle<Scalar4> h_torque(h_torque_array,access_location::host,access_mode::read);
+
+    unsigned int virial_pitch = h_virial_array.getPitch();
+    for (unsigned int j = 0; j < nparticles; j++)
+        {
+        h_net_force[j].x += scale*h_force.data[j].x;
+        h_net_force[j].y += scale*h_force.data[j].y;
+        h_net_force[j].z += scale*h_force.data[j].z;
+        h_net_force[j].w += h_force.data[j].w;
+
+        h_net_torque[j].x += scale*h_torque.data[j].x;
+        h_net_torque[j].y += scale*h_torque.data[j].y;
+        h_net_torque[j].z += scale*h_torque.data[j].z;
+        h_net_torque[j].w += h_torque.data[j].w;
+
+        for (unsigned int k = 0; k < 6; k++)
+            {
+            h_net_virial[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
+            }
+        }
+
+    for (unsigned int k = 0; k < 6; k++)
+        external_virial[k] += force_compute->getExternalVirial(k);
+
+    external_energy += force_compute->getExternalEnergy();
+    }
+
+/*! \param timestep Current time step of the simulation
+    \returns true if computeNetForce() evaluates the active force computes concurrently
+
+    Force computes are evaluated concurrently only on the CPU with more than one TBB thread and without profiling,
+    when there is more than one active force compute and all of them support it.
+*/
+bool Integrator::useConcurrentForces(unsigned int timestep)
+    {
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() <= 1 || m_prof || m_exec_conf->isCUDAEnabled())
+        return false;
+
+    unsigned int n_active = 0;
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (!isForceActive(i, timestep))
+            continue;
+
+        if (!m_forces[i]->isConcurrent())
+            return false;
+
+        n_active++;
+        }
+
+    return n_active > 1;
+    #else
+    return false;
+    #endif
+    }
+
+#ifdef ENABLE_TBB
+/*! \param timestep Current time step of the simulation
+    \param h_net_force Net force to add to
+    \param h_net_virial Net virial to add to
+    \param h_net_torque Net torque to add to
+    \param net_virial_pitch Pitch of the net virial array
+    \param external_virial External virial to add to
+    \param external_energy External energy to add to
+
+    The active force computes and their dependencies are evaluated as a TBB flow graph. The dependencies are computed
+    in a chain, because they may share state (e.g. two neighbor lists that use the same cell list). In MPI
+    simulations, they are computed on the calling thread before the graph starts, because they may communicate.
+    Every force compute is a node that starts as soon as its dependencies are up to date. Its output passes through a
+    sequencer to a serial node that adds the forces to the net force in the order of \a m_forces.
+*/
+void Integrator::computeConcurrentForces(unsigned int timestep, Scalar4 *h_net_force, Scalar *h_net_virial,
+                                         Scalar4 *h_net_torque, unsigned int net_virial_pitch,
+                                         Scalar *external_virial, Scalar& external_energy)
+    {
+    typedef tbb::flow::continue_node<tbb::flow::continue_msg> dependency_node;
+    typedef tbb::flow::continue_node<unsigned int> force_node;
+
+    bool graph_dependencies = true;
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        graph_dependencies = false;
+    #endif
+
+    tbb::flow::graph g;
+    tbb::flow::broadcast_node<tbb::flow::continue_msg> start(g);
+
+    // add the forces to the net force in order
+    std::vector<unsigned int> active;
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (isForceActive(i, timestep))
+            active.push_back(i);
+        }
+
+    tbb::flow::sequencer_node<unsigned int> sequencer(g, [](const unsigned int& cur) { return size_t(cur); });
+    tbb::flow::function_node<unsigned int> sum(g, tbb::flow::serial, [&](const unsigned int& cur)
+        {
+        addNetForce(active[cur], timestep, h_net_force, h_net_virial, h_net_torque, net_virial_pitch,
+                    external_virial, external_energy);
+        return tbb::flow::continue_msg();
+        });
+    tbb::flow::make_edge(sequencer, sum);
+
+    // chain the dependencies in the order in which they are first declared
+    std::map<Compute*, unsigned int> dependency_index;
+    std::vector< std::unique_ptr<dependency_node> > dependencies;
+    std::vector< std::unique_ptr<force_node> > forces;
+
+    for (unsigned int cur = 0; cur < active.size(); cur++)
+        {
+        std::shared_ptr<ForceCompute> force_compute = m_forces[active[cur]];
+        forces.emplace_back(new force_node(g, [force_compute, timestep, cur](const tbb::flow::continue_msg&)
+            {
+            force_compute->compute(timestep);
+            return cur;
+            }));
+
+        bool has_dependency = false;
+        std::vector< std::shared_ptr<Compute> > deps = force_compute->getDependencies();
+        for (auto dep : deps)
+            {
+            if (!graph_dependencies)
+                {
+                // computes are not recomputed in the same time step
+                dep->compute(timestep);
+                continue;
+                }
+
+            auto it = dependency_index.find(dep.get());
+            if (it == dependency_index.end())
+                {
+                dependencies.emplace_back(new dependency_node(g, [dep, timestep](const tbb::flow::continue_msg&)
+                    {
+                    dep->compute(timestep);
+                    return tbb::flow::continue_msg();
+                    }));
+
+                if (dependencies.size() > 1)
+                    tbb::flow::make_edge(*dependencies[dependencies.size()-2], *dependencies.back());
+                else
+                    tbb::flow::make_edge(start, *dependencies.back());
+
+                it = dependency_index.insert(std::make_pair(dep.get(), dependencies.size()-1)).first;
+                }
+
+            tbb::flow::make_edge(*dependencies[it->second], *forces.back());
+            has_dependency = true;
+            }
+
+        if (!has_dependency)
+            tbb::flow::make_edge(start, *forces.back());
+
+        tbb::flow::make_edge(*forces.back(), sequencer);
+        }
+
+    start.try_put(tbb::flow::continue_msg());
+    g.wait_for_all();
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 /*! \param timestep Current time step of the simulation
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and \a m_net_virial
@@ -501,10 +685,16 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
 
     // compute all the normal forces first
 
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    // only sum the force computes evaluated at this time step
+    std::vector<unsigned int> active;
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (isForceActive(i, timestep))
+            {
+            m_forces[i]->compute(timestep);
+            active.push_back(i);
+            }
+        }
 
     if (m_prof)
         {
@@ -541,7 +731,7 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the addition kernel
         // will do that
         // ahh!, but we do need to zer out the net force and virial if there are 0 forces!
-        if (m_forces.size() == 0)
+        if (active.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             cudaMemset(d_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
@@ -554,86 +744,92 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < active.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GlobalArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GlobalArray<Scalar4>& d_force_array0 = m_forces[active[cur_force]]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,access_location::device,access_mode::read);
-            const GlobalArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GlobalArray<Scalar>& d_virial_array0 = m_forces[active[cur_force]]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,access_location::device,access_mode::read);
-            const GlobalArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GlobalArray<Scalar4>& d_torque_array0 = m_forces[active[cur_force]]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,access_location::device,access_mode::read);
             force_list.f0 = d_force0.data;
             force_list.v0 = d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.s0 = getForceScale(active[cur_force], timestep);
 
-            if (cur_force+1 < m_forces.size())
+            if (cur_force+1 < active.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array1 = m_forces[cur_force+1]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array1 = m_forces[active[cur_force+1]]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array1 = m_forces[cur_force+1]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array1 = m_forces[active[cur_force+1]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array1 = m_forces[cur_force+1]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array1 = m_forces[active[cur_force+1]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,access_location::device,access_mode::read);
                 force_list.f1 = d_force1.data;
                 force_list.v1 = d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.s1 = getForceScale(active[cur_force+1], timestep);
                 }
-            if (cur_force+2 < m_forces.size())
+            if (cur_force+2 < active.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array2 = m_forces[cur_force+2]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array2 = m_forces[active[cur_force+2]]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array2 = m_forces[cur_force+2]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array2 = m_forces[active[cur_force+2]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array2 = m_forces[cur_force+2]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array2 = m_forces[active[cur_force+2]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,access_location::device,access_mode::read);
                 force_list.f2 = d_force2.data;
                 force_list.v2 = d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.s2 = getForceScale(active[cur_force+2], timestep);
                 }
-            if (cur_force+3 < m_forces.size())
+            if (cur_force+3 < active.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array3 = m_forces[cur_force+3]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array3 = m_forces[active[cur_force+3]]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array3 = m_forces[cur_force+3]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array3 = m_forces[active[cur_force+3]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array3 = m_forces[cur_force+3]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array3 = m_forces[active[cur_force+3]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,access_location::device,access_mode::read);
                 force_list.f3 = d_force3.data;
                 force_list.v3 = d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.s3 = getForceScale(active[cur_force+3], timestep);
                 }
-            if (cur_force+4 < m_forces.size())
+            if (cur_force+4 < active.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array4 = m_forces[cur_force+4]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array4 = m_forces[active[cur_force+4]]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array4 = m_forces[cur_force+4]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array4 = m_forces[active[cur_force+4]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array4 = m_forces[cur_force+4]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array4 = m_forces[active[cur_force+4]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,access_location::device,access_mode::read);
                 force_list.f4 = d_force4.data;
                 force_list.v4 = d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.s4 = getForceScale(active[cur_force+4], timestep);
                 }
-            if (cur_force+5 < m_forces.size())
+            if (cur_force+5 < active.size())
                 {
-                const GlobalArray<Scalar4>& d_force_array5 = m_forces[cur_force+5]->getForceArray();
+                const GlobalArray<Scalar4>& d_force_array5 = m_forces[active[cur_force+5]]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,access_location::device,access_mode::read);
-                const GlobalArray<Scalar>& d_virial_array5 = m_forces[cur_force+5]->getVirialArray();
+                const GlobalArray<Scalar>& d_virial_array5 = m_forces[active[cur_force+5]]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,access_location::device,access_mode::read);
-                const GlobalArray<Scalar4>& d_torque_array5 = m_forces[cur_force+5]->getTorqueArray();
+                const GlobalArray<Scalar4>& d_torque_array5 = m_forces[active[cur_force+5]]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,access_location::device,access_mode::read);
                 force_list.f5 = d_force5.data;
                 force_list.v5 = d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.s5 = getForceScale(active[cur_force+5], timestep);
                 }
 
             // clear on the first iteration only
@@ -662,11 +858,11 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         }
 
     // add up external virials and energies
-    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force ++)
+    for (unsigned int cur_force = 0; cur_force < active.size(); cur_force ++)
         {
         for (unsigned int k = 0; k < 6; k++)
-            external_virial[k] += m_forces[cur_force]->getExternalVirial(k);
-        external_energy += m_forces[cur_force]->getExternalEnergy();
+            external_virial[k] += m_forces[active[cur_force]]->getExternalVirial(k);
+        external_energy += m_forces[active[cur_force]]->getExternalEnergy();
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -868,6 +1064,67 @@ void Integrator::prepRun(unsigned int timestep)
     {
     }
 
+/*! \param timestep Current time step of the simulation
+    \post All added force computes are computed and totaled up in the net force, virial, and torque arrays
+
+    evaluateForces() gives access to the forces of the current configuration outside of update(), for example when
+    System::replay() evaluates the observables of stored frames.
+*/
+void Integrator::evaluateForces(unsigned int timestep)
+    {
+    // evaluate all forces at full weight, regardless of their multiple time step periods
+    m_split_forces = false;
+    try
+        {
+        #ifdef ENABLE_CUDA
+        if (m_exec_conf->isCUDAEnabled())
+            computeNetForceGPU(timestep);
+        else
+        #endif
+            computeNetForce(timestep);
+        }
+    catch (...)
+        {
+        m_split_forces = true;
+        throw;
+        }
+    m_split_forces = true;
+    }
+
+/*! \param i Index of the force compute in m_forces
+    \param timestep Time step of the net force
+
+    In a multiple time step (impulse r-RESPA) splitting, the forces of a force compute with period p are applied as
+    impulses p times as large on every p-th time step, and not at all in between. The velocity half steps of the
+    integration methods on both sides of that time step then give the outer half kicks of the splitting.
+
+    \returns p on time steps that are multiples of the period p, 0 on all other time steps, and 1 for force computes
+              without a period
+*/
+Scalar Integrator::getForceScale(unsigned int i, unsigned int timestep) const
+    {
+    unsigned int period = m_force_periods[i];
+    if (!m_split_forces || period <= 1)
+        return Scalar(1.0);
+
+    return (timestep % period == 0) ? Scalar(period) : Scalar(0.0);
+    }
+
+/*! \param i Index of the force compute in m_forces
+    \param timestep Time step of the net force
+
+    \returns true if the forces are applied at \a timestep, or if the potential energy or virial is requested
+*/
+bool Integrator::isForceActive(unsigned int i, unsigned int timestep) const
+    {
+    if (getForceScale(i, timestep) != Scalar(0.0))
+        return true;
+
+    PDataFlags flags = m_pdata->getFlags();
+    return flags[pdata_flag::potential_energy] || flags[pdata_flag::isotropic_virial]
+        || flags[pdata_flag::pressure_tensor];
+    }
+
 #ifdef ENABLE_MPI
 /*! \param tstep Time step for which to determine the flags
 
@@ -912,10 +1169,11 @@ void Integrator::setCommunicator(std::shared_ptr<Communicator> comm)
 void Integrator::computeCallback(unsigned int timestep)
     {
     // pre-compute all active forces
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->preCompute(timestep);
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (isForceActive(i, timestep))
+            m_forces[i]->preCompute(timestep);
+        }
     }
 #endif
 
@@ -924,7 +1182,6 @@ bool Integrator::getAnisotropic()
     bool aniso = false;
     // pre-compute all active forces
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
         aniso |= (*force_compute)->isAnisotropic();
 
@@ -43,13 +43,24 @@
     addForceCompute(). Any number of forces can be added in this way.
 
     All forces added via addForceCompute() are computed independently and then totaled up to calculate the net force
-    and energy on each particle. Constraint forces (ForceConstraint) are unique in that they need to be computed
+    and energy on each particle. A force compute with a multiple time step period p > 1 (see
+    IntegratorTwoStep::setRESPAPeriod()) is only evaluated on time steps that are a multiple of p, where its forces and
+    torques are added p times. Its energy and virial are added once, and on the other steps only when the potential
+    energy or virial is requested. Constraint forces (ForceConstraint) are unique in that they need to be computed
     \b after the net forces is already available. To implement this behavior, call addForceConstraint() to add any
     number of constraint forces. All constraint forces will be computed independently and will be able to read the
     current unconstrained net force. Separate constraint forces should not overlap. Degrees of freedom removed
     via the constraint forces can be totaled up with a call to getNDOFRemoved for convenience in derived classes
     implementing correct counting in getNDOF().
 
+    When HOOMD runs on the CPU with more than one TBB thread, the force computes are evaluated concurrently as a
+    task graph. The computes that a force compute declares with ForceCompute::getDependencies() (such as its
+    NeighborList) are brought up to date one after another, and every force compute starts as soon as its
+    dependencies are done. Each force is added to the net force right after it is computed, in the order in which the
+    forces were added, so the result does not depend on the number of threads. The force computes are evaluated in
+    sequence when profiling, or when one of them has not opted in to concurrent evaluation
+    (ForceCompute::isConcurrent()). Currently pair potentials, constant forces and PPPM opt in.
+
     Integrators take "ownership" of the particle's accelerations. Any other updater
     that modifies the particles accelerations will produce undefined results. If
     accelerations are to be modified, they must be done through forces, and added to
@@ -129,6 +140,9 @@ class PYBIND11_EXPORT Integrator : public Updater
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
+        //! Evaluate the net force, virial, and torque without advancing the system
+        void evaluateForces(unsigned int timestep);
+
         #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -146,14 +160,36 @@ class PYBIND11_EXPORT Integrator : public Updater
         std::vector< std::shared_ptr<ForceConstraint> > m_constraint_forces;    //!< List of all the constraints
 
         std::shared_ptr<HalfStepHook> m_half_step_hook;    //!< The HalfStepHook, if active
+        std::vector<unsigned int> m_force_periods;                  //!< Multiple time step period of each force compute
 
 
         //! helper function to compute initial accelerations
         void computeAccelerations(unsigned int timestep);
 
+        //! Get the factor applied to the forces and torques of a force compute at a time step
+        Scalar getForceScale(unsigned int i, unsigned int timestep) const;
+
+        //! Test if a force compute is evaluated at a time step
+        bool isForceActive(unsigned int i, unsigned int timestep) const;
+
         //! helper function to compute net force/virial
         void computeNetForce(unsigned int timestep);
 
+        //! Add the force, virial, and torque of a force compute to the net force
+        void addNetForce(unsigned int i, unsigned int timestep, Scalar4 *h_net_force, Scalar *h_net_virial,
+                         Scalar4 *h_net_torque, unsigned int net_virial_pitch, Scalar *external_virial,
+                         Scalar& external_energy);
+
+        //! Test if the force computes are evaluated concurrently at a time step
+        bool useConcurrentForces(unsigned int timestep);
+
+        #ifdef ENABLE_TBB
+        //! Compute the forces concurrently and add them to the net force as they complete
+        void computeConcurrentForces(unsigned int timestep, Scalar4 *h_net_force, Scalar *h_net_virial,
+                                     Scalar4 *h_net_torque, unsigned int net_virial_pitch, Scalar *external_virial,
+                                     Scalar& external_energy);
+        #endif
+
 #ifdef ENABLE_CUDA
         //! helper function to compute net force/virial on the GPU
         void computeNetForceGPU(unsigned int timestep);
@@ -168,6 +204,7 @@ class PYBIND11_EXPORT Integrator : public Updater
         bool getAnisotropic();
 
     private:
+        bool m_split_forces = true;                 //!< False while all forces are evaluated at full weight
         #ifdef ENABLE_MPI
         bool m_request_flags_connected = false;     //!< Connection to Communicator to request communication flags
         bool m_signals_connected = false;                           //!< Track if we have already connected signals
@@ -12,18 +12,25 @@
 #include "Communicator.h"
 #endif
 
+#include <stdexcept>
+
 namespace py = pybind11;
 
 using namespace std;
 
 /*! \param sysdef Specified for LogMatrix, but not used directly by Logger
-  \param python_analyze Python object, which gets called at the end of LogHDF5::analyze(). Accepts the timestep as argument and returns the timestep.
+  \param python_analyze Python object, which gets called by LogHDF5::flush(). Accepts the timestep as argument and returns the timestep.
   Should obtain the prepared data and writes it via h5py to the file.
 */
 LogHDF5::LogHDF5(std::shared_ptr<SystemDefinition> sysdef,
                  pybind11::function python_analyze)
     : LogMatrix(sysdef),
-      m_python_analyze(python_analyze)
+      m_python_analyze(python_analyze),
+      m_buffer_size(1),
+      m_flush_period(0),
+      m_n_buffered(0),
+      m_first_buffered_tstep(0),
+      m_last_buffered_tstep(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LogHDF5: "  << endl;
     }
@@ -42,38 +49,159 @@ void LogHDF5::analyze(unsigned int timestep)
 
     if (m_prof) m_prof->push("LogHDF5");
 
-    //Prepare the non-matrix data
-    auto numpy_array_buf = m_quantities_array.request();
-    assert( numpy_array_buf.shape[0] == m_logged_quantities.size());
-    assert( numpy_array_buf.itemsize == sizeof(Scalar));
-    Scalar*const numpy_array_data = static_cast<Scalar*>(numpy_array_buf.ptr);
-    //Prepare non-matrix data in a single array.
-    for(unsigned int i=0; i < m_logged_quantities.size(); i++)
+    if (m_n_buffered == 0)
+        m_first_buffered_tstep = timestep;
+    m_last_buffered_tstep = timestep;
+
+    //Append the non-matrix data as a new row.
+    unsigned int n_quantities = m_logged_quantities.size();
+    m_quantities_buffer.resize((m_n_buffered + 1) * n_quantities);
+    Scalar *row = m_quantities_buffer.data() + m_n_buffered * n_quantities;
+    for(unsigned int i=0; i < n_quantities; i++)
+        {
+        row[i] = this->getQuantity(m_logged_quantities[i],timestep,true);
+        }
+
+    //Append the matrix data, only the root rank obtains valid matrices.
+    if (m_exec_conf->isRoot())
         {
-        numpy_array_data[i] = this->getQuantity(m_logged_quantities[i],timestep,true);
+        for(unsigned int i=0; i < m_logged_matrix_quantities.size(); i++)
+            bufferMatrix(i);
         }
 
-    //Call the python function, which manages the prepared data and writes it to disk.
-    m_python_analyze(timestep);
+    m_n_buffered++;
 
     if (m_prof) m_prof->pop();
+
+    //Call the python function, which writes the buffered data to disk.
+    if (m_n_buffered >= m_buffer_size || (m_flush_period > 0 && timestep - m_first_buffered_tstep >= m_flush_period))
+        flush();
+    }
+
+/*! \param i Index of the matrix quantity
+
+    Copy the cached matrix of quantity \a i to the end of its buffer. All matrices of a quantity must have the same
+    shape and data type.
+*/
+void LogHDF5::bufferMatrix(unsigned int i)
+    {
+    const std::string& quantity = m_logged_matrix_quantities[i];
+    py::array matrix = py::array::ensure(m_cached_matrix_quantities[i], py::array::c_style);
+    if (!matrix || matrix.ndim() == 0)
+        {
+        m_exec_conf->msg->error() << "For quantity " << quantity << " no matrix obtainable." << endl;
+        throw runtime_error("Error writing matrix quantity " + quantity);
+        }
+
+    std::vector<ssize_t> shape(matrix.shape(), matrix.shape() + matrix.ndim());
+    matrix_buffer& buffer = m_matrix_buffers[i];
+    if (m_n_buffered == 0)
+        {
+        buffer.shape = shape;
+        buffer.dtype = matrix.dtype();
+        }
+    else if (shape != buffer.shape || matrix.itemsize() != buffer.dtype.itemsize()
+             || matrix.dtype().kind() != buffer.dtype.kind())
+        {
+        m_exec_conf->msg->error() << "Trying to log matrix " << quantity
+                                  << ", but its dimensions or type changed during the run." << endl;
+        throw runtime_error("Error writing matrix quantity " + quantity);
+        }
+
+    const char *data = static_cast<const char*>(matrix.data());
+    buffer.data.insert(buffer.data.end(), data, data + matrix.nbytes());
+    }
+
+/*! Call the python function to write all buffered log steps to the file and clear the buffers. The buffers keep their
+    memory, so that the following log steps do not allocate.
+*/
+void LogHDF5::flush()
+    {
+    if (m_n_buffered == 0)
+        return;
+
+    m_python_analyze(m_last_buffered_tstep);
+
+    m_n_buffered = 0;
+    m_quantities_buffer.clear();
+    for (unsigned int i = 0; i < m_matrix_buffers.size(); i++)
+        m_matrix_buffers[i].data.clear();
+    }
+
+/*! \param buffer_size Number of log steps to buffer
+
+    Buffered log steps are written first.
+*/
+void LogHDF5::setBufferSize(unsigned int buffer_size)
+    {
+    flush();
+    m_buffer_size = buffer_size > 0 ? buffer_size : 1;
+    m_quantities_buffer.reserve(m_buffer_size * m_logged_quantities.size());
     }
 
 /*! \param quantities A list of quantities to log
+
+    Buffered log steps are written first.
 */
 void LogHDF5::setLoggedQuantities(const std::vector< std::string >& quantities)
     {
+    flush();
     Logger::setLoggedQuantities(quantities);
+    m_quantities_buffer.reserve(m_buffer_size * quantities.size());
+    }
+
+/*! \param quantities A list of matrix quantities to log
+
+    Buffered log steps are written first.
+*/
+void LogHDF5::setLoggedMatrixQuantities(const std::vector< std::string >& quantities)
+    {
+    flush();
+    LogMatrix::setLoggedMatrixQuantities(quantities);
+    m_matrix_buffers.clear();
+    m_matrix_buffers.resize(quantities.size());
+    }
+
+/*! \returns A (number of buffered log steps) x (number of quantities) array
+*/
+py::array LogHDF5::getQuantitiesArray(void)
+    {
+    std::vector<ssize_t> shape = {ssize_t(m_n_buffered), ssize_t(m_logged_quantities.size())};
+    return py::array_t<Scalar>(shape, m_quantities_buffer.data());
+    }
+
+/*! \param quantity Name of the matrix quantity
+    \returns An array with the buffered matrices stacked along the first dimension on the root rank, None on the
+        other ranks
+*/
+py::object LogHDF5::getBufferedMatrix(const std::string& quantity)
+    {
+    if (!m_exec_conf->isRoot())
+        return py::none();
+
+    for(unsigned int i=0; i < m_logged_matrix_quantities.size(); i++)
+        {
+        if (m_logged_matrix_quantities[i] == quantity)
+            {
+            const matrix_buffer& buffer = m_matrix_buffers[i];
+            std::vector<ssize_t> shape(1, ssize_t(m_n_buffered));
+            shape.insert(shape.end(), buffer.shape.begin(), buffer.shape.end());
+            return py::array(buffer.dtype, shape, buffer.data.data());
+            }
+        }
 
-    m_holder_array.resize(quantities.size());
-    //Create a new numpy array of the correct size.
-    m_quantities_array = py::array(quantities.size(),m_holder_array.data());
+    m_exec_conf->msg->error() << "Matrix quantity " << quantity << " unknow to analyzer Unable to return."<<endl;
+    throw runtime_error("Error writing matrix quantity " + quantity);
     }
 
 void export_LogHDF5(py::module& m)
     {
     py::class_<LogHDF5, std::shared_ptr<LogHDF5> >(m,"LogHDF5", py::base<LogMatrix>())
         .def(py::init< std::shared_ptr<SystemDefinition>, pybind11::function >())
-        .def("get_quantity_array",&LogHDF5::getQuantitiesArray,py::return_value_policy::copy)
+        .def("get_quantity_array",&LogHDF5::getQuantitiesArray)
+        .def("getBufferedMatrix",&LogHDF5::getBufferedMatrix)
+        .def("setBufferSize",&LogHDF5::setBufferSize)
+        .def("setFlushPeriod",&LogHDF5::setFlushPeriod)
+        .def("flush",&LogHDF5::flush)
         ;
     }
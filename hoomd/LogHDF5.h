@@ -20,6 +20,16 @@
   Logger. This class offers access to single value variables and
   matrix quantities.
 
+  The logged values are collected in buffers that hold one block per log step for the non-matrix quantities and one
+  block per matrix quantity, so that logging a step only copies the values. The python function that writes the
+  data to the file is called once per flush() with all buffered steps. The buffers are flushed when they hold
+  \a buffer_size steps, when \a flush_period time steps have passed since the first buffered step, and when the
+  logged quantities change.
+
+  The non-matrix buffer is row major, one row per log step, rather than one column per quantity. The hdf5 dataset
+  stores one row per log step, so a flush writes the buffer as one contiguous block without transposing it, and each
+  log step fills a contiguous row.
+
     \ingroup analyzers
 */
 class LogHDF5 : public LogMatrix
@@ -38,16 +48,48 @@ class LogHDF5 : public LogMatrix
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
-        //! Get numpy array containing all logged non-matrix quantities.
-        pybind11::array getQuantitiesArray(void){return m_quantities_array;}
+        //! Selects which matrix quantities to log
+        virtual void setLoggedMatrixQuantities(const std::vector< std::string >& quantities);
+
+        //! Set the number of log steps to buffer before writing
+        void setBufferSize(unsigned int buffer_size);
+
+        //! Set the maximum number of time steps between writes (0 for no limit)
+        void setFlushPeriod(unsigned int flush_period)
+            {
+            m_flush_period = flush_period;
+            }
+
+        //! Write out all buffered log steps
+        void flush();
+
+        //! Get numpy array containing the buffered non-matrix quantities, one row per log step.
+        pybind11::array getQuantitiesArray(void);
+
+        //! Get numpy array containing the buffered values of a matrix quantity, one matrix per log step.
+        pybind11::object getBufferedMatrix(const std::string& quantity);
 
     private:
+        //! Buffered values of one matrix quantity
+        struct matrix_buffer
+            {
+            std::vector<char> data;             //!< Matrices of the buffered log steps, one after another
+            std::vector<ssize_t> shape;         //!< Shape of one matrix
+            pybind11::dtype dtype;              //!< Data type of the matrix elements
+            };
+
         //! python function, which is called to write the data to disk.
         pybind11::function m_python_analyze;
-        //! python numpy array for all non-matrix quantities.
-        pybind11::array m_quantities_array;
-        //! memory space of the numpy array m_quantities_array
-        std::vector<Scalar> m_holder_array;
+        unsigned int m_buffer_size;                     //!< Number of log steps to buffer before writing
+        unsigned int m_flush_period;                    //!< Maximum number of time steps between writes (0 for no limit)
+        unsigned int m_n_buffered;                      //!< Number of buffered log steps
+        unsigned int m_first_buffered_tstep;            //!< Time step of the first buffered log step
+        unsigned int m_last_buffered_tstep;             //!< Time step of the last buffered log step
+        std::vector<Scalar> m_quantities_buffer;        //!< Buffered non-matrix quantities, one row per log step
+        std::vector<matrix_buffer> m_matrix_buffers;    //!< Buffered matrix quantities
+
+        //! Append the cached value of a matrix quantity to its buffer
+        void bufferMatrix(unsigned int i);
     };
 
 //! exports the LogHDF5 class to python
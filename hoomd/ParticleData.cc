@@ -27,6 +27,7 @@
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
@@ -119,6 +120,9 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
 
     m_external_energy = Scalar(0.0);
 
+    // computes called outside of a run compute the potential energy, System::run() sets the flags per step
+    m_flags[pdata_flag::potential_energy] = 1;
+
     // zero the origin
     m_origin = make_scalar3(0,0,0);
     m_o_image = make_int3(0,0,0);
@@ -137,12 +141,18 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
  * \param global_box The dimensions of the global simulation box
  * \param exec_conf The execution configuration
  * \param decomposition (optional) Domain decomposition layout
+ * \param distributed True if every rank holds a slice of the particles (see initializeFromDistributedSnapshot())
+ * \param tags (distributed only) Tags of the particles in the slice, empty to number them by slice
+ * \param local (distributed only) True if every rank holds exactly the particles of its own domain
  */
 template <class Real>
 ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            const BoxDim& global_box,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                           std::shared_ptr<DomainDecomposition> decomposition
+                           std::shared_ptr<DomainDecomposition> decomposition,
+                           bool distributed,
+                           const std::vector<unsigned int>& tags,
+                           bool local
                           )
     : m_exec_conf(exec_conf),
       m_nparticles(0),
@@ -164,7 +174,7 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     setGlobalBox(global_box);
 
     // it is an error for particles to be initialized outside of their box
-    if (!inBox(snapshot))
+    if (!inBox(snapshot, distributed))
         {
         m_exec_conf->msg->warning() << "Not all particles were found inside the given box" << endl;
         throw runtime_error("Error initializing ParticleData");
@@ -183,7 +193,12 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     TAG_ALLOCATION(m_rtag);
 
     // initialize particle data with snapshot contents
-    initializeFromSnapshot(snapshot);
+    #ifdef ENABLE_MPI
+    if (distributed && m_decomposition)
+        initializeFromDistributedSnapshot(snapshot, tags, local);
+    else
+    #endif
+        initializeFromSnapshot(snapshot);
 
     // reset external virial
     for (unsigned int i = 0; i < 6; i++)
@@ -191,6 +206,9 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
 
     m_external_energy = Scalar(0.0);
 
+    // computes called outside of a run compute the potential energy, System::run() sets the flags per step
+    m_flags[pdata_flag::potential_energy] = 1;
+
     // default constructed shared ptr is null as desired
     m_prof = std::shared_ptr<Profiler>();
 
@@ -780,12 +798,14 @@ void ParticleData::maybe_rebuild_tag_cache()
     }
 
 /*! \return true If and only if all particles are in the simulation box
+    \param snap Snapshot to check
+    \param distributed True if every rank holds a slice of the particles
 */
 template <class Real>
-bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
+bool ParticleData::inBox(const SnapshotParticleData<Real> &snap, bool distributed)
     {
     bool in_box = true;
-    if (m_exec_conf->getRank() == 0)
+    if (distributed || m_exec_conf->getRank() == 0)
         {
         Scalar3 lo = m_global_box.getLo();
         Scalar3 hi = m_global_box.getHi();
@@ -809,7 +829,14 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
             }
         }
     #ifdef ENABLE_MPI
-    if (m_decomposition)
+    if (m_decomposition && distributed)
+        {
+        int local_in_box = in_box;
+        int all_in_box = 0;
+        MPI_Allreduce(&local_in_box, &all_in_box, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+        in_box = all_in_box;
+        }
+    else if (m_decomposition)
         {
         bcast(in_box, 0, m_exec_conf->getMPICommunicator());
         }
@@ -817,6 +844,33 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
     return in_box;
     }
 
+#ifdef ENABLE_MPI
+//! Pack one field of a snapshot in the order of the destination ranks and scatter it from the root
+/*! \param send_idx (root only) Snapshot indices, ordered by destination rank
+    \param N_proc (root only) Number of particles for every rank
+    \param get Returns the field value of a snapshot index
+    \param out Values received by this rank
+    \param root Rank that scatters the data
+    \param mpi_comm The MPI communicator
+
+    Only one field is packed at a time, so the root needs temporary memory for a single array.
+*/
+template<typename T, typename F>
+static void scatter_snapshot_field(const std::vector<unsigned int>& send_idx,
+    const std::vector<unsigned int>& N_proc,
+    F get,
+    std::vector<T>& out,
+    unsigned int root,
+    const MPI_Comm mpi_comm)
+    {
+    std::vector<T> buf(send_idx.size());
+    for (unsigned int i = 0; i < send_idx.size(); i++)
+        buf[i] = get(send_idx[i]);
+
+    scatter_array(buf.data(), N_proc, out, root, mpi_comm);
+    }
+#endif
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
     \param ignore_bodies If True, ignore particles that have a body flag set
@@ -857,42 +911,15 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // gather box information from all processors
         unsigned int root = 0;
 
-        // Define per-processor particle data
-        std::vector< std::vector<Scalar3> > pos_proc;              // Position array of every processor
-        std::vector< std::vector<Scalar3> > vel_proc;              // Velocities array of every processor
-        std::vector< std::vector<Scalar3> > accel_proc;            // Accelerations array of every processor
-        std::vector< std::vector<unsigned int> > type_proc;        // Particle types array of every processor
-        std::vector< std::vector<Scalar > > mass_proc;             // Particle masses array of every processor
-        std::vector< std::vector<Scalar > > charge_proc;           // Particle charges array of every processor
-        std::vector< std::vector<Scalar > > diameter_proc;         // Particle diameters array of every processor
-        std::vector< std::vector<int3 > > image_proc;              // Particle images array of every processor
-        std::vector< std::vector<unsigned int > > body_proc;       // Body ids of every processor
-        std::vector< std::vector<Scalar4> > orientation_proc;      // Orientations of every processor
-        std::vector< std::vector<Scalar4> > angmom_proc;           // Angular momenta of every processor
-        std::vector< std::vector<Scalar3> > inertia_proc;           // Angular momenta of every processor
-        std::vector< std::vector<unsigned int > > tag_proc;         // Global tags of every processor
-        std::vector< unsigned int > N_proc;                        // Number of particles on every processor
-
-
-        // resize to number of ranks in communicator
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
         unsigned int size = m_exec_conf->getNRanks();
         unsigned int my_rank = m_exec_conf->getRank();
 
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        tag_proc.resize(size);
-        N_proc.resize(size,0);
+        std::vector< unsigned int > N_proc(size,0);                // Number of particles on every processor
+        std::vector< unsigned int > send_idx;                      // Snapshot indices, ordered by destination rank
+        std::vector< unsigned int > snap_tag;                      // Tag of every snapshot particle
+        std::vector< Scalar3 > snap_pos;                           // Wrapped positions of snapshot particles
+        std::vector< int3 > snap_image;                            // Images of snapshot particles
 
         if (my_rank == 0)
             {
@@ -905,16 +932,14 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-
-            BoxDim global_box = m_global_box;
+            std::vector< unsigned int > snap_rank(snapshot.size, size);
+            snap_tag.resize(snapshot.size);
+            snap_pos.resize(snapshot.size);
+            snap_image.resize(snapshot.size);
 
             // loop over particles in snapshot, place them into domains
-            for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
                 {
-                unsigned int snap_idx = it - snapshot.pos.begin();
-
                 // if requested, do not initialize constituent particles of bodies
                 if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY)
                     {
@@ -922,76 +947,24 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                     }
 
                 // determine domain the particle is placed into
-                Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= f.x * ((Scalar)di.getW());
-                int j= f.y * ((Scalar)di.getH());
-                int k= f.z * ((Scalar)di.getD());
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
-                int3 img = snapshot.image[snap_idx];
+                snap_pos[snap_idx] = vec_to_scalar3(snapshot.pos[snap_idx]);
+                snap_image[snap_idx] = snapshot.image[snap_idx];
+                unsigned int rank = placeSnapshotParticle(snap_pos[snap_idx], snap_image[snap_idx], h_cart_ranks.data, snap_idx);
 
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
-
-                if (rank >= n_ranks)
-                    {
-                    m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
-                    }
-
-                // fill up per-processor data structures
-                pos_proc[rank].push_back(pos);
-                image_proc[rank].push_back(img);
-                vel_proc[rank].push_back(vec_to_scalar3(snapshot.vel[snap_idx]));
-                accel_proc[rank].push_back(vec_to_scalar3(snapshot.accel[snap_idx]));
-                type_proc[rank].push_back(snapshot.type[snap_idx]);
-                mass_proc[rank].push_back(snapshot.mass[snap_idx]);
-                charge_proc[rank].push_back(snapshot.charge[snap_idx]);
-                diameter_proc[rank].push_back(snapshot.diameter[snap_idx]);
-                body_proc[rank].push_back(snapshot.body[snap_idx]);
-                orientation_proc[rank].push_back(quat_to_scalar4(snapshot.orientation[snap_idx]));
-                angmom_proc[rank].push_back(quat_to_scalar4(snapshot.angmom[snap_idx]));
-                inertia_proc[rank].push_back(vec_to_scalar3(snapshot.inertia[snap_idx]));
-                tag_proc[rank].push_back(nglobal++);
+                snap_rank[snap_idx] = rank;
+                snap_tag[snap_idx] = nglobal++;
                 N_proc[rank]++;
                 }
 
+            // order the snapshot indices by destination rank
+            std::vector< unsigned int > offset(size, 0);
+            for (unsigned int rank = 1; rank < size; rank++)
+                offset[rank] = offset[rank-1] + N_proc[rank-1];
+
+            send_idx.resize(nglobal);
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+                if (snap_rank[snap_idx] < size)
+                    send_idx[offset[snap_rank[snap_idx]]++] = snap_idx;
             }
 
         // get type mapping
@@ -1026,23 +999,23 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         std::vector<Scalar3> inertia;
         std::vector<unsigned int> tag;
 
-        // distribute particle data
-        scatter_v(pos_proc,pos,root, mpi_comm);
-        scatter_v(vel_proc,vel,root, mpi_comm);
-        scatter_v(accel_proc, accel, root, mpi_comm);
-        scatter_v(type_proc, type, root, mpi_comm);
-        scatter_v(mass_proc, mass, root, mpi_comm);
-        scatter_v(charge_proc, charge, root, mpi_comm);
-        scatter_v(diameter_proc, diameter, root, mpi_comm);
-        scatter_v(image_proc, image, root, mpi_comm);
-        scatter_v(body_proc, body, root, mpi_comm);
-        scatter_v(orientation_proc, orientation, root, mpi_comm);
-        scatter_v(angmom_proc, angmom, root, mpi_comm);
-        scatter_v(inertia_proc, inertia, root, mpi_comm);
-        scatter_v(tag_proc, tag, root, mpi_comm);
-
-        // distribute number of particles
-        scatter_v(N_proc, m_nparticles, root, mpi_comm);
+        // distribute particle data, one field at a time
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return snap_pos[i]; }, pos, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return vec_to_scalar3(snapshot.vel[i]); }, vel, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return vec_to_scalar3(snapshot.accel[i]); }, accel, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return snapshot.type[i]; }, type, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return Scalar(snapshot.mass[i]); }, mass, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return Scalar(snapshot.charge[i]); }, charge, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return Scalar(snapshot.diameter[i]); }, diameter, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return snap_image[i]; }, image, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return snapshot.body[i]; }, body, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return quat_to_scalar4(snapshot.orientation[i]); }, orientation, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return quat_to_scalar4(snapshot.angmom[i]); }, angmom, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return vec_to_scalar3(snapshot.inertia[i]); }, inertia, root, mpi_comm);
+        scatter_snapshot_field(send_idx, N_proc, [&](unsigned int i) { return snap_tag[i]; }, tag, root, mpi_comm);
+
+        // number of local particles
+        m_nparticles = tag.size();
 
 
             {
@@ -1193,6 +1166,393 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle (wrapped into the box on output if it lies on a periodic boundary)
+    \param img Image of the particle (updated on output)
+    \param cart_ranks Cartesian rank lookup table of the domain decomposition
+    \param snap_idx Index of the particle in the snapshot, for error messages
+    \returns the rank of the domain the particle is placed into
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos, int3& img, const unsigned int *cart_ranks, unsigned int snap_idx)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    BoxDim global_box = m_global_box;
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i= f.x * ((Scalar)di.getW());
+    int j= f.y * ((Scalar)di.getH());
+    int k= f.z * ((Scalar)di.getD());
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int) di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int) di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+
+    if (rank >= m_exec_conf->getNRanks())
+        {
+        m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
+        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    return rank;
+    }
+
+//! Particle record sent to the owning rank during distributed initialization
+struct snapshot_particle_t
+    {
+    Scalar4 postype;        //!< Position and type
+    Scalar4 velmass;        //!< Velocity and mass
+    Scalar3 accel;          //!< Acceleration
+    Scalar charge;          //!< Charge
+    Scalar diameter;        //!< Diameter
+    int3 image;             //!< Image flags
+    unsigned int body;      //!< Body id
+    Scalar4 orientation;    //!< Orientation
+    Scalar4 angmom;         //!< Angular momentum
+    Scalar3 inertia;        //!< Principal moments of inertia
+    unsigned int tag;       //!< Global tag
+    };
+
+/*! \param snapshot Slice of the particles read by this rank
+    \param tags Tags of the particles in the slice, empty to number them by slice
+    \param local True if every rank holds exactly the particles of its own domain
+
+    Every rank holds a different, contiguous slice of the global particle list (see GSDReader). Tags are
+    assigned in order of increasing rank, so the result is identical to initializeFromSnapshot() with the
+    concatenated snapshot. Each rank places the particles of its slice into domains and sends them directly
+    to their owners with exchange_v(), so that the full system is never held by any single rank.
+
+    When any rank passes explicit \a tags (see CheckpointReader), all ranks must pass one tag per particle of
+    their slice. The tags are kept as given, and unused tags below the maximum tag are recycled. With \a local,
+    the particles stay on the rank that holds them and are not placed into domains.
+
+    \pre The type mapping is identical on all ranks.
+*/
+template <class Real>
+void ParticleData::initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                                     const std::vector<unsigned int>& tags,
+                                                     bool local)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from distributed snapshot" << std::endl;
+
+    assert(m_decomposition);
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // every rank checks its own slice
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    if (snapshot.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int size = m_exec_conf->getNRanks();
+
+    unsigned int n_slice = snapshot.size;
+
+    int explicit_tags = ! tags.empty();
+    MPI_Allreduce(MPI_IN_PLACE, &explicit_tags, 1, MPI_INT, MPI_LOR, mpi_comm);
+
+    // the first tag of this slice is the number of particles on all lower ranks
+    unsigned int tag_offset = 0;
+    unsigned int nglobal = 0;
+    std::vector<unsigned int> all_tags;
+    if (explicit_tags)
+        {
+        if (tags.size() != n_slice)
+            {
+            m_exec_conf->msg->error() << "init.*: Number of tags does not match the number of particles." << std::endl;
+            throw std::runtime_error("Error initializing ParticleData");
+            }
+
+        std::vector<unsigned int> counts;
+        all_gather_array(tags.data(), n_slice, all_tags, counts, mpi_comm);
+        std::sort(all_tags.begin(), all_tags.end());
+        if (std::adjacent_find(all_tags.begin(), all_tags.end()) != all_tags.end())
+            {
+            m_exec_conf->msg->error() << "init.*: Duplicate particle tags." << std::endl;
+            throw std::runtime_error("Error initializing ParticleData");
+            }
+        nglobal = all_tags.size();
+        }
+    else
+        {
+        MPI_Exscan(&n_slice, &tag_offset, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        if (m_exec_conf->getRank() == 0)
+            tag_offset = 0;
+
+        MPI_Allreduce(&n_slice, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        }
+
+    // place particles into domains
+    std::vector< std::vector<snapshot_particle_t> > send_particles(size);
+
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+        for (unsigned int snap_idx = 0; snap_idx < n_slice; ++snap_idx)
+            {
+            unsigned int tag = explicit_tags ? tags[snap_idx] : tag_offset + snap_idx;
+            Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+            int3 img = snapshot.image[snap_idx];
+            unsigned int rank = local ? m_exec_conf->getRank()
+                : placeSnapshotParticle(pos, img, h_cart_ranks.data, tag);
+
+            snapshot_particle_t p;
+            p.postype = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(snapshot.type[snap_idx]));
+            p.velmass = make_scalar4(snapshot.vel[snap_idx].x,
+                                     snapshot.vel[snap_idx].y,
+                                     snapshot.vel[snap_idx].z,
+                                     snapshot.mass[snap_idx]);
+            p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+            p.charge = snapshot.charge[snap_idx];
+            p.diameter = snapshot.diameter[snap_idx];
+            p.image = img;
+            p.body = snapshot.body[snap_idx];
+            p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+            p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+            p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+            p.tag = tag;
+            send_particles[rank].push_back(p);
+            }
+        }
+
+    // send particles to their owners
+    std::vector<snapshot_particle_t> particles;
+    exchange_v(send_particles, particles, mpi_comm);
+    send_particles.clear();
+
+    m_type_mapping = snapshot.type_mapping;
+    m_nparticles = particles.size();
+
+    // resize array for reverse-lookup tags
+    unsigned int n_tags = (explicit_tags && nglobal) ? all_tags.back() + 1 : nglobal;
+    m_rtag.resize(n_tags);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < n_tags; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    if (explicit_tags)
+        {
+        m_tag_set.insert(all_tags.begin(), all_tags.end());
+
+        // unused tags below the maximum tag are recycled, like the tags of removed particles
+        for (unsigned int tag = 0; tag < n_tags; tag++)
+            if (! m_tag_set.count(tag))
+                m_recycled_tags.push(tag);
+        }
+    else
+        {
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            {
+            m_tag_set.insert(tag);
+            }
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    resize(m_nparticles);
+
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            const snapshot_particle_t& p = particles[idx];
+            h_pos.data[idx] = p.postype;
+            h_vel.data[idx] = p.velmass;
+            h_accel.data[idx] = p.accel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_tag.data[idx] = p.tag;
+            h_rtag.data[p.tag] = idx;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = snapshot.is_accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+#endif
+
+//! Update the particles in place from a snapshot
+/*! \param snapshot Snapshot of the same particles, in tag order
+    \returns true if the particle data was updated, false if it has to be reinitialized with initializeFromSnapshot()
+
+    Unlike initializeFromSnapshot(), updateFromSnapshot() overwrites the properties of the existing particles without
+    reallocating the arrays or resorting the particles. The particle sort signal is only emitted when a type or body
+    changes, so neighbor lists keep their last build and decide with their usual distance check whether a rebuild is
+    needed. This allows a trajectory to be streamed through the particle data frame by frame.
+
+    The in-place update is only possible when the snapshot has the same number of particles and the same types as the
+    particle data, the tags are contiguous, and there is no domain decomposition. Otherwise, nothing is changed and
+    false is returned.
+*/
+template <class Real>
+bool ParticleData::updateFromSnapshot(const SnapshotParticleData<Real>& snapshot)
+    {
+    #ifdef ENABLE_MPI
+    if (m_decomposition)
+        return false;
+    #endif
+
+    if (snapshot.size != getNGlobal() || getRTags().size() != getNGlobal() || snapshot.type_mapping != m_type_mapping)
+        return false;
+
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    m_exec_conf->msg->notice(7) << "ParticleData: updating from snapshot" << std::endl;
+
+    bool sort = false;
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::readwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::readwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::read);
+
+        for (unsigned int tag = 0; tag < snapshot.size; tag++)
+            {
+            unsigned int idx = h_rtag.data[tag];
+            assert(idx < getN());
+
+            unsigned int type = snapshot.type[tag];
+            if (__scalar_as_int(h_pos.data[idx].w) != (int)type || h_body.data[idx] != snapshot.body[tag])
+                sort = true;
+
+            h_pos.data[idx] = make_scalar4(snapshot.pos[tag].x,
+                                           snapshot.pos[tag].y,
+                                           snapshot.pos[tag].z,
+                                           __int_as_scalar(type));
+            h_vel.data[idx] = make_scalar4(snapshot.vel[tag].x,
+                                           snapshot.vel[tag].y,
+                                           snapshot.vel[tag].z,
+                                           snapshot.mass[tag]);
+            h_accel.data[idx] = vec_to_scalar3(snapshot.accel[tag]);
+            h_charge.data[idx] = snapshot.charge[tag];
+            h_diameter.data[idx] = snapshot.diameter[tag];
+            h_image.data[idx] = snapshot.image[tag];
+            h_body.data[idx] = snapshot.body[tag];
+            h_orientation.data[idx] = quat_to_scalar4(snapshot.orientation[tag]);
+            h_angmom.data[idx] = quat_to_scalar4(snapshot.angmom[tag]);
+            h_inertia.data[idx] = vec_to_scalar3(snapshot.inertia[tag]);
+            }
+        }
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = snapshot.is_accel_set;
+
+    // zero the origin, as initializeFromSnapshot() does
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // types and bodies determine neighbor list exclusions and rigid body data
+    if (sort)
+        notifyParticleSort();
+
+    return true;
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -1223,158 +1583,154 @@ std::map<unsigned int, unsigned int> ParticleData::takeSnapshot(SnapshotParticle
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        // gather a global snapshot
-        std::vector<Scalar3> pos(m_nparticles);
-        std::vector<Scalar3> vel(m_nparticles);
-        std::vector<Scalar3> accel(m_nparticles);
-        std::vector<unsigned int> type(m_nparticles);
-        std::vector<Scalar> mass(m_nparticles);
-        std::vector<Scalar> charge(m_nparticles);
-        std::vector<Scalar> diameter(m_nparticles);
-        std::vector<int3> image(m_nparticles);
-        std::vector<unsigned int> body(m_nparticles);
-        std::vector<Scalar4> orientation(m_nparticles);
-        std::vector<Scalar4> angmom(m_nparticles);
-        std::vector<Scalar3> inertia(m_nparticles);
-        std::vector<unsigned int> tag(m_nparticles);
-        std::map<unsigned int, unsigned int> rtag_map;
-        for (unsigned int idx = 0; idx < m_nparticles; idx++)
-            {
-            pos[idx] = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
-            vel[idx] = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
-            accel[idx] = h_accel.data[idx];
-            type[idx] = __scalar_as_int(h_pos.data[idx].w);
-            mass[idx] = h_vel.data[idx].w;
-            charge[idx] = h_charge.data[idx];
-            diameter[idx] = h_diameter.data[idx];
-            image[idx] = h_image.data[idx];
-            image[idx].x -= m_o_image.x;
-            image[idx].y -= m_o_image.y;
-            image[idx].z -= m_o_image.z;
-            body[idx] = h_body.data[idx];
-            orientation[idx] = h_orientation.data[idx];
-            angmom[idx] = h_angmom.data[idx];
-            inertia[idx] = h_inertia.data[idx];
-
-            // insert reverse lookup global tag -> idx
-            rtag_map.insert(std::pair<unsigned int, unsigned int>(h_tag.data[idx], idx));
-            }
-
-        std::vector< std::vector<Scalar3> > pos_proc;              // Position array of every processor
-        std::vector< std::vector<Scalar3> > vel_proc;              // Velocities array of every processor
-        std::vector< std::vector<Scalar3> > accel_proc;            // Accelerations array of every processor
-        std::vector< std::vector<unsigned int> > type_proc;        // Particle types array of every processor
-        std::vector< std::vector<Scalar > > mass_proc;             // Particle masses array of every processor
-        std::vector< std::vector<Scalar > > charge_proc;           // Particle charges array of every processor
-        std::vector< std::vector<Scalar > > diameter_proc;         // Particle diameters array of every processor
-        std::vector< std::vector<int3 > > image_proc;              // Particle images array of every processor
-        std::vector< std::vector<unsigned int > > body_proc;       // Body ids of every processor
-        std::vector< std::vector<Scalar4 > > orientation_proc;     // Orientations of every processor
-        std::vector< std::vector<Scalar4 > > angmom_proc;          // Angular momenta of every processor
-        std::vector< std::vector<Scalar3 > > inertia_proc;         // Moments of inertia of every processor
-
-        std::vector< std::map<unsigned int, unsigned int> > rtag_map_proc; // List of reverse-lookup maps
-
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
-        unsigned int size = m_exec_conf->getNRanks();
-        unsigned int rank = m_exec_conf->getRank();
-
-        // resize to number of ranks in communicator
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        rtag_map_proc.resize(size);
-
+        unsigned int my_rank = m_exec_conf->getRank();
         unsigned int root = 0;
 
-        // collect all particle data on the root processor
-        gather_v(pos, pos_proc, root,mpi_comm);
-        gather_v(vel, vel_proc, root, mpi_comm);
-        gather_v(accel, accel_proc, root, mpi_comm);
-        gather_v(type, type_proc, root, mpi_comm);
-        gather_v(mass, mass_proc, root, mpi_comm);
-        gather_v(charge, charge_proc, root, mpi_comm);
-        gather_v(diameter, diameter_proc, root, mpi_comm);
-        gather_v(image, image_proc, root, mpi_comm);
-        gather_v(body, body_proc, root, mpi_comm);
-        gather_v(orientation, orientation_proc, root, mpi_comm);
-        gather_v(angmom, angmom_proc, root, mpi_comm);
-        gather_v(inertia, inertia_proc, root, mpi_comm);
-
-        // gather the reverse-lookup maps
-        gather_v(rtag_map, rtag_map_proc, root, mpi_comm);
-
-        if (rank == root)
+        // gather the tags of all particles to look up their snapshot indices
+        std::vector<unsigned int> tag_proc;      // Tags of all particles, in rank order
+        std::vector<unsigned int> N_proc;        // Number of particles of every rank
+        gather_array(h_tag.data, m_nparticles, tag_proc, N_proc, root, mpi_comm);
+
+        std::vector<unsigned int> snap_idx;      // Snapshot index of every particle, in rank order
+        std::vector<unsigned int> rank_offset;   // Offset of every rank in snap_idx
+
+        if (my_rank == root)
             {
             // allocate memory in snapshot
             snapshot.resize(getNGlobal());
 
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-            assert(rtag_map_proc.size() == n_ranks);
-
-            // create single map of all particle ranks and indices
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> > rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < n_ranks; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(std::pair<unsigned int, std::pair<unsigned int, unsigned int> >(
-                        it->first, std::pair<unsigned int, unsigned int>(irank, it->second)));
-
-            // add particles to snapshot
+            // the snapshot holds the particles in the order of the active tags
             assert(m_tag_set.size() == getNGlobal());
-            std::set<unsigned int>::const_iterator tag_set_it = m_tag_set.begin();
+            std::vector<unsigned int> tag_snap_idx(m_rtag.size(), NOT_LOCAL);
+            unsigned int snap_id = 0;
+            for (std::set<unsigned int>::const_iterator it = m_tag_set.begin(); it != m_tag_set.end(); ++it)
+                {
+                tag_snap_idx[*it] = snap_id;
 
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> >::iterator rank_rtag_it;
-            for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
+                // store tag in index map
+                index.insert(std::make_pair(*it, snap_id));
+                snap_id++;
+                }
+
+            std::vector<bool> found(getNGlobal(), false);
+            snap_idx.resize(tag_proc.size());
+            for (unsigned int i = 0; i < tag_proc.size(); i++)
                 {
-                unsigned int tag = *tag_set_it;
-                assert(tag <= getMaximumTag());
-                rank_rtag_it = rank_rtag_map.find(tag);
+                assert(tag_proc[i] < tag_snap_idx.size());
+                snap_idx[i] = tag_snap_idx[tag_proc[i]];
+                assert(snap_idx[i] < getNGlobal());
+                found[snap_idx[i]] = true;
+                }
 
-                if (rank_rtag_it == rank_rtag_map.end())
+            for (std::set<unsigned int>::const_iterator it = m_tag_set.begin(); it != m_tag_set.end(); ++it)
+                {
+                if (! found[tag_snap_idx[*it]])
                     {
                     m_exec_conf->msg->error()
-                        << endl << "Could not find particle " << tag << " on any processor. "
+                        << endl << "Could not find particle " << *it << " on any processor. "
                         << endl << endl;
                     throw std::runtime_error("Error gathering ParticleData");
                     }
+                }
 
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
+            rank_offset.resize(N_proc.size(), 0);
+            for (unsigned int irank = 1; irank < N_proc.size(); irank++)
+                rank_offset[irank] = rank_offset[irank-1] + N_proc[irank-1];
+            }
 
-                // store tag in index map
-                index.insert(std::make_pair(tag, snap_id));
-
-                snapshot.pos[snap_id] = vec3<Real>(pos_proc[rank][idx]);
-                snapshot.vel[snap_id] = vec3<Real>(vel_proc[rank][idx]);
-                snapshot.accel[snap_id] = vec3<Real>(accel_proc[rank][idx]);
-                snapshot.type[snap_id] = type_proc[rank][idx];
-                snapshot.mass[snap_id] = mass_proc[rank][idx];
-                snapshot.charge[snap_id] = charge_proc[rank][idx];
-                snapshot.diameter[snap_id] = diameter_proc[rank][idx];
-                snapshot.image[snap_id] = image_proc[rank][idx];
-                snapshot.body[snap_id] = body_proc[rank][idx];
-                snapshot.orientation[snap_id] = quat<Real>(orientation_proc[rank][idx]);
-                snapshot.angmom[snap_id] = quat<Real>(angmom_proc[rank][idx]);
-                snapshot.inertia[snap_id] = vec3<Real>(inertia_proc[rank][idx]);
-
-                // make sure the position stored in the snapshot is within the boundaries
+        // gather the particle data directly from the local arrays, writing every chunk into the snapshot
+        gather_array_chunked(h_pos.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar4 *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                {
+                unsigned int snap_id = snap_idx[rank_offset[irank] + offset + i];
+                snapshot.pos[snap_id] = vec3<Real>(make_scalar3(data[i].x, data[i].y, data[i].z) - m_origin);
+                snapshot.type[snap_id] = __scalar_as_int(data[i].w);
+                }
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_vel.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar4 *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                {
+                unsigned int snap_id = snap_idx[rank_offset[irank] + offset + i];
+                snapshot.vel[snap_id] = vec3<Real>(make_scalar3(data[i].x, data[i].y, data[i].z));
+                snapshot.mass[snap_id] = data[i].w;
+                }
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_accel.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar3 *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                snapshot.accel[snap_idx[rank_offset[irank] + offset + i]] = vec3<Real>(data[i]);
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_charge.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                snapshot.charge[snap_idx[rank_offset[irank] + offset + i]] = data[i];
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_diameter.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                snapshot.diameter[snap_idx[rank_offset[irank] + offset + i]] = data[i];
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_image.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const int3 *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                {
+                unsigned int snap_id = snap_idx[rank_offset[irank] + offset + i];
+                snapshot.image[snap_id] = make_int3(data[i].x - m_o_image.x,
+                                                    data[i].y - m_o_image.y,
+                                                    data[i].z - m_o_image.z);
+                }
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_body.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const unsigned int *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                snapshot.body[snap_idx[rank_offset[irank] + offset + i]] = data[i];
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_orientation.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar4 *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                snapshot.orientation[snap_idx[rank_offset[irank] + offset + i]] = quat<Real>(data[i]);
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_angmom.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar4 *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                snapshot.angmom[snap_idx[rank_offset[irank] + offset + i]] = quat<Real>(data[i]);
+            }, root, mpi_comm);
+
+        gather_array_chunked(h_inertia.data, m_nparticles,
+            [&](unsigned int irank, unsigned int offset, const Scalar3 *data, unsigned int n)
+            {
+            for (unsigned int i = 0; i < n; i++)
+                snapshot.inertia[snap_idx[rank_offset[irank] + offset + i]] = vec3<Real>(data[i]);
+            }, root, mpi_comm);
+
+        if (my_rank == root)
+            {
+            // make sure the positions stored in the snapshot are within the boundaries
+            for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
+                {
                 Scalar3 tmp = vec_to_scalar3(snapshot.pos[snap_id]);
                 m_global_box.wrap(tmp, snapshot.image[snap_id]);
                 snapshot.pos[snap_id] = vec3<Real>(tmp);
-
-                std::advance(tag_set_it, 1);
                 }
             }
         }
@@ -2478,18 +2834,34 @@ string print_ParticleData(ParticleData *pdata)
 template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed,
+                                           const std::vector<unsigned int>& tags,
+                                           bool local
                                           );
 template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<double>(const SnapshotParticleData<double> & snapshot,
+    const std::vector<unsigned int>& tags, bool local);
+#endif
+template bool ParticleData::updateFromSnapshot<double>(const SnapshotParticleData<double> & snapshot);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
 
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed,
+                                           const std::vector<unsigned int>& tags,
+                                           bool local
                                           );
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<float>(const SnapshotParticleData<float> & snapshot,
+    const std::vector<unsigned int>& tags, bool local);
+#endif
+template bool ParticleData::updateFromSnapshot<float>(const SnapshotParticleData<float> & snapshot);
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
 
 
@@ -419,7 +419,10 @@ class PYBIND11_EXPORT ParticleData
                      const BoxDim& global_box,
                      std::shared_ptr<ExecutionConfiguration> exec_conf,
                      std::shared_ptr<DomainDecomposition> decomposition
-                        = std::shared_ptr<DomainDecomposition>()
+                        = std::shared_ptr<DomainDecomposition>(),
+                     bool distributed=false,
+                     const std::vector<unsigned int>& tags=std::vector<unsigned int>(),
+                     bool local=false
                      );
 
         //! Destructor
@@ -977,6 +980,18 @@ class PYBIND11_EXPORT ParticleData
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from a snapshot slice held by every rank
+        template <class Real>
+        void initializeFromDistributedSnapshot(const SnapshotParticleData<Real> & snapshot,
+                                               const std::vector<unsigned int>& tags=std::vector<unsigned int>(),
+                                               bool local=false);
+        #endif
+
+        //! Update the properties of the current particles in place from a snapshot
+        template <class Real>
+        bool updateFromSnapshot(const SnapshotParticleData<Real> & snapshot);
+
         //! Take a snapshot
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
@@ -1217,9 +1232,15 @@ class PYBIND11_EXPORT ParticleData
         //! Helper function to check that particles of a snapshot are in the box
         /*! \return true If and only if all particles are in the simulation box
          * \param Snapshot to check
+         * \param distributed True if every rank holds a slice of the particles
          */
         template <class Real>
-        bool inBox(const SnapshotParticleData<Real>& snap);
+        bool inBox(const SnapshotParticleData<Real>& snap, bool distributed=false);
+
+        #ifdef ENABLE_MPI
+        //! Helper function to wrap a snapshot particle onto the global box and find the rank of its domain
+        unsigned int placeSnapshotParticle(Scalar3& pos, int3& img, const unsigned int *cart_ranks, unsigned int snap_idx);
+        #endif
 
         //! Update the CUDA memory hints
         void setGPUAdvice();
@@ -530,22 +530,17 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         if (m_pdata->getDomainDecomposition())
             {
             // combine lists from all processors
-            std::vector< std::vector<unsigned int> > member_tags_proc(m_exec_conf->getNRanks());
-            all_gather_v(member_tags, member_tags_proc, m_exec_conf->getMPICommunicator());
+            std::vector<unsigned int> member_tags_all;
+            std::vector<unsigned int> n_member_tags_proc;
+            all_gather_array(member_tags.data(), member_tags.size(), member_tags_all, n_member_tags_proc,
+                m_exec_conf->getMPICommunicator());
 
-            assert(member_tags_proc.size() == m_exec_conf->getNRanks());
+            assert(n_member_tags_proc.size() == m_exec_conf->getNRanks());
 
-            // combine all tags into an ordered set
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-            std::set<unsigned int> tag_set;
-            for (unsigned int irank = 0; irank < n_ranks; ++irank)
-                {
-                tag_set.insert(member_tags_proc[irank].begin(), member_tags_proc[irank].end());
-                }
-
-            // construct list
-            member_tags.clear();
-            member_tags.insert(member_tags.begin(), tag_set.begin(), tag_set.end());
+            // construct ordered list of unique tags
+            std::sort(member_tags_all.begin(), member_tags_all.end());
+            member_tags_all.erase(std::unique(member_tags_all.begin(), member_tags_all.end()), member_tags_all.end());
+            member_tags.swap(member_tags_all);
             }
         #endif
 
@@ -17,6 +17,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <algorithm>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 
 #include "GlobalArray.h"
@@ -212,6 +213,10 @@ class PYBIND11_EXPORT ParticleSelectorRigidCenter : public ParticleSelector
     For that it needs a list of indices of all the particles in the group. To facilitates this, the list of indices
     in the group will be stored in a GPUArray.
 
+    On the CPU, forEachMember() and sumOverMembers() run a function over the indices of the local members,
+    distributed over the TBB threads. sumOverMembers() adds fixed blocks of members in index list order and then adds
+    the block sums in order, so that its result is bitwise identical for any number of threads.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT ParticleGroup
@@ -330,6 +335,21 @@ class PYBIND11_EXPORT ParticleGroup
             }
         #endif
 
+        // @}
+        //! \name Iteration methods
+        // @{
+
+        //! Call a function with the particle index of every local member
+        template<class Func>
+        void forEachMember(const Func& f) const;
+
+        //! Sum a function of the particle index over all local members, independent of the number of threads
+        template<class Func>
+        double sumOverMembers(const Func& f) const;
+
+        //! Number of members added in order into one partial sum by sumOverMembers()
+        static const unsigned int sum_block_size = 1024;
+
         // @}
         //! \name Analysis methods
         // @{
@@ -444,6 +464,83 @@ class PYBIND11_EXPORT ParticleGroup
 
     };
 
+/*! \param f Function called as f(j) with the particle index \a j of each local member
+
+    f is called concurrently from several threads when TBB is enabled, so calls for different members may only write
+    to the data of their own particle. The index list is acquired once, hence the same restriction on the tag array
+    applies as for getIndexArray().
+*/
+template<class Func>
+void ParticleGroup::forEachMember(const Func& f) const
+    {
+    const unsigned int group_size = getNumMembers();
+    ArrayHandle<unsigned int> h_index(getIndexArray(), access_location::host, access_mode::read);
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf && m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+                f(h_index.data[group_idx]);
+            });
+        }
+    else
+    #endif
+        {
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            f(h_index.data[group_idx]);
+        }
+    }
+
+/*! \param f Function called as f(j) with the particle index \a j of each local member, returning its contribution
+    \returns The sum of f over the local members
+
+    f obeys the same rules as in forEachMember(). The members are summed in blocks of sum_block_size in index list
+    order and the block sums are added in order, so that the rounding does not depend on the number of threads.
+*/
+template<class Func>
+double ParticleGroup::sumOverMembers(const Func& f) const
+    {
+    const unsigned int group_size = getNumMembers();
+    const unsigned int block_size = sum_block_size;
+    const unsigned int n_blocks = (group_size + block_size - 1) / block_size;
+    ArrayHandle<unsigned int> h_index(getIndexArray(), access_location::host, access_mode::read);
+
+    std::vector<double> partial_sum(n_blocks, 0.0);
+    auto sum_block = [&](unsigned int block)
+        {
+        const unsigned int end = std::min(group_size, (block+1)*block_size);
+        double sum = 0.0;
+        for (unsigned int group_idx = block*block_size; group_idx < end; group_idx++)
+            sum += f(h_index.data[group_idx]);
+        partial_sum[block] = sum;
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf && m_exec_conf->getNumThreads() > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_blocks),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int block = r.begin(); block != r.end(); ++block)
+                sum_block(block);
+            });
+        }
+    else
+    #endif
+        {
+        for (unsigned int block = 0; block < n_blocks; block++)
+            sum_block(block);
+        }
+
+    double sum = 0.0;
+    for (unsigned int block = 0; block < n_blocks; block++)
+        sum += partial_sum[block];
+    return sum;
+    }
+
 //! Exports the ParticleGroup class to python
 void export_ParticleGroup(pybind11::module& m);
 
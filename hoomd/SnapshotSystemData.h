@@ -39,6 +39,12 @@
  * set up these data structures, and can also be obtained from an object of that class to
  * analyze the current system state.
  *
+ * A distributed snapshot (see GSDReader) holds a different slice of the particles and bonded groups
+ * on every rank, in order of increasing rank, so that no rank needs memory for the whole system.
+ * SystemDefinition assigns tags by the position of each slice and moves the data to the owning domains.
+ * A distributed snapshot may instead give the tags of every slice explicitly (see CheckpointReader), and
+ * a *local* snapshot holds on every rank exactly the particles and groups of its own domain, which stay in place.
+ *
  * \ingroup data_structs
  */
 template <class Real>
@@ -64,6 +70,17 @@ struct SnapshotSystemData {
     bool has_pair_data;                    //!< True if snapshot contains pair data
     bool has_integrator_data;              //!< True if snapshot contains integrator data
 
+    bool distributed;                      //!< True if every rank holds a contiguous slice of the particles and groups
+    bool local;                            //!< True if every rank holds the particles and groups of its domain
+
+    std::vector<unsigned int> particle_tags;   //!< Tags of the particles in a distributed snapshot (empty: by slice)
+    std::vector<unsigned int> bond_tags;       //!< Tags of the bonds in a distributed snapshot (empty: by slice)
+    std::vector<unsigned int> angle_tags;      //!< Tags of the angles in a distributed snapshot (empty: by slice)
+    std::vector<unsigned int> dihedral_tags;   //!< Tags of the dihedrals in a distributed snapshot (empty: by slice)
+    std::vector<unsigned int> improper_tags;   //!< Tags of the impropers in a distributed snapshot (empty: by slice)
+    std::vector<unsigned int> constraint_tags; //!< Tags of the constraints in a distributed snapshot (empty: by slice)
+    std::vector<unsigned int> pair_tags;       //!< Tags of the pairs in a distributed snapshot (empty: by slice)
+
     //! Constructor
     SnapshotSystemData()
         {
@@ -78,6 +95,9 @@ struct SnapshotSystemData {
         has_constraint_data = true;
         has_pair_data = true;
         has_integrator_data = true;
+
+        distributed = false;
+        local = false;
         }
 
     // Replicate the system along three spatial dimensions
@@ -11,6 +11,8 @@
 
 #include "System.h"
 #include "SignalHandler.h"
+#include "GSDReader.h"
+#include "SnapshotSystemData.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -434,30 +436,17 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
     // preset the flags before the run loop so that any analyzers/updaters run on step 0 have the info they need
     // but set the flags before prepRun, as prepRun may remove some flags that it cannot generate on the first step
-    m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep));
+    PDataFlags initial_flags = determineFlags(m_cur_tstep);
 
-#ifdef ENABLE_MPI
-    if (m_comm)
-        {
-        //! Set communicator in all Updaters
-        vector<updater_item>::iterator updater;
-        for (updater =  m_updaters.begin(); updater != m_updaters.end(); ++updater)
-            updater->m_updater->setCommunicator(m_comm);
-
-        // Set communicator in all Computes
-        map< string, std::shared_ptr<Compute> >::iterator compute;
-        for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
-            compute->second->setCommunicator(m_comm);
+    // a run of zero steps only evaluates the forces in prepRun, compute the potential energy there
+    if (nsteps == 0)
+        initial_flags[pdata_flag::potential_energy] = 1;
 
-        // Set communicator in all Analyzers
-        vector<analyzer_item>::iterator analyzer;
-        for (analyzer =  m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
-            analyzer->m_analyzer->setCommunicator(m_comm);
+    m_sysdef->getParticleData()->setFlags(initial_flags);
 
-        // Set communicator in Integrator
-        if (m_integrator)
-            m_integrator->setCommunicator(m_comm);
-        }
+#ifdef ENABLE_MPI
+    if (m_comm)
+        shareCommunicator();
 #endif
 
     resetStats();
@@ -599,7 +588,13 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
         // look ahead to the next time step and see which analyzers and updaters will be executed
         // or together all of their requested PDataFlags to determine the flags to set for this time step
-        m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep+1));
+        PDataFlags flags = determineFlags(m_cur_tstep+1);
+
+        // compute the potential energy on the last step, so that it is available between runs
+        if (m_cur_tstep+1 == m_end_tstep)
+            flags[pdata_flag::potential_energy] = 1;
+
+        m_sysdef->getParticleData()->setFlags(flags);
 
         // execute the integrator
         if (m_integrator)
@@ -652,6 +647,230 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
         }
     }
 
+/*! \param reader Open GSD file to read the frames from
+    \param start Index of the first frame
+    \param end Index one past the last frame, or 0 to replay up to the end of the file
+    \param stride Replay every \a stride'th frame
+    \param callback Python function called with the time step after the analyzers executed on a frame, or None
+
+    replay() loads the frames of a trajectory one after another into the system and evaluates the observables of
+    each: the Integrator computes the net force and virial (without moving the particles), and then every Analyzer
+    executes, regardless of its period. Updaters do not execute. The time step is set to that of the frame while it
+    is evaluated and restored afterwards, the particle data keeps the last frame. A negative return value of the
+    callback ends the replay.
+
+    Frames with the same particles and topology as the system are written in place into the particle data (see
+    loadFrame()), so neighbor lists and other cached data carry over from frame to frame. While one frame is
+    evaluated, the operating system already reads the next one from the file (GSDReader::prefetchFrame()).
+
+    With multiple partitions (--nrank), every partition replays an interleaved subset of the selected frames, so
+    that independent partitions analyze a trajectory in parallel.
+*/
+void System::replay(std::shared_ptr<GSDReader> reader, uint64_t start, uint64_t end, uint64_t stride,
+                    py::object callback)
+    {
+    if (stride == 0)
+        {
+        m_exec_conf->msg->error() << "replay: stride must be positive" << endl;
+        throw runtime_error("Error replaying trajectory");
+        }
+
+    uint64_t nframes = reader->getNFrames();
+    if (end == 0 || end > nframes)
+        end = nframes;
+
+    // partitions replay interleaved subsets of the frames
+    unsigned int partition = 0;
+    unsigned int n_partitions = 1;
+    #ifdef ENABLE_MPI
+    partition = m_exec_conf->getPartition();
+    n_partitions = m_exec_conf->getNPartitions();
+    #endif
+
+    std::vector<uint64_t> frames;
+    uint64_t n = 0;
+    for (uint64_t frame = start; frame < end; frame += stride, n++)
+        {
+        if (n % n_partitions == partition)
+            frames.push_back(frame);
+        }
+
+    int64_t initial_time = m_clk.getTime();
+    unsigned int initial_tstep = m_cur_tstep;
+    setupProfiling();
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        shareCommunicator();
+#endif
+
+    resetStats();
+
+    // every analyzer executes on every frame
+    PDataFlags flags(0);
+    if (m_integrator)
+        flags = m_integrator->getRequestedPDataFlags();
+    else
+        m_exec_conf->msg->warning() << "Replaying without an integrator, forces are not evaluated" << endl;
+
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        flags |= analyzer->m_analyzer->getRequestedPDataFlags();
+
+    m_sysdef->getParticleData()->setFlags(flags);
+
+    unsigned int n_replayed = 0;
+    uint64_t last_timestep = 0;
+
+    if (frames.size() > 0)
+        reader->prefetchFrame(frames[0]);
+
+    for (unsigned int i = 0; i < frames.size(); i++)
+        {
+        reader->readFrame(frames[i]);
+        bool topology = reader->hasTopology(frames[i]);
+
+        if (i + 1 < frames.size())
+            reader->prefetchFrame(frames[i+1]);
+
+        // computes cache their results by time step, they would not be evaluated again at the same step
+        uint64_t timestep = reader->getTimeStep();
+        if (n_replayed > 0 && timestep == last_timestep)
+            {
+            m_exec_conf->msg->warning() << "replay: skipping frame " << frames[i]
+                                        << ", it has the same time step as the previous frame" << endl;
+            continue;
+            }
+        last_timestep = timestep;
+
+        // the first frame sets up the topology the following frames share
+        loadFrame(reader->getSnapshot(), topology || n_replayed == 0);
+        m_cur_tstep = (unsigned int)timestep;
+
+        #ifdef ENABLE_MPI
+        if (m_comm)
+            {
+            m_comm->forceMigrate();
+            m_comm->communicate(m_cur_tstep);
+            }
+        #endif
+
+        // computes may have cached results at the time step of the first frame before the replay,
+        // recompute them before the integrator sums the forces
+        if (n_replayed == 0)
+            {
+            map< string, std::shared_ptr<Compute> >::iterator compute;
+            for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
+                compute->second->forceCompute(m_cur_tstep);
+            }
+
+        if (m_integrator)
+            m_integrator->evaluateForces(m_cur_tstep);
+
+        for (analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+            analyzer->m_analyzer->analyze(m_cur_tstep);
+
+        n_replayed++;
+
+        // execute python callback, if present
+        // a negative return value indicates immediate end of the replay
+        if (callback != py::none())
+            {
+            py::object rv = callback(m_cur_tstep);
+            if (rv != py::none() && py::cast<int>(rv) < 0)
+                {
+                m_exec_conf->msg->notice(2) << "End of replay requested by python callback at frame "
+                                            << frames[i] << endl;
+                break;
+                }
+            }
+
+        // quit if Ctrl-C was pressed
+        if (g_sigint_recvd)
+            {
+            g_sigint_recvd = 0;
+            break;
+            }
+        }
+
+    m_cur_tstep = initial_tstep;
+
+    Scalar FPS = Scalar(n_replayed) / Scalar(m_clk.getTime() - initial_time) * Scalar(1e9);
+    if (!m_quiet_run)
+        m_exec_conf->msg->notice(1) << "Replayed " << n_replayed << " frames, average FPS: " << FPS << endl;
+
+    // write out the profile data
+    if (m_profiler)
+        m_exec_conf->msg->notice(1) << *m_profiler;
+    }
+
+/*! \param snapshot Snapshot of the frame
+    \param topology True if the topology of the system has to be loaded from the frame
+
+    Update the particle data in place with ParticleData::updateFromSnapshot() when the frame has the same particles
+    and topology as the system, otherwise reinitialize the system from the snapshot.
+*/
+void System::loadFrame(std::shared_ptr< SnapshotSystemData<float> > snapshot, bool topology)
+    {
+    std::shared_ptr<ParticleData> pdata = m_sysdef->getParticleData();
+
+    bool in_place = !topology && snapshot->dimensions == m_sysdef->getNDimensions();
+    #ifdef ENABLE_MPI
+    in_place = in_place && !pdata->getDomainDecomposition();
+    #endif
+
+    if (in_place)
+        in_place = pdata->updateFromSnapshot(snapshot->particle_data);
+
+    if (in_place)
+        {
+        // only signal a box change when the box changes
+        const BoxDim& box = pdata->getGlobalBox();
+        const BoxDim& new_box = snapshot->global_box;
+        Scalar3 L = box.getL();
+        Scalar3 new_L = new_box.getL();
+        if (L.x != new_L.x || L.y != new_L.y || L.z != new_L.z
+            || box.getTiltFactorXY() != new_box.getTiltFactorXY()
+            || box.getTiltFactorXZ() != new_box.getTiltFactorXZ()
+            || box.getTiltFactorYZ() != new_box.getTiltFactorYZ())
+            {
+            pdata->setGlobalBox(new_box);
+            }
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "replay: reinitializing the system from the frame" << endl;
+        snapshot->has_integrator_data = false;
+        m_sysdef->initializeFromSnapshot(snapshot);
+        }
+    }
+
+#ifdef ENABLE_MPI
+/*! Set the communicator in all updaters, computes, analyzers, and the integrator before they execute
+*/
+void System::shareCommunicator()
+    {
+    //! Set communicator in all Updaters
+    vector<updater_item>::iterator updater;
+    for (updater =  m_updaters.begin(); updater != m_updaters.end(); ++updater)
+        updater->m_updater->setCommunicator(m_comm);
+
+    // Set communicator in all Computes
+    map< string, std::shared_ptr<Compute> >::iterator compute;
+    for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
+        compute->second->setCommunicator(m_comm);
+
+    // Set communicator in all Analyzers
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer =  m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        analyzer->m_analyzer->setCommunicator(m_comm);
+
+    // Set communicator in Integrator
+    if (m_integrator)
+        m_integrator->setCommunicator(m_comm);
+    }
+#endif
+
 /*! \param enable Set to true to enable profiling during calls to run()
 */
 void System::enableProfiler(bool enable)
@@ -930,6 +1149,7 @@ void export_System(py::module& m)
     .def("enableProfiler", &System::enableProfiler)
     .def("enableQuietRun", &System::enableQuietRun)
     .def("run", &System::run)
+    .def("replay", &System::replay)
 
     .def("getLastTPS", &System::getLastTPS)
     .def("getCurrentTimeStep", &System::getCurrentTimeStep)
@@ -17,8 +17,9 @@
 #ifndef __SYSTEM_H__
 #define __SYSTEM_H__
 
-#ifdef ENABLE_MPI
 //! Forward declarations
+class GSDReader;
+#ifdef ENABLE_MPI
 class Communicator;
 #endif
 
@@ -55,6 +56,9 @@ class Communicator;
     is meant to be a once per simulation operation. In other words, the accesses
     are not optimized.
 
+    replay() evaluates the Analyzers (and the forces of the Integrator) on the frames of a trajectory instead of
+    advancing the simulation.
+
     See \ref page_system_class_design for more info.
 
     \ingroup hoomd_lib
@@ -147,6 +151,10 @@ class PYBIND11_EXPORT System
                  pybind11::object callback, double limit_hours=0.0f,
                  unsigned int limit_multiple=1);
 
+        //! Evaluates the analyzers on the frames of a trajectory
+        void replay(std::shared_ptr<GSDReader> reader, uint64_t start, uint64_t end, uint64_t stride,
+                    pybind11::object callback);
+
         //! Configures profiling of runs
         void enableProfiler(bool enable);
 
@@ -439,6 +447,14 @@ class PYBIND11_EXPORT System
         //! Get the flags needed for a particular step
         PDataFlags determineFlags(unsigned int tstep);
 
+        //! Load a trajectory frame into the system
+        void loadFrame(std::shared_ptr< SnapshotSystemData<float> > snapshot, bool topology);
+
+#ifdef ENABLE_MPI
+        //! Set the communicator in all updaters, computes, analyzers, and the integrator
+        void shareCommunicator();
+#endif
+
         // --------- Helper function for handling lists
         //! Search for an Analyzer by name
         std::vector<analyzer_item>::iterator findAnalyzerItem(const std::string &name);
@@ -86,6 +86,34 @@ sys.excepthook = _hoomd_sys_excepthook
 
 __version__ = "{0}.{1}.{2}".format(*_hoomd.__version__)
 
+def _prepare_run(profile, quiet):
+    """ Pass the current parameters of the integrator, loggers, and neighbor lists to the system before a run.
+    """
+    if context.current.integrator is not None:
+        context.current.integrator.update_forces();
+        context.current.integrator.update_methods();
+        context.current.integrator.update_thermos();
+
+    # update autotuner parameters
+    context.current.system.setAutotunerParams(context.options.autotuner_enable, int(context.options.autotuner_period));
+
+    for logger in context.current.loggers:
+        logger.update_quantities();
+    context.current.system.enableProfiler(profile);
+    context.current.system.enableQuietRun(quiet);
+
+    # update all user-defined neighbor lists
+    for nl in context.current.neighbor_lists:
+        nl.update_rcut()
+        nl.update_exclusions_defaults()
+
+def _flush_loggers():
+    """ Write out the data buffered by loggers at the end of a run.
+    """
+    for logger in context.current.loggers:
+        if hasattr(logger, 'flush'):
+            logger.flush();
+
 def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_period=0, callback=None, quiet=False):
     """ Runs the simulation for a given number of time steps.
 
@@ -171,23 +199,8 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
 
     if context.current.integrator is None:
         context.msg.warning("Starting a run without an integrator set");
-    else:
-        context.current.integrator.update_forces();
-        context.current.integrator.update_methods();
-        context.current.integrator.update_thermos();
 
-    # update autotuner parameters
-    context.current.system.setAutotunerParams(context.options.autotuner_enable, int(context.options.autotuner_period));
-
-    for logger in context.current.loggers:
-        logger.update_quantities();
-    context.current.system.enableProfiler(profile);
-    context.current.system.enableQuietRun(quiet);
-
-    # update all user-defined neighbor lists
-    for nl in context.current.neighbor_lists:
-        nl.update_rcut()
-        nl.update_exclusions_defaults()
+    _prepare_run(profile, quiet);
 
     # detect 0 hours remaining properly
     if limit_hours == 0.0:
@@ -198,7 +211,10 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
 
     if not quiet:
         context.msg.notice(1, "** starting run **\n");
-    context.current.system.run(int(tsteps), callback_period, callback, limit_hours, int(limit_multiple));
+    try:
+        context.current.system.run(int(tsteps), callback_period, callback, limit_hours, int(limit_multiple));
+    finally:
+        _flush_loggers();
     if not quiet:
         context.msg.notice(1, "** run complete **\n");
 
@@ -242,6 +258,74 @@ def run_upto(step, **keywords):
     run(n_steps, **keywords);
     util.unquiet_status();
 
+def replay(filename, start=0, end=None, stride=1, callback=None, profile=False, quiet=False):
+    """ Evaluates analyzers on the frames of a trajectory.
+
+    Args:
+
+        filename (str): GSD file to read the frames from.
+        start (int): Index of the first frame to evaluate.
+        end (int): Index one past the last frame to evaluate. When None, evaluate up to the end of the file.
+        stride (int): Evaluate every *stride*'th frame.
+        callback (`callable`): Python function called on every frame with the time step of the frame.
+        profile (bool): Set to True to enable high level profiling output at the end of the replay.
+        quiet (bool): Set to True to disable the information printed to the screen by the replay.
+
+    Example::
+
+            system = init.read_gsd('trajectory.gsd')
+            nl = md.nlist.cell()
+            lj = md.pair.lj(r_cut=2.5, nlist=nl)
+            lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+            md.integrate.mode_standard(dt=0.005)
+            analyze.log(filename='pressure.log', quantities=['pressure', 'pair_lj_energy'], period=1)
+            hoomd.replay('trajectory.gsd')
+
+            hoomd.replay('trajectory.gsd', start=100, stride=10,
+                         callback=lambda step: print(lj.compute_energy(tags1, tags2)))
+
+    :py:func:`replay()` evaluates new observables on an existing trajectory without simulating. Instead of advancing
+    the system in time, it loads the selected frames of *filename* one after another into the system. On each frame,
+    the integrator computes the forces and virials, then **all** analyzers execute, regardless of their period, and
+    finally *callback* is called. Updaters and integration methods do not execute. Specify an integration mode
+    (for example :py:class:`hoomd.md.integrate.mode_standard`) to evaluate forces and thermodynamic quantities.
+    If *callback* returns a negative number, the replay ends.
+
+    The file stays open during the replay, and frames that have the same particles and topology as the system
+    update the particle data in place, so neighbor lists are only rebuilt when particles moved far enough.
+    The next frame is read from disk in the background while the current frame is evaluated.
+
+    During the evaluation of a frame, the current time step is the time step of the frame. After the replay,
+    the time step is restored and the system holds the last frame.
+
+    When HOOMD is started with multiple partitions (``--nrank``), every partition evaluates an interleaved subset
+    of the selected frames in parallel. Give each partition its own output file names
+    (see :py:func:`hoomd.comm.get_partition`).
+    """
+
+    if not quiet:
+        util.print_status_line();
+    # check if initialization has occurred
+    if not init.is_initialized():
+        context.msg.error("Cannot replay before initialization\n");
+        raise RuntimeError('Error replaying');
+
+    if end is None:
+        end = 0;
+
+    _prepare_run(profile, quiet);
+
+    reader = _hoomd.GSDReader(context.exec_conf, filename, 0, False);
+
+    if not quiet:
+        context.msg.notice(1, "** starting replay **\n");
+    try:
+        context.current.system.replay(reader, int(start), int(end), int(stride), callback);
+    finally:
+        _flush_loggers();
+    if not quiet:
+        context.msg.notice(1, "** replay complete **\n");
+
 def get_step():
     """ Get the current simulation time step.
 
@@ -56,6 +56,12 @@ class PYBIND11_EXPORT CGCMMForceCompute : public ForceCompute
         //! Calculates the requested log value and returns it
         virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
 
+        //! Get the computes that this force brings up to date in compute()
+        virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+            {
+            return std::vector< std::shared_ptr<Compute> >(1, m_nlist);
+            }
+
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         Scalar m_r_cut;         //!< Cutoff radius beyond which the force is set to 0
@@ -94,6 +94,12 @@ class DEM2DForceCompute : public ForceCompute
             return true;
             }
 
+        //! Get the computes that this force brings up to date in compute()
+        virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+            {
+            return std::vector< std::shared_ptr<Compute> >(1, m_nlist);
+            }
+
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         Real m_r_cut;         //!< Cutoff radius beyond which the force is set to 0
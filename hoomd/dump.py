@@ -16,6 +16,71 @@ import os;
 import sys;
 import types;
 
+class checkpoint(hoomd.analyze._analyzer):
+    R""" Writes full state checkpoints for restarting simulations.
+
+    Args:
+        filename (str): Base name of the checkpoint files.
+        period (int): Number of time steps between checkpoints, or None to write a single checkpoint immediately.
+        phase (int): When -1, start on the current time step. Otherwise, execute on steps where *(step + phase) % period* is 0.
+
+    Every MPI rank writes the state of its own domain to the binary file ``filename.<rank>`` in parallel, without any
+    communication of particle data. A checkpoint holds the box, all particles with their tags, bonds, angles,
+    dihedrals, impropers, constraints, pairs, the integrator variables (such as thermostat and barostat state), and the
+    domain decomposition. Random number streams in HOOMD are derived from the seed and the time step, so they need
+    no additional state. Use :py:meth:`dump_state` to add the state of other objects, such as HPMC move sizes.
+
+    Every file is first written under a temporary name and replaces the previous checkpoint only once all ranks have
+    written theirs. Restart with :py:func:`hoomd.init.read_checkpoint`.
+
+    Checkpoint files are meant for restarting on the same machine: they store values in the native byte order and
+    precision, and their format may change between HOOMD versions. Use :py:class:`gsd` for long term storage.
+
+    Examples::
+
+        dump.checkpoint(filename="checkpoint", period=100000)
+        ckpt = dump.checkpoint(filename="checkpoint", period=100000)
+        ckpt.dump_state(mc)
+        dump.checkpoint(filename="final", period=None)
+    """
+    def __init__(self, filename, period, phase=0):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        hoomd.analyze._analyzer.__init__(self);
+
+        self.cpp_analyzer = _hoomd.CheckpointWriter(hoomd.context.current.system_definition, filename);
+
+        if period is not None:
+            self.setupAnalyzer(period, phase);
+        else:
+            self.write();
+
+        # store metadata
+        self.filename = filename
+        self.period = period
+        self.phase = phase
+        self.metadata_fields = ['filename','period','phase']
+
+    def write(self):
+        """ Write a checkpoint at the current time step.
+
+        Call :py:meth:`write` at the end of a simulation to save its final state.
+        """
+        time_step = hoomd.context.current.system.getCurrentTimeStep()
+        self.cpp_analyzer.analyze(time_step);
+
+    def dump_state(self, obj):
+        """Write state information for a hoomd object.
+
+        Call :py:meth:`dump_state` to add the state of a hoomd object to the checkpoint. Restore it by passing
+        ``restore_state=True`` to the object after :py:func:`hoomd.init.read_checkpoint`.
+        """
+        if hasattr(obj, '_connect_checkpoint') and type(getattr(obj, '_connect_checkpoint')) == types.MethodType:
+            obj._connect_checkpoint(self);
+        else:
+            hoomd.context.msg.warning("Checkpoints are not currently supported for {}\n".format(obj.__class__.__name__));
+
 class dcd(hoomd.analyze._analyzer):
     R""" Writes simulation snapshots in the DCD format
 
@@ -504,6 +569,15 @@ class gsd(hoomd.analyze._analyzer):
         time_step (int): Time step to write to the file (only used when period is None)
         dynamic (list): A list of quantity categories to save every frame. (added in version 2.2)
         static (list): A list of quantity categories save only in frame 0 (may not be set in conjunction with *dynamic*, deprecated in version 2.2).
+        compress (bool): When True, store chunks in a HOOMD specific compressed format that standard GSD readers
+                         cannot read. Integer chunks (typeid, body, image, and topology) are compressed losslessly.
+        precision (float): When set, also quantize positions, velocities, and orientations to this relative
+                           precision (requires *compress*).
+        keyframe_period (int): When set, write positions in full only every *keyframe_period* frames and store only the
+                               particles that moved in the frames between.
+        tolerance (float): Distance a particle must move before its position is stored again in a delta frame.
+        field_groups (dict): Map of per-particle chunk names to the :py:mod:`hoomd.group` of the particles to write
+                             them for.
 
     Write a simulation snapshot to the specified GSD file at regular intervals. GSD is capable of storing all particle
     and bond data fields in hoomd, in every frame of the trajectory. This allows GSD to store simulations where the
@@ -551,6 +625,10 @@ class gsd(hoomd.analyze._analyzer):
         * constraints/
         * pairs/
 
+    When ``topology`` is dynamic, it is only written to frames in which it differs from frame 0, and it is only
+    gathered from the MPI ranks again after bonds, angles, dihedrals, impropers, constraints, or pairs have been added
+    or removed.
+
     See https://github.com/glotzerlab/gsd and http://gsd.readthedocs.io/ for more information on GSD files.
 
     If you only need to store a subset of the system, you can save file size and time spent analyzing data by
@@ -560,6 +638,57 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`gsd` to write a new frame 0
     to the file every period steps.
 
+    .. rubric:: Compression
+
+    Compression is off by default and files are standard GSD files. Set **compress** to store integer chunks
+    (``particles/typeid``, ``particles/body``, ``particles/image``, and the topology type ids and groups) losslessly
+    compressed. Together with **compress**, set **precision** to store ``particles/position``,
+    ``particles/velocity``, and ``particles/orientation`` rounded to a fixed grid instead of as full floats:
+
+    * positions are within *precision* times the box length of the true values,
+    * velocities are within *precision* times the largest velocity component in the frame, per dimension,
+    * orientation quaternion components are within *precision* of the true values.
+
+    A *precision* of 1e-4 stores positions in about a third of the space of uncompressed floats. Compressed chunks
+    are stored under the chunk name with ``.z`` appended. :py:func:`hoomd.init.read_gsd()`,
+    :py:class:`hoomd.data.gsd_snapshot`, and :py:func:`hoomd.replay()` of this HOOMD build decode them
+    transparently.
+
+    .. warning::
+
+        Compressed files are readable only by this build of HOOMD. Standard GSD readers (the ``gsd`` python package,
+        OVITO, VMD, and older HOOMD versions) do not decode ``.z`` chunks. They do not find the compressed
+        quantities in the frame, and fall back to frame 0 or to the default values. Write uncompressed files for
+        data that is shared or read by other tools.
+
+    Chunks are compressed in parallel when HOOMD is built with TBB. Quantized files are intended for analysis and
+    visualization, use uncompressed files for restarts that must be exact.
+
+    .. rubric:: Delta frames and field groups
+
+    Set **keyframe_period** to write ``particles/position`` in full only in keyframes: the first frame written, every
+    *keyframe_period*-th frame after it, and any frame in which the particles in the group change. The frames in
+    between store the particles that moved further than **tolerance** since their position was last stored, as a list
+    of rows in ``particles/position/delta_index`` and their positions in ``particles/position/delta_value``. Use a
+    *tolerance* of 0 to store every particle that moved at all. In slowly evolving or mostly frozen systems, delta
+    frames are much smaller than full frames.
+
+    Positions read back from a delta frame are within *tolerance* of the true positions when the keyframes are stored
+    in full. When **precision** is also set, keyframe positions are quantized, and a particle that has not been stored
+    in a delta frame since the last keyframe carries the quantization error as well. Each component of such a
+    position is within *tolerance* + *precision* times the box length in that dimension of the true value. Positions
+    stored in delta frames are not quantized.
+
+    **field_groups** selects per-particle chunks to write only for a group of particles, for example to store
+    velocities for a small probe group only. Valid keys are ``particles/orientation``, ``particles/velocity``,
+    ``particles/angmom``, and ``particles/image``. The rows of the group members are stored in
+    ``<name>/subset_index`` and their values in ``<name>/subset_value``. The other particles keep the values of frame 0
+    or the defaults when the file is read.
+
+    :py:func:`hoomd.init.read_gsd()`, :py:class:`hoomd.data.gsd_snapshot`, and :py:func:`hoomd.replay()` reconstruct
+    full frames from delta frames and subset chunks, but other GSD readers only see the chunks as stored. Delta and
+    subset chunks are not compressed.
+
     .. rubric:: State data
 
     :py:class:`gsd` can save internal state data for the following hoomd objects:
@@ -584,6 +713,9 @@ class gsd(hoomd.analyze._analyzer):
         dump.gsd(filename="configuration.gsd", overwrite=True, period=None, group=group.all(), time_step=0)
         dump.gsd(filename="momentum_too.gsd", period=1000, group=group.all(), phase=0, dynamic=['momentum'])
         dump.gsd(filename="saveall.gsd", overwrite=True, period=1000, group=group.all(), dynamic=['attribute', 'momentum', 'topology'])
+        dump.gsd(filename="compact.gsd", period=1000, group=group.all(), compress=True, precision=1e-4)
+        dump.gsd(filename="delta.gsd", period=100, group=group.all(), keyframe_period=50, tolerance=0.01,
+                 dynamic=['momentum'], field_groups={'particles/velocity': probe})
 
     """
     def __init__(self,
@@ -595,12 +727,29 @@ class gsd(hoomd.analyze._analyzer):
                  phase=0,
                  time_step=None,
                  static=None,
-                 dynamic=None):
+                 dynamic=None,
+                 compress=False,
+                 precision=None,
+                 keyframe_period=None,
+                 tolerance=0.0,
+                 field_groups=None):
         hoomd.util.print_status_line();
 
         if static is not None and dynamic is not None:
             raise ValueError("Cannot specify both static and dynamic arguments");
 
+        if precision is not None and precision <= 0:
+            raise ValueError("precision must be positive");
+
+        if precision is not None and not compress:
+            raise ValueError("precision requires compress=True");
+
+        if keyframe_period is not None and keyframe_period < 1:
+            raise ValueError("keyframe_period must be positive");
+
+        if tolerance < 0:
+            raise ValueError("tolerance must not be negative");
+
         categories = ['attribute', 'property', 'momentum', 'topology'];
         dynamic_quantities = ['property']
 
@@ -635,6 +784,14 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' in dynamic_quantities);
         self.cpp_analyzer.setWriteMomentum('momentum' in dynamic_quantities);
         self.cpp_analyzer.setWriteTopology('topology' in dynamic_quantities);
+        self.cpp_analyzer.setCompress(compress);
+        if precision is not None:
+            self.cpp_analyzer.setPrecision(precision);
+        if keyframe_period is not None:
+            self.cpp_analyzer.setDelta(keyframe_period, tolerance);
+        if field_groups is not None:
+            for name, field_group in field_groups.items():
+                self.cpp_analyzer.setFieldGroup(name, field_group.cpp_group);
 
         if period is not None:
             self.setupAnalyzer(period, phase);
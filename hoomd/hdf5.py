@@ -54,6 +54,9 @@ class log(hoomd.analyze._analyzer):
         matrix_quantities(list): Matrix quantities to log.
         overwrite(bool): When False (the default) the existing log will be append. When True the file will be overwritten.
         phase(int): When -1, start on the current time step. When >= 0 execute on steps where *(step +phase) % period == 0*.
+        buffer_size(int): Number of logged time steps to collect in memory before writing them to the file.
+        flush_period(int): When not None, also write the collected values once *flush_period* time steps have
+                           passed since the first of them was logged.
 
     For details on the loggable quantities refer :py:class:`hoomd.analyze.log` for details.
 
@@ -64,6 +67,12 @@ class log(hoomd.analyze._analyzer):
     corresponds to the name of the quantity. The first dimension of the data set is counting the
     logged time step. The other dimension correspond to the dimensions of the logged matrix.
 
+    By default, every logged time step is written to the file immediately. With *buffer_size* > 1, the values are
+    copied into an in-memory buffer on every logged time step and written to the file in one block once
+    *buffer_size* time steps are collected, when *flush_period* time steps have passed, at the end of every
+    :py:func:`hoomd.run()`, and on :py:meth:`flush()`. Buffering avoids calling into python and h5py on every logged
+    time step, which speeds up frequent logging.
+
     Note:
         The number and order of non-matrix quantities cannot change compared to data which is already
         stored in the hdf5 file. As a result, if you append to a file make sure you are logging the
@@ -87,9 +96,13 @@ class log(hoomd.analyze._analyzer):
            log.register_callback('random_matrix', random_matrix, True)
            #more setup
            run(200)
+
+        with hoomd.hdf5.File("log.h5", "w") as h5file:
+           log = hoomd.hdf5.log(h5file, quantities=['pressure'], period=10, buffer_size=1000)
+           run(1e6)
     """
 
-    def __init__(self, h5file, period, quantities=list(), matrix_quantities=list(), phase=0):
+    def __init__(self, h5file, period, quantities=list(), matrix_quantities=list(), phase=0, buffer_size=1, flush_period=None):
         hoomd.util.print_status_line()
         if not isinstance(h5file, hoomd.hdf5.File):
             hoomd.context.msg.error("HDF5 file descriptor is no instance of h5py.File, which is the hoomd thin wrapper for hdf5 file descriptors.")
@@ -111,6 +124,11 @@ class log(hoomd.analyze._analyzer):
         self.set_params(quantities=quantities, matrix_quantities=matrix_quantities)
         hoomd.util.unquiet_status()
 
+        # set up the buffer
+        self.cpp_analyzer.setBufferSize(int(buffer_size))
+        if flush_period is not None:
+            self.cpp_analyzer.setFlushPeriod(int(flush_period))
+
         # add the logger to the list of loggers
         hoomd.context.current.loggers.append(self)
 
@@ -138,7 +156,7 @@ class log(hoomd.analyze._analyzer):
 
     def query(self, quantity, force_matrix=False):
         R"""
-            Get the last logged value of a quantity which has been written to the file.
+            Get the last logged value of a quantity. With a buffer, the value may not have been written to the file yet.
             If quantity is registered as a non-matrix quantity, its value is returned.
             If it is not registered as a non-matrix quantity, it is assumed to be a matrix quantity.
             If a quantity exists as non-matrix and matrix quantity with the same name, force_matrix
@@ -209,6 +227,18 @@ class log(hoomd.analyze._analyzer):
         # re-register all computes and updater
         hoomd.context.current.system.registerLogger(self.cpp_analyzer)
 
+    def flush(self):
+        R""" Write all buffered values to the file.
+
+        Examples::
+
+            logger.flush()
+
+        The buffer is flushed automatically at the end of every :py:func:`hoomd.run()`. Call :py:meth:`flush()`
+        before reading the file in the same script at other points.
+        """
+        self.cpp_analyzer.flush()
+
     def disable(self):
         R""" Disable the logger.
 
@@ -226,6 +256,8 @@ class log(hoomd.analyze._analyzer):
         _analyzer.disable(self)
         hoomd.util.unquiet_status()
 
+        self.flush()
+
         hoomd.context.current.loggers.remove(self)
 
     def enable(self):
@@ -262,7 +294,7 @@ class log(hoomd.analyze._analyzer):
         return timestep
 
     # \internal
-    # \brief Writes the non-matrix quantities of the logger as an array to the hdf5 file.
+    # \brief Writes the buffered non-matrix quantities of the logger as a block of rows to the hdf5 file.
     def _write_quantities(self, f, timestep):
         # Everything is MPI collective, except writing.
         # prepare and check file for quantities
@@ -272,34 +304,28 @@ class log(hoomd.analyze._analyzer):
             data_set = f["/quantities"]
             old_size = data_set.shape[0]
 
-            if data_set.shape[1] != new_array.shape[0]:
+            if data_set.shape[1] != new_array.shape[1]:
                 hoomd.context.msg.error("The number of logged quantities does not match"
                                         " with the number of quantities stored in the file.")
                 raise RuntimeError("Error write quantities with log_hdf5.")
 
-            data_set.resize(old_size + 1, axis=0)
-            data_set[old_size, ] = new_array
+            data_set.resize(old_size + new_array.shape[0], axis=0)
+            data_set[old_size:, ] = new_array
 
     # \internal
-    # \brief Writes the logged matrix quantities to file
+    # \brief Writes the buffered matrix quantities to file
     def _write_matrix_values(self, f, timestep):
         matrix_quantities = self.cpp_analyzer.getLoggedMatrixQuantities()
 
         for q in matrix_quantities:
-            # Obtain the numpy array from cpp class.
-            try:
-                # This is called on every rank, but only root rank returns "correct data"
-                new_matrix = self.cpp_analyzer.getMatrixQuantity(q, timestep)
-            except:
-                hoomd.context.msg.error("For quantity " + q + " no python type obtainable.")
-                raise RuntimeError("Error writing matrix quantity " + q)
+            # Obtain the buffered matrices, stacked along the first dimension, from cpp class.
+            # This is called on every rank, but only root rank returns data
+            new_matrices = self.cpp_analyzer.getBufferedMatrix(q)
 
             if f is not None:  # Only the root rank further process the received data
+                new_matrix = new_matrices[0]
 
                 # Check the returned object
-                if not isinstance(new_matrix, numpy.ndarray):
-                    hoomd.context.msg.error("For quantity " + q + " no matrix obtainable.")
-                    raise RuntimeError("Error writing matrix quantity " + q)
                 zero_shape = True
                 for dim in new_matrix.shape:
                     if dim != 0:
@@ -330,8 +356,8 @@ class log(hoomd.analyze._analyzer):
 
                 old_size = data_set.shape[0]
 
-                data_set.resize(old_size + 1, axis=0)
-                data_set[old_size, ] = new_matrix
+                data_set.resize(old_size + new_matrices.shape[0], axis=0)
+                data_set[old_size:, ] = new_matrices
 
     # \internal
     # \brief prepare and check the hdf5 file for non-matrix quantity dump
@@ -424,12 +424,54 @@ DEVICE inline bool test_confined(const PlaneWall& wall, const ShapeSpheropolyhed
     return accept;
     }
 
+//! Flags the wall and shape pairs for which ExternalFieldWall may skip obstacle walls that are far away
+/*! An obstacle is a sphere or cylinder wall that particles must stay outside of (inside is false). For the pairs
+    flagged here, test_confined() always accepts a particle whose circumsphere does not reach the bounding box of the
+    obstacle, so the obstacle only needs to be tested when the two bounding boxes overlap. The generic
+    test_confined() rejects every placement, so pairs without a specialization must not be flagged.
+*/
+template <class WallShape, class ParticleShape>
+struct obstacle_bounded
+    {
+    static const bool value = false;
+    };
+
+template < >
+struct obstacle_bounded<SphereWall, ShapeSphere>
+    {
+    static const bool value = true;
+    };
+
+template < >
+struct obstacle_bounded<SphereWall, ShapeConvexPolyhedron>
+    {
+    static const bool value = true;
+    };
+
+template < >
+struct obstacle_bounded<SphereWall, ShapeSpheropolyhedron>
+    {
+    static const bool value = true;
+    };
+
+template < >
+struct obstacle_bounded<CylinderWall, ShapeSphere>
+    {
+    static const bool value = true;
+    };
+
+template < >
+struct obstacle_bounded<CylinderWall, ShapeConvexPolyhedron>
+    {
+    static const bool value = true;
+    };
+
 template< class Shape >
 class ExternalFieldWall : public ExternalFieldMono<Shape>
     {
         using Compute::m_pdata;
     public:
-        ExternalFieldWall(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<IntegratorHPMCMono<Shape> > mc) : ExternalFieldMono<Shape>(sysdef), m_mc(mc)
+        ExternalFieldWall(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<IntegratorHPMCMono<Shape> > mc) : ExternalFieldMono<Shape>(sysdef), m_index_valid(false), m_use_index(false), m_mc(mc)
           {
           m_box = m_pdata->getGlobalBox();
           //! scale the container walls every time the box changes
@@ -440,11 +482,23 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
           m_pdata->getBoxChangeSignal().template disconnect<ExternalFieldWall<Shape>, &ExternalFieldWall<Shape>::scaleWalls>(this);
           }
 
+        //! Rebuild the wall index before the trial moves of this step
+        void compute(unsigned int timestep)
+            {
+            updateWallIndex();
+            }
+
         double energydiff(const unsigned int& index, const vec3<Scalar>& position_old, const Shape& shape_old, const vec3<Scalar>& position_new, const Shape& shape_new)
             {
             const BoxDim& box = this->m_pdata->getGlobalBox();
             vec3<Scalar> origin(m_pdata->getOrigin());
 
+            // energydiff() may be called from several threads, so a stale index is never rebuilt here
+            if (m_index_valid && m_use_index)
+                {
+                return energydiffIndexed(position_new, shape_new, origin, box);
+                }
+
             for(size_t i = 0; i < m_Spheres.size(); i++)
                 {
                 if(!test_confined(m_Spheres[i], shape_new, position_new, origin, box))
@@ -527,6 +581,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
 
 
             m_box = newBox;
+            m_index_valid = false;
             }
 
         std::tuple<OverlapReal, vec3<OverlapReal>, bool> GetSphereWallParameters(size_t index)
@@ -620,6 +675,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             if(index >= m_Spheres.size())
                 throw std::runtime_error("Out of bounds of sphere walls.");
             m_Spheres[index] = wall;
+            m_index_valid = false;
             }
 
         void SetCylinderWallParameter(size_t index, const CylinderWall& wall)
@@ -627,6 +683,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             if(index >= m_Cylinders.size())
                 throw std::runtime_error("Out of bounds of cylinder walls.");
             m_Cylinders[index] = wall;
+            m_index_valid = false;
             }
 
         void SetPlaneWallParameter(size_t index, const PlaneWall& wall)
@@ -639,11 +696,13 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
         void SetSphereWalls(const std::vector<SphereWall>& Spheres)
             {
             m_Spheres = Spheres;
+            m_index_valid = false;
             }
 
         void SetCylinderWalls(const std::vector<CylinderWall>& Cylinders)
             {
             m_Cylinders = Cylinders;
+            m_index_valid = false;
             }
 
         void SetPlaneWalls(const std::vector<PlaneWall>& Planes)
@@ -656,6 +715,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             m_Spheres.push_back(wall);
             unsigned int wall_ind = m_Spheres.size()-1;
             m_SphereLogQuantities.push_back(getSphWallParamName(wall_ind));
+            m_index_valid = false;
             }
 
         void AddCylinderWall(const CylinderWall& wall)
@@ -663,6 +723,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             m_Cylinders.push_back(wall);
             unsigned int wall_ind = m_Cylinders.size()-1;
             m_CylinderLogQuantities.push_back(getCylWallParamName(wall_ind));
+            m_index_valid = false;
             }
 
         void AddPlaneWall(const PlaneWall& wall)
@@ -675,12 +736,14 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             {
             m_Spheres.erase(m_Spheres.begin()+index);
             m_SphereLogQuantities.erase(m_SphereLogQuantities.begin()+index);
+            m_index_valid = false;
             }
 
         void RemoveCylinderWall(size_t index)
             {
             m_Cylinders.erase(m_Cylinders.begin()+index);
             m_CylinderLogQuantities.erase(m_CylinderLogQuantities.begin()+index);
+            m_index_valid = false;
             }
 
         void RemovePlaneWall(size_t index)
@@ -732,6 +795,8 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
 
         unsigned int countOverlaps(unsigned int timestep, bool early_exit = false)
             {
+            updateWallIndex();
+
             unsigned int numOverlaps = 0;
             // access particle data and system box
             ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -796,6 +861,153 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             }
 
     protected:
+        //! Rebuild the AABB tree of the obstacle walls if the walls have changed
+        void updateWallIndex()
+            {
+            if (m_index_valid)
+                return;
+
+            m_indexed_walls.clear();
+            m_unindexed_spheres.clear();
+            m_unindexed_cylinders.clear();
+            std::vector<detail::AABB> aabbs;
+
+            // pad the bounding boxes so that round off in test_confined() cannot reach past them
+            const Scalar pad = Scalar(1.001);
+
+            // bounds along the axis of an obstacle cylinder, covering every image of every particle position
+            const BoxDim& box = m_pdata->getGlobalBox();
+            const vec3<Scalar> lo(box.getLo()), hi(box.getHi());
+            Scalar span(0.0);
+            for (unsigned int i = 0; i < 3; i++)
+                {
+                const vec3<Scalar> a(box.getLatticeVector(i));
+                span += sqrt(dot(a,a));
+                }
+            span *= Scalar(4.0);
+
+            for (size_t i = 0; i < m_Spheres.size(); i++)
+                {
+                const SphereWall& wall = m_Spheres[i];
+                if (obstacle_bounded<SphereWall, Shape>::value && !wall.inside)
+                    {
+                    aabbs.push_back(detail::AABB(vec3<Scalar>(wall.origin), pad*sqrt(Scalar(wall.rsq))));
+                    m_indexed_walls.push_back(i);
+                    }
+                else
+                    {
+                    m_unindexed_spheres.push_back(i);
+                    }
+                }
+
+            for (size_t i = 0; i < m_Cylinders.size(); i++)
+                {
+                // only cylinders along a box axis have bounds in the other two directions
+                const CylinderWall& wall = m_Cylinders[i];
+                const vec3<OverlapReal>& axis = wall.orientation;
+                const unsigned int n_axis = (axis.x != 0) + (axis.y != 0) + (axis.z != 0);
+                if (obstacle_bounded<CylinderWall, Shape>::value && !wall.inside && n_axis == 1)
+                    {
+                    const Scalar r = pad*sqrt(Scalar(wall.rsq));
+                    const vec3<Scalar> origin(wall.origin);
+                    vec3<Scalar> lower = origin - vec3<Scalar>(r,r,r);
+                    vec3<Scalar> upper = origin + vec3<Scalar>(r,r,r);
+                    if (axis.x != 0) { lower.x = lo.x - span; upper.x = hi.x + span; }
+                    if (axis.y != 0) { lower.y = lo.y - span; upper.y = hi.y + span; }
+                    if (axis.z != 0) { lower.z = lo.z - span; upper.z = hi.z + span; }
+                    aabbs.push_back(detail::AABB(lower, upper));
+                    m_indexed_walls.push_back(m_Spheres.size() + i);
+                    }
+                else
+                    {
+                    m_unindexed_cylinders.push_back(i);
+                    }
+                }
+
+            // traversing the tree for every image only pays off with many obstacles
+            m_use_index = (aabbs.size() >= 8);
+            if (m_use_index)
+                {
+                m_wall_tree.buildTree(&aabbs[0], aabbs.size());
+                }
+            m_index_valid = true;
+            }
+
+        //! Check the confinement of a particle, testing only the obstacle walls near it
+        double energydiffIndexed(const vec3<Scalar>& position_new, const Shape& shape_new, const vec3<Scalar>& origin, const BoxDim& box)
+            {
+            for (size_t k = 0; k < m_unindexed_spheres.size(); k++)
+                {
+                if (!test_confined(m_Spheres[m_unindexed_spheres[k]], shape_new, position_new, origin, box))
+                    {
+                    return INFINITY;
+                    }
+                }
+
+            for (size_t k = 0; k < m_unindexed_cylinders.size(); k++)
+                {
+                CylinderWall& wall = m_Cylinders[m_unindexed_cylinders[k]];
+                set_cylinder_wall_verts(wall, shape_new);
+                if (!test_confined(wall, shape_new, position_new, origin, box))
+                    {
+                    return INFINITY;
+                    }
+                }
+
+            for (size_t i = 0; i < m_Planes.size(); i++)
+                {
+                if (!test_confined(m_Planes[i], shape_new, position_new, origin, box))
+                    {
+                    return INFINITY;
+                    }
+                }
+
+            // test_confined() shifts the particle by at most one lattice vector along each periodic direction,
+            // so the obstacles are queried around each of those images
+            const Scalar radius = Scalar(1.001)*shape_new.getCircumsphereDiameter()/Scalar(2.0);
+            const vec3<Scalar> pos = position_new - origin;
+            const uchar3 periodic = box.getPeriodic();
+            const vec3<Scalar> a1(box.getLatticeVector(0)), a2(box.getLatticeVector(1)), a3(box.getLatticeVector(2));
+            std::vector<unsigned int> hits;
+            for (int i = -1; i <= 1; i++)
+                {
+                if (i != 0 && !periodic.x) continue;
+                for (int j = -1; j <= 1; j++)
+                    {
+                    if (j != 0 && !periodic.y) continue;
+                    for (int k = -1; k <= 1; k++)
+                        {
+                        if (k != 0 && !periodic.z) continue;
+                        const vec3<Scalar> image = pos + Scalar(i)*a1 + Scalar(j)*a2 + Scalar(k)*a3;
+                        m_wall_tree.query(hits, detail::AABB(image, radius));
+                        }
+                    }
+                }
+
+            for (size_t k = 0; k < hits.size(); k++)
+                {
+                const unsigned int wall_idx = m_indexed_walls[hits[k]];
+                if (wall_idx < m_Spheres.size())
+                    {
+                    if (!test_confined(m_Spheres[wall_idx], shape_new, position_new, origin, box))
+                        {
+                        return INFINITY;
+                        }
+                    }
+                else
+                    {
+                    CylinderWall& wall = m_Cylinders[wall_idx - m_Spheres.size()];
+                    set_cylinder_wall_verts(wall, shape_new);
+                    if (!test_confined(wall, shape_new, position_new, origin, box))
+                        {
+                        return INFINITY;
+                        }
+                    }
+                }
+
+            return double(0.0);
+            }
+
         void set_cylinder_wall_verts(CylinderWall& wall, const Shape& shape)
             {
             vec3<Scalar> v0;
@@ -832,6 +1044,13 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
         std::vector<std::string>    m_SphereLogQuantities;
         std::vector<std::string>    m_CylinderLogQuantities;
         Scalar                      m_Volume;
+
+        detail::AABBTree            m_wall_tree;            //!< AABB tree of the obstacle walls
+        std::vector<unsigned int>   m_indexed_walls;        //!< Wall of each leaf, cylinders follow the spheres
+        std::vector<unsigned int>   m_unindexed_spheres;    //!< Sphere walls that are always tested
+        std::vector<unsigned int>   m_unindexed_cylinders;  //!< Cylinder walls that are always tested
+        bool                        m_index_valid;          //!< True if the wall index matches the walls
+        bool                        m_use_index;            //!< True if the wall index is used to test the walls
     private:
         std::shared_ptr<IntegratorHPMCMono<Shape> > m_mc; //!< integrator
         BoxDim                                      m_box; //!< the current box
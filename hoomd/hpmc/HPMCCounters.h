@@ -32,6 +32,8 @@ struct hpmc_counters_t
     unsigned long long int rotate_reject_count;         //!< Count of rejected rotation moves
     unsigned long long int overlap_checks;              //!< Count of the number of overlap checks
     unsigned int overlap_err_count;                     //!< Count of the number of times overlap checks encounter errors
+    unsigned long long int interaction_reject_count;    //!< Count of overlap checks skipped by the interaction matrix
+    unsigned long long int circumsphere_reject_count;   //!< Count of overlap checks rejected by the circumsphere test
 
     //! Construct a zero set of counters
     hpmc_counters_t()
@@ -42,6 +44,8 @@ struct hpmc_counters_t
         rotate_reject_count = 0;
         overlap_checks = 0;
         overlap_err_count = 0;
+        interaction_reject_count = 0;
+        circumsphere_reject_count = 0;
         }
 
     //! Get the translate acceptance
@@ -85,6 +89,8 @@ DEVICE inline hpmc_counters_t operator-(const hpmc_counters_t& a, const hpmc_cou
     result.rotate_reject_count = a.rotate_reject_count - b.rotate_reject_count;
     result.overlap_checks = a.overlap_checks - b.overlap_checks;
     result.overlap_err_count = a.overlap_err_count - b.overlap_err_count;
+    result.interaction_reject_count = a.interaction_reject_count - b.interaction_reject_count;
+    result.circumsphere_reject_count = a.circumsphere_reject_count - b.circumsphere_reject_count;
     return result;
     }
 
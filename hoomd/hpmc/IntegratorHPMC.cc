@@ -19,7 +19,7 @@ namespace hpmc
 
 IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int seed)
-    : Integrator(sysdef, 0.005), m_seed(seed),  m_move_ratio(32768), m_nselect(4),
+    : Integrator(sysdef, 0.005), m_seed(seed),  m_move_ratio(32768), m_nselect(4), m_multi_try(1),
       m_nominal_width(1.0), m_extra_ghost_width(0), m_external_base(NULL), m_patch_log(false),
       m_past_first_run(false)
       #ifdef ENABLE_MPI
@@ -104,6 +104,8 @@ void IntegratorHPMC::slotNumTypesChange()
     - hpmc_a_<typename> (maximum rotation move by type)
     - hpmc_move_ratio (ratio of translation moves to rotate moves)
     - hpmc_overlap_count (count of the number of particle-particle overlaps)
+    - hpmc_interaction_reject_fraction (Fraction of overlap checks in the last step skipped by the interaction matrix)
+    - hpmc_circumsphere_reject_fraction (Fraction of overlap checks in the last step rejected by circumspheres)
 
     \returns a list of provided quantities
 */
@@ -119,6 +121,8 @@ std::vector< std::string > IntegratorHPMC::getProvidedLogQuantities()
     result.push_back("hpmc_a");
     result.push_back("hpmc_move_ratio");
     result.push_back("hpmc_overlap_count");
+    result.push_back("hpmc_interaction_reject_fraction");
+    result.push_back("hpmc_circumsphere_reject_fraction");
     for (unsigned int typ=0; typ<m_pdata->getNTypes();typ++)
       {
       ostringstream tmp_str0;
@@ -171,6 +175,18 @@ Scalar IntegratorHPMC::getLogValue(const std::string& quantity, unsigned int tim
         {
         return countOverlaps(timestep, false);
         }
+    else if (quantity == "hpmc_interaction_reject_fraction")
+        {
+        if (counters.overlap_checks == 0)
+            return 0.0;
+        return double(counters.interaction_reject_count) / double(counters.overlap_checks);
+        }
+    else if (quantity == "hpmc_circumsphere_reject_fraction")
+        {
+        if (counters.overlap_checks == 0)
+            return 0.0;
+        return double(counters.circumsphere_reject_count) / double(counters.overlap_checks);
+        }
     else
         {
         //loop over per particle move size quantities
@@ -305,6 +321,8 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
         MPI_Allreduce(MPI_IN_PLACE, &result.rotate_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         MPI_Allreduce(MPI_IN_PLACE, &result.overlap_checks, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         MPI_Allreduce(MPI_IN_PLACE, &result.overlap_err_count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &result.interaction_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &result.circumsphere_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         }
 #endif
     return result;
@@ -322,6 +340,8 @@ void export_IntegratorHPMC(py::module& m)
     .def("getA", &IntegratorHPMC::getA)
     .def("getMoveRatio", &IntegratorHPMC::getMoveRatio)
     .def("getNSelect", &IntegratorHPMC::getNSelect)
+    .def("setMultiTry", &IntegratorHPMC::setMultiTry)
+    .def("getMultiTry", &IntegratorHPMC::getMultiTry)
     .def("getMaxCoreDiameter", &IntegratorHPMC::getMaxCoreDiameter)
     .def("countOverlaps", &IntegratorHPMC::countOverlaps)
     .def("checkParticleOrientations", &IntegratorHPMC::checkParticleOrientations)
@@ -339,6 +359,8 @@ void export_IntegratorHPMC(py::module& m)
     .def_readwrite("rotate_accept_count", &hpmc_counters_t::rotate_accept_count)
     .def_readwrite("rotate_reject_count", &hpmc_counters_t::rotate_reject_count)
     .def_readwrite("overlap_checks", &hpmc_counters_t::overlap_checks)
+    .def_readwrite("interaction_reject_count", &hpmc_counters_t::interaction_reject_count)
+    .def_readwrite("circumsphere_reject_count", &hpmc_counters_t::circumsphere_reject_count)
     .def("getTranslateAcceptance", &hpmc_counters_t::getTranslateAcceptance)
     .def("getRotateAcceptance", &hpmc_counters_t::getRotateAcceptance)
     .def("getNMoves", &hpmc_counters_t::getNMoves)
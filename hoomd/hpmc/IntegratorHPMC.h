@@ -191,6 +191,26 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
             return m_nselect;
             }
 
+        //! Set the number of candidate moves per selected particle
+        /*! \param multi_try Number of candidate moves, 1 disables multiple-try Metropolis
+        */
+        void setMultiTry(unsigned int multi_try)
+            {
+            if (multi_try == 0)
+                {
+                m_exec_conf->msg->error() << "integrate.mode_hpmc: multi_try must be at least 1" << std::endl;
+                throw std::runtime_error("Error setting HPMC parameters");
+                }
+            m_multi_try = multi_try;
+            }
+
+        //! Get the number of candidate moves per selected particle
+        //! \returns current value of multi_try parameter
+        inline unsigned int getMultiTry()
+            {
+            return m_multi_try;
+            }
+
         //! Print statistics about the hmc steps taken
         virtual void printStats()
             {
@@ -346,6 +366,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         unsigned int m_seed;                        //!< Random number seed
         unsigned int m_move_ratio;                  //!< Ratio of translation to rotation move attempts (*65535)
         unsigned int m_nselect;                     //!< Number of particles to select for trial moves
+        unsigned int m_multi_try;                   //!< Number of candidate moves per selection (multiple-try Metropolis)
 
         GPUVector<Scalar> m_d;                      //!< Maximum move displacement by type
         GPUVector<Scalar> m_a;                      //!< Maximum angular displacement by type
@@ -314,6 +314,25 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
         void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
 
+        //! Test if the AABB tree can be modified in place when a single particle is added, removed or changed
+        bool canModifyAABBTree() const
+            {
+            bool can_modify = !m_aabb_tree_invalid && m_aabb_tree.getNumNodes() > 0 && m_pdata->getNGhosts() == 0;
+            #ifdef ENABLE_MPI
+            can_modify = can_modify && !m_pdata->getDomainDecomposition();
+            #endif
+            return can_modify;
+            }
+
+        //! Add the particle at the end of the local particle data to the AABB tree
+        void insertAABBTreeParticle(unsigned int idx);
+
+        //! Remove a particle from the AABB tree
+        void removeAABBTreeParticle(unsigned int idx, unsigned int last_idx);
+
+        //! Update the AABB of a single particle in the tree
+        void updateAABBTreeParticle(unsigned int idx);
+
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
         int slotWriteGSDState(gsd_handle&, std::string name) const;
 
@@ -373,12 +392,47 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
+        std::vector<unsigned int> m_overlap_mask;   //!< Interaction matrix packed into one bit per type pair
+        unsigned int m_overlap_mask_pitch;          //!< Number of words per row of m_overlap_mask
+        std::vector<OverlapReal> m_pair_circumsphere_sq; //!< Squared sum of circumsphere radii per type pair
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
         //! Grow the m_aabbs list
         virtual void growAABBList(unsigned int N);
 
+        //! Compute the AABB of a particle
+        inline detail::AABB computeParticleAABB(const Scalar4& postype, const Scalar4& orientation) const;
+
+        //! Precompute the per type pair data used to reject overlap checks early
+        void updateTypePairData();
+
+        //! Test a pair of particles for overlap, rejecting with per type pair data before the full test
+        inline bool testPairOverlap(const vec3<Scalar>& r_ij,
+                                    const Shape& shape_i,
+                                    unsigned int typ_i,
+                                    unsigned int typ_j,
+                                    const quat<Scalar>& orientation_j,
+                                    hpmc_counters_t& counters) const;
+
+        //! Test a trial configuration of a particle for overlaps with its neighbors
+        inline bool checkTrialOverlap(unsigned int i,
+                                      const vec3<Scalar>& pos_i,
+                                      const Shape& shape_i,
+                                      const Scalar4 *h_postype,
+                                      const Scalar4 *h_orientation,
+                                      hpmc_counters_t& counters);
+
+        //! Attempt a multiple-try Metropolis move of a single particle
+        inline bool multiTryMove(unsigned int i,
+                                 bool move_type_translate,
+                                 Scalar move_size,
+                                 hoomd::RandomGenerator& rng_i,
+                                 Scalar4 *h_postype,
+                                 Scalar4 *h_orientation,
+                                 hpmc_counters_t& counters);
+
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
@@ -407,7 +461,8 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_image_list_is_initialized(false),
               m_image_list_valid(false),
               m_hasOrientation(true),
-              m_extra_image_width(0.0)
+              m_extra_image_width(0.0),
+              m_overlap_mask_pitch(0)
     {
     // allocate the parameter storage
     m_params = std::vector<param_type, managed_allocator<param_type> >(m_pdata->getNTypes(), param_type(), managed_allocator<param_type>(m_exec_conf->isCUDAEnabled()));
@@ -577,6 +632,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     m_update_order.resize(m_pdata->getN());
     m_update_order.shuffle(timestep);
 
+    if (m_multi_try > 1 && m_patch && !m_patch_log)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_hpmc: multi_try > 1 is not supported with patch energies"
+                                  << std::endl;
+        throw std::runtime_error("Error in HPMC update");
+        }
+
     // update the AABB Tree
     buildAABBTree();
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
@@ -591,8 +653,8 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
         m_external->compute(timestep);
         }
 
-    // access interaction matrix
-    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+    // shape updaters may change the parameters between steps, so refresh the type pair data every step
+    updateTypePairData();
 
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
@@ -636,6 +698,31 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             Shape shape_old(quat<Scalar>(orientation_i), m_params[typ_i]);
             vec3<Scalar> pos_old = pos_i;
 
+            if (m_multi_try > 1)
+                {
+                // evaluate several candidate moves at once with the multiple-try Metropolis rule
+                Scalar move_size = move_type_translate ? h_d.data[typ_i] : h_a.data[typ_i];
+                bool accept = true;
+                if (move_size != 0.0)
+                    {
+                    accept = multiTryMove(i, move_type_translate, move_size, rng_i, h_postype.data,
+                                          h_orientation.data, counters);
+                    }
+
+                if (!shape_i.ignoreStatistics())
+                    {
+                    if (move_type_translate && accept)
+                        counters.translate_accept_count++;
+                    else if (move_type_translate)
+                        counters.translate_reject_count++;
+                    else if (accept)
+                        counters.rotate_accept_count++;
+                    else
+                        counters.rotate_reject_count++;
+                    }
+                continue;
+                }
+
             if (move_type_translate)
                 {
                 // skip if no overlap check is required
@@ -736,16 +823,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                                 vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
                                 unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
 
                                 Scalar rcut = 0.0;
                                 if (m_patch)
                                     rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
                                 counters.overlap_checks++;
-                                if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                if (testPairOverlap(r_ij, shape_i, typ_i, typ_j, quat<Scalar>(orientation_j), counters))
                                     {
                                     overlap = true;
                                     break;
@@ -1545,17 +1629,7 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                 for (unsigned int cur_particle = 0; cur_particle < n_aabb; cur_particle++)
                     {
                     unsigned int i = cur_particle;
-                    unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
-                    Shape shape(quat<Scalar>(h_orientation.data[i]), m_params[typ_i]);
-
-                    if (!this->m_patch)
-                        m_aabbs[i] = shape.getAABB(vec3<Scalar>(h_postype.data[i]));
-                    else
-                        {
-                        Scalar radius = std::max(0.5*shape.getCircumsphereDiameter(),
-                            0.5*this->m_patch->getAdditiveCutoff(typ_i));
-                        m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
-                        }
+                    m_aabbs[i] = computeParticleAABB(h_postype.data[i], h_orientation.data[i]);
                     }
                 m_aabb_tree.buildTree(m_aabbs, n_aabb);
                 }
@@ -1568,6 +1642,390 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     return m_aabb_tree;
     }
 
+/*! \param postype Position and type of the particle
+    \param orientation Orientation of the particle
+    \returns The AABB of the particle as stored in the AABB tree
+*/
+template <class Shape>
+inline detail::AABB IntegratorHPMCMono<Shape>::computeParticleAABB(const Scalar4& postype,
+                                                                   const Scalar4& orientation) const
+    {
+    unsigned int typ_i = __scalar_as_int(postype.w);
+    Shape shape(quat<Scalar>(orientation), m_params[typ_i]);
+
+    if (!this->m_patch)
+        return shape.getAABB(vec3<Scalar>(postype));
+
+    Scalar radius = std::max(0.5*shape.getCircumsphereDiameter(),
+        0.5*this->m_patch->getAdditiveCutoff(typ_i));
+    return detail::AABB(vec3<Scalar>(postype), radius);
+    }
+
+/*! \param idx Local index of the new particle
+
+    Call only when canModifyAABBTree() returned true right before the particle was appended to the particle data.
+    Adding a particle emits the particle sort signal, which invalidates the tree. If the particle can be inserted
+    into the existing tree, the tree is marked as valid again. Otherwise, it is rebuilt on the next call to
+    buildAABBTree().
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::insertAABBTreeParticle(unsigned int idx)
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+    detail::AABB aabb = computeParticleAABB(h_postype.data[idx], h_orientation.data[idx]);
+    m_aabb_tree_invalid = !m_aabb_tree.insert(idx, aabb);
+    }
+
+/*! \param idx Local index of the removed particle
+    \param last_idx Local index of the last particle before the removal
+
+    ParticleData::removeParticle() moves the last particle into the slot of the removed one. Call only when
+    canModifyAABBTree() returned true right before the particle was removed.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::removeAABBTreeParticle(unsigned int idx, unsigned int last_idx)
+    {
+    m_aabb_tree.remove(idx);
+    if (idx != last_idx)
+        m_aabb_tree.relabel(last_idx, idx);
+    m_aabb_tree_invalid = false;
+    }
+
+/*! \param idx Local index of the particle
+
+    Use after a change of the particle's type or orientation. Call only when canModifyAABBTree() returned true right
+    before the particle was changed.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateAABBTreeParticle(unsigned int idx)
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+    m_aabb_tree.update(idx, computeParticleAABB(h_postype.data[idx], h_orientation.data[idx]));
+    m_aabb_tree_invalid = false;
+    }
+
+/*! The interaction matrix is packed into a bit mask with one row of 32-bit words per type, and the squared sum
+    of the circumsphere radii is stored for each type pair. testPairOverlap() uses both to reject most pairs without
+    constructing the shape of the neighbor particle.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateTypePairData()
+    {
+    unsigned int ntypes = m_pdata->getNTypes();
+
+    std::vector<OverlapReal> circumsphere_radius(ntypes);
+    quat<Scalar> q;
+    for (unsigned int typ = 0; typ < ntypes; typ++)
+        {
+        Shape shape(q, m_params[typ]);
+        circumsphere_radius[typ] = shape.getCircumsphereDiameter()/OverlapReal(2.0);
+        }
+
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+
+    m_overlap_mask_pitch = (ntypes + 31) / 32;
+    m_overlap_mask.assign(ntypes*m_overlap_mask_pitch, 0);
+    m_pair_circumsphere_sq.resize(m_overlap_idx.getNumElements());
+
+    for (unsigned int typ_i = 0; typ_i < ntypes; typ_i++)
+        {
+        for (unsigned int typ_j = 0; typ_j < ntypes; typ_j++)
+            {
+            if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)])
+                m_overlap_mask[typ_i*m_overlap_mask_pitch + typ_j/32] |= 1u << (typ_j % 32);
+
+            OverlapReal R = circumsphere_radius[typ_i] + circumsphere_radius[typ_j];
+            m_pair_circumsphere_sq[m_overlap_idx(typ_i, typ_j)] = R*R;
+            }
+        }
+    }
+
+/*! \param r_ij Vector from particle i to particle j
+    \param shape_i Shape of particle i
+    \param typ_i Type of particle i
+    \param typ_j Type of particle j
+    \param orientation_j Orientation of particle j
+    \param counters Counters to increment
+    \returns true if the particles overlap
+
+    Overlap checks are performed in tiers of increasing cost. Pairs for which the interaction matrix disables overlap
+    checks are skipped first, then pairs with disjoint circumspheres are rejected. Only the remaining pairs construct
+    the shape of particle j and run the full overlap test. updateTypePairData() must have been called before.
+*/
+template <class Shape>
+inline bool IntegratorHPMCMono<Shape>::testPairOverlap(const vec3<Scalar>& r_ij,
+                                                       const Shape& shape_i,
+                                                       unsigned int typ_i,
+                                                       unsigned int typ_j,
+                                                       const quat<Scalar>& orientation_j,
+                                                       hpmc_counters_t& counters) const
+    {
+    if (!(m_overlap_mask[typ_i*m_overlap_mask_pitch + typ_j/32] & (1u << (typ_j % 32))))
+        {
+        counters.interaction_reject_count++;
+        return false;
+        }
+
+    if (OverlapReal(dot(r_ij, r_ij)) > m_pair_circumsphere_sq[m_overlap_idx(typ_i, typ_j)])
+        {
+        counters.circumsphere_reject_count++;
+        return false;
+        }
+
+    // the precomputed circumsphere test above replaces check_circumsphere_overlap()
+    Shape shape_j(orientation_j, m_params[typ_j]);
+    return test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count);
+    }
+
+/*! \param i Index of the particle
+    \param pos_i Trial position of the particle
+    \param shape_i Trial shape (orientation) of the particle
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param counters Counters to increment
+    \returns true if the particle in its trial configuration overlaps with any other particle or its own images
+
+    The particle data is only read, so multiple trial configurations can be tested concurrently.
+*/
+template <class Shape>
+inline bool IntegratorHPMCMono<Shape>::checkTrialOverlap(unsigned int i,
+                                                         const vec3<Scalar>& pos_i,
+                                                         const Shape& shape_i,
+                                                         const Scalar4 *h_postype,
+                                                         const Scalar4 *h_orientation,
+                                                         hpmc_counters_t& counters)
+    {
+    unsigned int typ_i = __scalar_as_int(h_postype[i].w);
+
+    detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+
+    const unsigned int n_images = m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                        {
+                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        quat<Scalar> orientation_j;
+
+                        if (j != i)
+                            {
+                            postype_j = h_postype[j];
+                            orientation_j = quat<Scalar>(h_orientation[j]);
+                            }
+                        else
+                            {
+                            // in the first image, skip i == j
+                            if (cur_image == 0)
+                                continue;
+
+                            // in an outside image, use the trial position and orientation
+                            postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, h_postype[i].w);
+                            orientation_j = shape_i.orientation;
+                            }
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                        counters.overlap_checks++;
+                        if (testPairOverlap(r_ij, shape_i, typ_i, typ_j, orientation_j, counters))
+                            return true;
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            }  // end loop over AABB nodes
+        } // end loop over images
+
+    return false;
+    }
+
+/*! \param i Index of the particle
+    \param move_type_translate True for translation moves, false for rotation moves
+    \param move_size Maximum displacement or rotation
+    \param rng_i Random number generator of this particle's trial move
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param counters Counters to increment
+    \returns true if the move was accepted
+
+    Multiple-try Metropolis (J. S. Liu, F. Liang, and W. H. Wong, J. Am. Stat. Assoc. 95, 121-134 (2000)) with
+    symmetric proposals. k = m_multi_try candidate configurations are generated around the old configuration x and
+    their weights w (zero when overlapping, otherwise the Boltzmann factor of the external field) are computed. The
+    overlap checks run concurrently, the external field is evaluated serially afterwards. One candidate y is selected
+    with probability proportional to its weight. Then k-1 reference configurations are generated around y and,
+    together with x, weighted in the same way. The move to y is accepted with probability
+    min(1, sum w(candidates) / sum w(references)).
+
+    All random numbers are drawn serially from rng_i, so the result does not depend on the number of threads.
+*/
+template <class Shape>
+inline bool IntegratorHPMCMono<Shape>::multiTryMove(unsigned int i,
+                                                    bool move_type_translate,
+                                                    Scalar move_size,
+                                                    hoomd::RandomGenerator& rng_i,
+                                                    Scalar4 *h_postype,
+                                                    Scalar4 *h_orientation,
+                                                    hpmc_counters_t& counters)
+    {
+    const unsigned int k = m_multi_try;
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+
+    Scalar4 postype_i = h_postype[i];
+    unsigned int typ_i = __scalar_as_int(postype_i.w);
+    vec3<Scalar> pos_old(postype_i);
+    Shape shape_old(quat<Scalar>(h_orientation[i]), m_params[typ_i]);
+
+    #ifdef ENABLE_MPI
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 ghost_fraction = m_nominal_width / box.getNearestPlaneDistance();
+    #endif
+
+    // trial configurations, the first k are the candidates and the next k-1 the references
+    std::vector< vec3<Scalar> > pos_trial(2*k-1, pos_old);
+    std::vector< quat<Scalar> > orientation_trial(2*k-1, shape_old.orientation);
+    std::vector<double> weight(2*k-1, 0.0);
+    std::vector<hpmc_counters_t> trial_counters(2*k-1);
+
+    // compute the weights of the trial configurations in [begin, end)
+    auto compute_weights = [&](unsigned int begin, unsigned int end)
+        {
+        #ifdef ENABLE_TBB
+        tbb::parallel_for(begin, end, [&] (unsigned int t)
+        #else
+        for (unsigned int t = begin; t < end; t++)
+        #endif
+            {
+            Shape shape_t(orientation_trial[t], m_params[typ_i]);
+
+            bool allowed = true;
+
+            #ifdef ENABLE_MPI
+            // configurations in the ghost layer are not allowed
+            if (m_comm)
+                allowed = isActive(vec_to_scalar3(pos_trial[t]), box, ghost_fraction);
+            #endif
+
+            if (!allowed || checkTrialOverlap(i, pos_trial[t], shape_t, h_postype, h_orientation, trial_counters[t]))
+                weight[t] = 0.0;
+            else
+                weight[t] = 1.0;
+            }
+        #ifdef ENABLE_TBB
+            );
+        #endif
+
+        // external fields may call into python or update internal state, evaluate them serially
+        if (m_external)
+            {
+            for (unsigned int t = begin; t < end; t++)
+                {
+                if (weight[t] == 0.0)
+                    continue;
+
+                Shape shape_t(orientation_trial[t], m_params[typ_i]);
+                double energy = m_external->energydiff(i, pos_old, shape_old, pos_trial[t], shape_t);
+                weight[t] = slow::exp(-energy);
+                }
+            }
+        };
+
+    // generate the candidates around the old configuration
+    for (unsigned int t = 0; t < k; t++)
+        {
+        if (move_type_translate)
+            move_translate(pos_trial[t], rng_i, move_size, ndim);
+        else
+            move_rotate(orientation_trial[t], rng_i, move_size, ndim);
+        }
+    compute_weights(0, k);
+
+    double weight_new = 0.0;
+    for (unsigned int t = 0; t < k; t++)
+        weight_new += weight[t];
+
+    bool accept = false;
+    unsigned int selected = 0;
+
+    if (weight_new > 0.0)
+        {
+        // select a candidate with probability proportional to its weight
+        double r = hoomd::detail::generate_canonical<double>(rng_i) * weight_new;
+        double cumulative = 0.0;
+        for (selected = 0; selected < k-1; selected++)
+            {
+            cumulative += weight[selected];
+            if (weight[selected] > 0.0 && r < cumulative)
+                break;
+            }
+        while (weight[selected] == 0.0)
+            selected--;
+
+        // generate the references around the selected candidate, the old configuration is the last reference
+        for (unsigned int t = k; t < 2*k-1; t++)
+            {
+            pos_trial[t] = pos_trial[selected];
+            orientation_trial[t] = orientation_trial[selected];
+            if (move_type_translate)
+                move_translate(pos_trial[t], rng_i, move_size, ndim);
+            else
+                move_rotate(orientation_trial[t], rng_i, move_size, ndim);
+            }
+        compute_weights(k, 2*k-1);
+
+        // the old configuration is valid and has the reference energy
+        double weight_old = 1.0;
+        for (unsigned int t = k; t < 2*k-1; t++)
+            weight_old += weight[t];
+
+        accept = hoomd::detail::generate_canonical<double>(rng_i) * weight_old < weight_new;
+        }
+
+    for (unsigned int t = 0; t < 2*k-1; t++)
+        {
+        counters.overlap_checks += trial_counters[t].overlap_checks;
+        counters.overlap_err_count += trial_counters[t].overlap_err_count;
+        counters.interaction_reject_count += trial_counters[t].interaction_reject_count;
+        counters.circumsphere_reject_count += trial_counters[t].circumsphere_reject_count;
+        }
+
+    if (accept)
+        {
+        Shape shape_new(orientation_trial[selected], m_params[typ_i]);
+
+        // update the position of the particle in the tree for future updates
+        m_aabb_tree.update(i, shape_new.getAABB(pos_trial[selected]));
+
+        h_postype[i] = make_scalar4(pos_trial[selected].x, pos_trial[selected].y, pos_trial[selected].z, postype_i.w);
+        if (shape_new.hasOrientation())
+            h_orientation[i] = quat_to_scalar4(shape_new.orientation);
+        }
+
+    return accept;
+    }
+
 /*! Call to reduce the m_d values down to safe levels for the bvh tree + small box limitations. That code path
     will not work if particles can wander more than one image in a time step.
 
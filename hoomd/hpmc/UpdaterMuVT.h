@@ -743,6 +743,9 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                         // create a new particle with given type
                         unsigned int tag;
 
+                        // the AABB tree only needs to be patched if it is up to date before the insertion
+                        bool modify_tree = m_mc->canModifyAABBTree();
+
                         tag = m_pdata->addParticle(type);
 
                         // set the position of the particle
@@ -756,6 +759,11 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
                             {
                             m_pdata->setOrientation(tag, quat_to_scalar4(shape_test.orientation));
                             }
+
+                        // add the new particle to the AABB tree instead of rebuilding it
+                        if (modify_tree)
+                            m_mc->insertAABBTreeParticle(m_pdata->getRTag(tag));
+
                         m_count_total.insert_accept_count++;
                         }
                     else
@@ -884,8 +892,17 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
 
                 if (accept)
                     {
+                    // the AABB tree only needs to be patched if it is up to date before the removal
+                    bool modify_tree = m_mc->canModifyAABBTree();
+                    unsigned int idx = m_pdata->getRTag(tag);
+                    unsigned int last_idx = m_pdata->getN()-1;
+
                     // remove particle
                     m_pdata->removeParticle(tag);
+
+                    // removeParticle() moves the last particle into the slot of the removed one
+                    if (modify_tree)
+                        m_mc->removeAABBTreeParticle(idx, last_idx);
                     m_count_total.remove_accept_count++;
                     }
                 else
@@ -1016,12 +1033,18 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
 
                     if (accept)
                         {
+                        // the AABB tree only needs to be patched if it is up to date before the change
+                        bool modify_tree = m_mc->canModifyAABBTree();
+
                         // update the type
                         m_pdata->setType(tag, other_type);
 
                         // we have changed types, notify particle data
                         m_pdata->notifyParticleSort();
 
+                        if (modify_tree)
+                            m_mc->updateAABBTreeParticle(m_pdata->getRTag(tag));
+
                         m_count_total.exchange_accept_count++;
                         }
                     else
@@ -1112,12 +1135,18 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
 
                     if (accept)
                         {
+                        // the AABB tree only needs to be patched if it is up to date before the change
+                        bool modify_tree = m_mc->canModifyAABBTree();
+
                         // update the type
                         m_pdata->setType(tag, type);
 
                         // we have changed types, notify particle data
                         m_pdata->notifyParticleSort();
 
+                        if (modify_tree)
+                            m_mc->updateAABBTreeParticle(m_pdata->getRTag(tag));
+
                         m_count_total.exchange_accept_count++;
                         }
                     else
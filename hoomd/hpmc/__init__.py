@@ -20,6 +20,10 @@ The following quantities are provided by the integrator for use in HOOMD-blue's
 - ``hpmc_a`` - Maximum rotation move
 - ``hpmc_move_ratio`` - Probability of making a translation move (1- P(rotate move))
 - ``hpmc_overlap_count`` - Count of the number of particle-particle overlaps in the current system configuration
+- ``hpmc_interaction_reject_fraction`` - Fraction of overlap checks skipped because the interaction matrix disables
+  them for the type pair (averaged only over the last time step, CPU only)
+- ``hpmc_circumsphere_reject_fraction`` - Fraction of overlap checks rejected by the type pair circumsphere test before
+  the full shape overlap test (averaged only over the last time step, CPU only)
 
 With non-interacting depletant (**implicit=True**), the following log quantities are available:
 
@@ -176,6 +176,10 @@ class mode_hpmc(_integrator):
         init.read_gsd(...)
         mc = hoomd.hpmc.shape(..., restore_state=True)
 
+    Checkpoints written by :py:class:`hoomd.dump.checkpoint` hold the move sizes *d* and *a* (see
+    :py:meth:`hoomd.dump.checkpoint.dump_state`), but not the shape parameters, which must be set again after
+    :py:func:`hoomd.init.read_checkpoint`.
+
     See the *State data* section of the `HOOMD GSD schema <http://gsd.readthedocs.io/en/latest/schema-hoomd.html>`_ for
     details on GSD data chunk names and how the data are stored.
 
@@ -231,6 +235,7 @@ class mode_hpmc(_integrator):
         data['a'] = self.get_a()
         data['move_ratio'] = self.get_move_ratio()
         data['nselect'] = self.get_nselect()
+        data['multi_try'] = self.cpp_integrator.getMultiTry()
         shape_dict = {};
         for key in self.shape_param.keys():
             shape_dict[key] = self.shape_param[key].get_metadata();
@@ -306,10 +311,26 @@ class mode_hpmc(_integrator):
     def restore_state(self):
         super(mode_hpmc, self).restore_state()
 
-        # if restore state succeeds, all shape information is set
+        # if restore state from a gsd file succeeds, all shape information is set
         # set the python level is_set flags to notify this
-        for type in self.shape_param.keys():
-            self.shape_param[type].is_set = True;
+        if isinstance(hoomd.context.current.state_reader, _hoomd.GSDReader):
+            for type in self.shape_param.keys():
+                self.shape_param[type].is_set = True;
+
+    def _connect_checkpoint(self, checkpoint):
+        # This is an internal method, and should not be called directly. See checkpoint.dump_state() instead
+        pdata = hoomd.context.current.system_definition.getParticleData();
+        name = self._gsd_state_name();
+        checkpoint.cpp_analyzer.state[name + 'd'] = lambda step: [self.cpp_integrator.getD(i) for i in range(pdata.getNTypes())];
+        checkpoint.cpp_analyzer.state[name + 'a'] = lambda step: [self.cpp_integrator.getA(i) for i in range(pdata.getNTypes())];
+
+    def _restore_checkpoint(self, reader):
+        # This is an internal method, and should not be called directly. See restore_state() instead
+        name = self._gsd_state_name();
+        for (i, d) in enumerate(reader.getState(name + 'd')):
+            self.cpp_integrator.setD(d, i);
+        for (i, a) in enumerate(reader.getState(name + 'a')):
+            self.cpp_integrator.setA(a, i);
 
     def setup_pos_writer(self, pos, colors={}):
         R""" Set pos_writer definitions for specified shape parameters.
@@ -391,7 +412,8 @@ class mode_hpmc(_integrator):
                    nR=None,
                    depletant_type=None,
                    ntrial=None,
-                   deterministic=None):
+                   deterministic=None,
+                   multi_try=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
@@ -404,6 +426,13 @@ class mode_hpmc(_integrator):
             ntrial (int): (if set) **Implicit depletants only**: Number of re-insertion attempts per overlapping depletant.
                 (Only supported with **depletant_mode='circumsphere'**)
             deterministic (bool): (if set) Make HPMC integration deterministic on the GPU by sorting the cell list.
+            multi_try (int): (if set) Number of candidate moves evaluated concurrently for each selected particle.
+                Values larger than 1 enable multiple-try Metropolis acceptance (CPU only, not supported with
+                implicit depletants or patch energies).
+
+        .. tip:: For expensive shapes such as polyhedra, unions and sphinx particles, *multi_try* > 1 exposes
+                 parallelism within a single particle update when the number of particles per rank is small.
+                 Each accepted move then costs 2*multi_try-1 overlap evaluations.
 
         .. note:: Simulations are only deterministic with respect to the same execution configuration (CPU or GPU) and
                   number of MPI ranks. Simulation output will not be identical if either of these is changed.
@@ -458,6 +487,12 @@ class mode_hpmc(_integrator):
         if deterministic is not None:
             self.cpp_integrator.setDeterministic(deterministic);
 
+        if multi_try is not None:
+            if hoomd.context.exec_conf.isCUDAEnabled() or self.implicit:
+                hoomd.context.msg.warning("multi_try is only supported on the CPU without implicit depletants. Ignoring.\n")
+            else:
+                self.cpp_integrator.setMultiTry(multi_try);
+
     def map_overlaps(self):
         R""" Build an overlap map of the system
 
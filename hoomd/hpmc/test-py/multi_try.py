@@ -0,0 +1,38 @@
+from __future__ import print_function
+from __future__ import division
+from hoomd import *
+from hoomd import hpmc
+import unittest
+
+context.initialize()
+
+class test_multi_try(unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.5), n=[4,4,4])
+
+    def test_polyhedron(self):
+        mc = hpmc.integrate.convex_polyhedron(seed=10, d=0.2, a=0.2)
+        cube_verts=[(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5), (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+                    (0.5, -0.5, -0.5), (0.5, -0.5, 0.5), (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)]
+        mc.shape_param.set('A', vertices=cube_verts)
+
+        mc.set_params(multi_try=4)
+        self.assertEqual(mc.get_metadata()['multi_try'], 4)
+
+        run(100)
+
+        # moves are attempted and accepted without creating overlaps
+        self.assertGreater(mc.get_translate_acceptance(), 0)
+        self.assertGreater(mc.get_rotate_acceptance(), 0)
+        self.assertEqual(mc.count_overlaps(), 0)
+
+    def test_invalid(self):
+        mc = hpmc.integrate.sphere(seed=10)
+        mc.shape_param.set('A', diameter=1.0)
+        self.assertRaises(RuntimeError, mc.set_params, multi_try=0)
+
+    def tearDown(self):
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
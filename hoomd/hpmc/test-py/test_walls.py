@@ -604,5 +604,56 @@ class sphere_wall_tetrahedron_specific_test(unittest.TestCase):
         del self.ext_wall
         context.initialize()
 
+class obstacle_wall_sphere_test(unittest.TestCase):
+    def setUp(self):
+        self.system = create_empty(N=1, box=data.boxdim(L=20, dimensions=3), particle_types=['A'])
+        self.mc = hpmc.integrate.sphere(seed=10)
+        self.mc.shape_param.set('A', diameter=1.0)
+
+        # enough obstacles that the walls are tested through the AABB tree
+        self.ext_wall = hpmc.field.wall(self.mc)
+        for x in (-9.5, -5, 0, 5):
+            for y in (-9.5, -5, 0, 5):
+                self.ext_wall.add_sphere_wall(1.0, origin=[x,y,0], inside=False)
+        self.ext_wall.add_cylinder_wall(0.5, [-7.5,2.5,0], [0,0,1], inside=False)
+        self.ext_wall.add_cylinder_wall(0.5, [2.5,-7.5,0], [0,0,1], inside=False)
+
+    def test(self):
+        run(1, quiet=True)
+        # 1. a particle inside a sphere obstacle overlaps
+        self.system.particles[0].position = (0,0,0)
+        self.assertEqual(self.ext_wall.count_overlaps(), 1)
+
+        # 2. a particle between the obstacles does not
+        self.system.particles[0].position = (2.5,2.5,0)
+        self.assertEqual(self.ext_wall.count_overlaps(), 0)
+
+        # 3. a particle overlaps an obstacle through the periodic boundary
+        self.system.particles[0].position = (9.8,0,0)
+        self.assertEqual(self.ext_wall.count_overlaps(), 1)
+
+        # 4. cylinder obstacles extend along their axis
+        self.system.particles[0].position = (-7.5,2.5,6)
+        self.assertEqual(self.ext_wall.count_overlaps(), 1)
+        self.system.particles[0].position = (-7.5,3.7,6)
+        self.assertEqual(self.ext_wall.count_overlaps(), 0)
+
+        # 5. moving an obstacle updates the tree
+        self.ext_wall.set_sphere_wall(0, 1.0, origin=[-7.5,3.7,6], inside=False)
+        self.assertEqual(self.ext_wall.count_overlaps(), 1)
+        self.ext_wall.set_sphere_wall(0, 1.0, origin=[-9.5,-9.5,0], inside=False)
+
+        # 6. the particle moves without entering any obstacle
+        self.system.particles[0].position = (2.5,2.5,0)
+        run(100)
+        self.assertTrue(self.system.particles[0].position != (2.5,2.5,0))
+        self.assertEqual(self.ext_wall.count_overlaps(), 0)
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        del self.ext_wall
+        context.initialize()
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
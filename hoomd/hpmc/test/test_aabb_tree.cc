@@ -106,3 +106,69 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST( insert_remove )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(2);
+
+    // build a test AABB tree big enough to exercise the node merging
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    unsigned int num_nodes = tree.getNumNodes();
+
+    // remove half of the particles, moving the last particle into the empty slot like ParticleData does
+    unsigned int n = N;
+    for (unsigned int k = 0; k < N/2; k++)
+        {
+        unsigned int i = hoomd::UniformIntDistribution(n-1)(rng);
+        tree.remove(i);
+        if (i != n-1)
+            {
+            tree.relabel(n-1, i);
+            points[i] = points[n-1];
+            }
+        n--;
+        }
+
+    // insert new particles until the tree asks for a rebuild
+    unsigned int n_inserted = 0;
+    while (n < N)
+        {
+        points[n] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                                 * Scalar(100);
+        if (!tree.insert(n, AABB(points[n], Scalar(1.0))))
+            break;
+        n++;
+        n_inserted++;
+        }
+
+    UP_ASSERT(n_inserted > 0);
+
+    // no nodes are allocated by insert and remove
+    UP_ASSERT_EQUAL(tree.getNumNodes(), num_nodes);
+
+    // every remaining particle must be found exactly once, and removed indices must not be found
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < n; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT_EQUAL(std::count(hits.begin(), hits.end(), i), 1);
+        for (unsigned int j = 0; j < hits.size(); j++)
+            UP_ASSERT(hits[j] < n);
+        }
+    }
@@ -270,6 +270,10 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     step of the simulation instead of the one read from the GSD file *filename*.
     *time_step* is not applied when the file *restart* is read.
 
+    In MPI runs, every rank opens the file and reads only its own slice of the particles and bonded groups,
+    then sends them directly to the ranks that own them, so no rank needs memory for the whole system.
+    The file must be accessible from all ranks.
+
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
@@ -287,11 +291,14 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     filename = _hoomd.mpi_bcast_str(filename, hoomd.context.exec_conf);
     restart = _hoomd.mpi_bcast_str(restart, hoomd.context.exec_conf);
 
+    # in MPI runs, every rank reads its own slice of the frame
+    distributed = _hoomd.is_MPI_available() and hoomd.context.exec_conf.getNRanks() > 1;
+
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0, distributed);
         time_step = reader.getTimeStep();
     else:
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0, distributed);
         if time_step is None:
             time_step = reader.getTimeStep();
 
@@ -314,6 +321,82 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     hoomd.context.current.state_reader.clearSnapshot();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
+def read_checkpoint(filename):
+    R""" Restart from a checkpoint written by :py:class:`hoomd.dump.checkpoint`.
+
+    Args:
+        filename (str): Base name of the checkpoint files (the *filename* given to :py:class:`hoomd.dump.checkpoint`).
+
+    All particles (with their tags), bonds, angles, dihedrals, impropers, constraints, pairs, the box, the integrator
+    variables (such as thermostat and barostat state), and the time step are restored from the checkpoint.
+
+    When the job runs on as many MPI ranks as wrote the checkpoint, :py:func:`read_checkpoint` sets the domain
+    decomposition to the one of the checkpoint (overriding any :py:class:`hoomd.comm.decomposition`), and every rank
+    reloads its own file without communicating particle data. On a different number of ranks, every rank reads a
+    subset of the files and the particles are redistributed to the new domains.
+
+    Integrators and integration methods must be created in the same order as in the job that wrote the checkpoint to
+    pick up their restored variables. To restore the state saved with :py:meth:`hoomd.dump.checkpoint.dump_state`,
+    pass ``restore_state=True`` to the object, where supported.
+
+    Example::
+
+        if os.path.exists('checkpoint.0'):
+            system = init.read_checkpoint('checkpoint')
+        else:
+            system = init.read_gsd('init.gsd')
+
+    See Also:
+        :py:class:`hoomd.dump.checkpoint`
+    """
+    hoomd.context._verify_init();
+    hoomd.util.print_status_line();
+
+    # check if initialization has already occurred
+    if is_initialized():
+        hoomd.context.msg.error("Cannot initialize more than once\n");
+        raise RuntimeError("Error initializing");
+
+    filename = _hoomd.mpi_bcast_str(filename, hoomd.context.exec_conf);
+    reader = _hoomd.CheckpointReader(hoomd.context.exec_conf, filename);
+    time_step = reader.getTimeStep();
+
+    # use the domain decomposition of the checkpoint when the number of ranks matches, so that every rank can reload
+    # its own file in place
+    if _hoomd.is_MPI_available() and hoomd.context.exec_conf.getNRanks() > 1 and \
+            reader.getNFiles() == hoomd.context.exec_conf.getNRanks():
+        args = {};
+        for (d, name) in enumerate(['x', 'y', 'z']):
+            fractions = reader.getFractions(d);
+            if len(fractions) > 0:
+                args[name] = fractions;
+            else:
+                args['n' + name] = 1;
+
+        hoomd.util.quiet_status();
+        hoomd.comm.decomposition(**args);
+        hoomd.util.unquiet_status();
+
+    my_domain_decomposition = _create_domain_decomposition(reader.getBox());
+
+    if my_domain_decomposition is not None:
+        reader.setDomainDecomposition(my_domain_decomposition);
+        snapshot = reader.getSnapshot();
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
+    else:
+        snapshot = reader.getSnapshot();
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
+    del snapshot;
+
+    reader.restoreState(hoomd.context.current.system_definition);
+
+    # initialize the system
+    hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, time_step);
+
+    _perform_common_init_tasks();
+    hoomd.context.current.state_reader = reader;
+    return hoomd.data.system_data(hoomd.context.current.system_definition);
+
 def restore_getar(filename, modes={'any': 'any'}):
     """Restore a subset of the current system's parameters from a
     trajectory archive (.tar, .zip, .sqlite) file. For a detailed
@@ -190,6 +190,8 @@ class _integrator(hoomd.meta._metadata):
         hoomd.util.print_status_line();
         if isinstance(hoomd.context.current.state_reader, _hoomd.GSDReader) and hasattr(self.cpp_integrator, "restoreStateGSD"):
             self.cpp_integrator.restoreStateGSD(hoomd.context.current.state_reader, self._gsd_state_name());
+        elif isinstance(hoomd.context.current.state_reader, _hoomd.CheckpointReader) and hasattr(self, "_restore_checkpoint"):
+            self._restore_checkpoint(hoomd.context.current.state_reader);
         else:
             if hoomd.context.current.state_reader is None:
                 hoomd.context.msg.error("Can only restore after the state reader has been initialized.\n");
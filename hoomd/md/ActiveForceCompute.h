@@ -46,6 +46,14 @@ class PYBIND11_EXPORT ActiveForceCompute : public ForceCompute
         //! Destructor
         ~ActiveForceCompute();
 
+        //! Returns true if compute() may run concurrently with other ForceComputes
+        /*! Rotational diffusion updates the particle orientations
+        */
+        virtual bool isConcurrent()
+            {
+            return false;
+            }
+
     protected:
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -158,6 +158,12 @@ class AnisoPotentialPair : public ForceCompute
             return true;
             }
 
+        //! Get the computes that this force brings up to date in compute()
+        virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+            {
+            return std::vector< std::shared_ptr<Compute> >(1, m_nlist);
+            }
+
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         energyShiftMode m_shift_mode;               //!< Store the mode with which to handle the energy shift at r_cut
@@ -102,6 +102,11 @@ class EvaluatorWalls
             Scalar3 dr = -vec_to_scalar3(drv);
             Scalar rsq = dot(dr, dr);
 
+            // walls past the cutoff do not interact, so most walls are skipped without evaluating the potential
+            // evaluators that need the diameter may shift the cutoff, so they always evaluate
+            if (!evaluator::needsDiameter() && rsq >= m_params.rcutsq)
+                return;
+
             // compute the force and potential energy
             Scalar force_divr = Scalar(0.0);
             Scalar pair_eng = Scalar(0.0);
@@ -6,7 +6,13 @@
 
 #include "ForceDistanceConstraint.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 #include <string.h>
+#include <algorithm>
+#include <atomic>
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -14,6 +20,31 @@ namespace py = pybind11;
     \brief Contains code for the ForceDistanceConstraint class
 */
 
+//! Largest block of the constraint matrix that is solved with a dense LU decomposition
+const unsigned int max_dense_block_size = 32;
+
+//! Find the root of a constraint in a union-find forest, with path halving
+static unsigned int find_root(std::vector<unsigned int>& parent, unsigned int i)
+    {
+    while (parent[i] != i)
+        {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+        }
+    return i;
+    }
+
+//! Merge the sets of two constraints in a union-find forest, keeping the lower root
+static void unite(std::vector<unsigned int>& parent, unsigned int i, unsigned int j)
+    {
+    i = find_root(parent, i);
+    j = find_root(parent, j);
+    if (i < j)
+        parent[j] = i;
+    else if (j < i)
+        parent[i] = j;
+    }
+
 /*! \param sysdef SystemDefinition containing the ParticleData to compute forces on
 */
 ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinition> sysdef)
@@ -63,7 +94,6 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
 
     // reallocate through amortized resizin
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint*n_constraint);
     m_cvec.resize(n_constraint);
 
     // populate the terms in the matrix vector equation
@@ -84,7 +114,6 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
 
 void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
     {
-    // fill the matrix in column-major order
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
 
     if (m_constraint_reorder)
@@ -92,16 +121,8 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
         // reset flag
         m_constraint_reorder = false;
 
-        // resize lookup matrix
-        m_sparse_idxlookup.resize(n_constraint*n_constraint);
-
-        ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
-
-        // reset lookup matrix values to -1
-        for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
-            {
-            h_sparse_idxlookup.data[i] = -1;
-            }
+        // regroup the constraints into blocks
+        initBlocks();
         }
 
     // access particle data
@@ -110,15 +131,16 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
 
-    // access matrix elements
-    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::overwrite);
+    // access vector elements
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
 
-    // clear matrix
-    memset(h_cmatrix.data, 0, sizeof(double)*m_cmatrix.size());
-
     const BoxDim& box = m_pdata->getBox();
 
+    // particle indices, bond vectors and predicted bond vectors of all constraints
+    std::vector<unsigned int> idx(2*n_constraint);
+    std::vector< vec3<Scalar> > r(n_constraint);
+    std::vector< vec3<Scalar> > q(n_constraint);
+
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
     for (unsigned int n = 0; n < n_constraint; ++n)
         {
@@ -139,7 +161,6 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
             throw std::runtime_error("Error in constraint calculation");
             }
 
-
         vec3<Scalar> ra(h_pos.data[idx_a]);
         vec3<Scalar> rb(h_pos.data[idx_b]);
         vec3<Scalar> rn(ra-rb);
@@ -155,85 +176,205 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
         vec3<Scalar> rndot(va-vb);
         vec3<Scalar> qn(rn+rndot*m_deltaT);
 
-        // fill matrix row
-        for (unsigned int m = 0; m < n_constraint; ++m)
+        idx[2*n] = idx_a;
+        idx[2*n+1] = idx_b;
+        r[n] = rn;
+        q[n] = qn;
+
+        // get constraint distance
+        Scalar d = m_cdata->getValueByIndex(n);
+
+        // check distance violation
+        if (fast::sqrt(dot(rn,rn))-d >= m_rel_tol*d || std::isnan(dot(rn,rn)))
             {
-            // lookup the tag of each of the particles participating in the constraint
-            const ConstraintData::members_t constraint_m = m_cdata->getMembersByIndex(m);
-            assert(constraint_m.tag[0] <= m_pdata->getMaximumTag());
-            assert(constraint_m.tag[1] <= m_pdata->getMaximumTag());
-
-            // transform a and b into indices into the particle data arrays
-            // (MEM TRANSFER: 4 integers)
-            unsigned int idx_m_a = h_rtag.data[constraint_m.tag[0]];
-            unsigned int idx_m_b = h_rtag.data[constraint_m.tag[1]];
-            assert(idx_m_a <= m_pdata->getN()+m_pdata->getNGhosts());
-            assert(idx_m_b <= m_pdata->getN()+m_pdata->getNGhosts());
-
-            if (idx_m_a >= max_local || idx_m_b >= max_local)
-                {
-                this->m_exec_conf->msg->error() << "constrain.distance(): constraint " <<
-                    constraint_m.tag[0] << " " << constraint_m.tag[1] << " incomplete." << std::endl << std::endl;
-                throw std::runtime_error("Error in constraint calculation");
-                }
+            m_constraint_violated.resetFlags(n+1);
+            }
 
-            vec3<Scalar> rm_a(h_pos.data[idx_m_a]);
-            vec3<Scalar> rm_b(h_pos.data[idx_m_b]);
-            vec3<Scalar> rm(rm_a-rm_b);
+        // fill vector component
+        h_cvec.data[n] = (dot(qn,qn)-d*d)/m_deltaT/m_deltaT;
+        h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
+              -vec3<Scalar>(h_netforce.data[idx_b])/mb);
+        }
 
-            // apply minimum image
-            rm = box.minImage(rm);
+    // fill the structural non-zeros of the blocks, only constraints sharing a particle are coupled
+    m_block_val.resize(m_block_nz.size());
+    for (unsigned int b = 0; b < m_blocks.size(); ++b)
+        {
+        const ConstraintBlock& block = m_blocks[b];
+        const unsigned int *constraints = &m_block_constraints[block.first];
+
+        for (unsigned int k = block.first_nz; k < block.first_nz + block.nnz; ++k)
+            {
+            // matrix row n, column m
+            unsigned int m = constraints[m_block_nz[k].first];
+            unsigned int n = constraints[m_block_nz[k].second];
+
+            unsigned int idx_a = idx[2*n];
+            unsigned int idx_b = idx[2*n+1];
+            unsigned int idx_m_a = idx[2*m];
+            unsigned int idx_m_b = idx[2*m+1];
+            Scalar ma(h_vel.data[idx_a].w);
+            Scalar mb(h_vel.data[idx_b].w);
 
             double delta(0.0);
             if (idx_m_a == idx_a)
                 {
-                delta += double(4.0)*dot(qn,rm)/ma;
+                delta += double(4.0)*dot(q[n],r[m])/ma;
                 }
             if (idx_m_b == idx_a)
                 {
-                delta -= double(4.0)*dot(qn,rm)/ma;
+                delta -= double(4.0)*dot(q[n],r[m])/ma;
                 }
             if (idx_m_a == idx_b)
                 {
-                delta -= double(4.0)*dot(qn,rm)/mb;
+                delta -= double(4.0)*dot(q[n],r[m])/mb;
                 }
             if (idx_m_b == idx_b)
                 {
-                delta += double(4.0)*dot(qn,rm)/mb;
+                delta += double(4.0)*dot(q[n],r[m])/mb;
                 }
 
-            h_cmatrix.data[m*n_constraint+n] += delta;
+            m_block_val[k] = delta;
+            }
+        }
+    }
+
+/*! Constraints that share a particle are merged into the same block with a union-find pass over the particle tags,
+    so every block holds the local constraints of one molecule. Within a block, the structural non-zeros are the
+    pairs of constraints that share a particle (including the diagonal). They are stored in column-major order, which
+    is also the order of the values of a compressed Eigen::SparseMatrix with the same pattern.
+*/
+void ForceDistanceConstraint::initBlocks()
+    {
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
 
-            // update sparse matrix
-            int k = m_sparse_idxlookup[m*n_constraint+n];
+    m_exec_conf->msg->notice(7) << "ForceDistanceConstraint: grouping " << n_constraint
+        << " constraints into blocks" << std::endl;
 
-            if ( (k == -1 && delta != double(0.0))
-                || (k != -1 && delta == double(0.0)))
-                {
-                m_condition.resetFlags(1);
-                }
+    // sort the (particle tag, constraint) pairs to find the constraints that share a particle
+    std::vector< std::pair<unsigned int, unsigned int> > tag_constraint(2*n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        const ConstraintData::members_t constraint = m_cdata->getMembersByIndex(n);
+        tag_constraint[2*n] = std::make_pair(constraint.tag[0], n);
+        tag_constraint[2*n+1] = std::make_pair(constraint.tag[1], n);
+        }
+    std::sort(tag_constraint.begin(), tag_constraint.end());
 
-            if (k != -1)
-                {
-                // update sparse matrix value directly
-                m_sparse.valuePtr()[k] = delta;
-                }
-            }
+    // connected components of the constraint graph
+    std::vector<unsigned int> parent(n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        parent[n] = n;
 
-        // get constraint distance
-        Scalar d = m_cdata->getValueByIndex(n);
+    for (unsigned int i = 1; i < tag_constraint.size(); ++i)
+        {
+        if (tag_constraint[i].first == tag_constraint[i-1].first)
+            unite(parent, tag_constraint[i].second, tag_constraint[i-1].second);
+        }
 
-        // check distance violation
-        if (fast::sqrt(dot(rn,rn))-d >= m_rel_tol*d || std::isnan(dot(rn,rn)))
+    // number the blocks in the order of their first constraint
+    std::vector<unsigned int> block_of(n_constraint);
+    std::vector<unsigned int> block_size;
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        unsigned int root = find_root(parent, n);
+        if (root == n)
             {
-            m_constraint_violated.resetFlags(n+1);
+            block_of[n] = block_size.size();
+            block_size.push_back(0);
+            }
+        else
+            {
+            block_of[n] = block_of[root];
             }
+        }
 
-        // fill vector component
-        h_cvec.data[n] = (dot(qn,qn)-d*d)/m_deltaT/m_deltaT;
-        h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
-              -vec3<Scalar>(h_netforce.data[idx_b])/mb);
+    // position of every constraint within its block
+    std::vector<unsigned int> pos_in_block(n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        pos_in_block[n] = block_size[block_of[n]]++;
+
+    unsigned int n_blocks = block_size.size();
+    m_blocks.resize(n_blocks);
+    m_block_constraints.resize(n_constraint);
+
+    unsigned int offset = 0;
+    for (unsigned int b = 0; b < n_blocks; ++b)
+        {
+        m_blocks[b].first = offset;
+        m_blocks[b].size = block_size[b];
+        offset += block_size[b];
+        }
+
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        m_block_constraints[m_blocks[block_of[n]].first + pos_in_block[n]] = n;
+
+    // structural non-zeros as (block, column, row)
+    std::vector< std::pair<unsigned int, std::pair<unsigned int, unsigned int> > > nz;
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        nz.push_back(std::make_pair(block_of[n], std::make_pair(pos_in_block[n], pos_in_block[n])));
+
+    unsigned int i = 0;
+    while (i < tag_constraint.size())
+        {
+        unsigned int j = i;
+        while (j < tag_constraint.size() && tag_constraint[j].first == tag_constraint[i].first)
+            j++;
+
+        // all constraints on this particle are coupled to each other
+        for (unsigned int k = i; k < j; ++k)
+            for (unsigned int l = i; l < j; ++l)
+                {
+                unsigned int n = tag_constraint[k].second;
+                unsigned int m = tag_constraint[l].second;
+                if (n != m)
+                    nz.push_back(std::make_pair(block_of[n], std::make_pair(pos_in_block[m], pos_in_block[n])));
+                }
+        i = j;
+        }
+
+    std::sort(nz.begin(), nz.end());
+    nz.erase(std::unique(nz.begin(), nz.end()), nz.end());
+
+    m_block_nz.resize(nz.size());
+    for (unsigned int b = 0; b < n_blocks; ++b)
+        m_blocks[b].nnz = 0;
+
+    for (unsigned int k = 0; k < nz.size(); ++k)
+        {
+        unsigned int b = nz[k].first;
+        if (m_blocks[b].nnz == 0)
+            m_blocks[b].first_nz = k;
+        m_blocks[b].nnz++;
+        m_block_nz[k] = nz[k].second;
+        }
+
+    // set up the sparse solvers of the large blocks
+    m_block_solver.clear();
+    m_block_solver.resize(n_blocks);
+    for (unsigned int b = 0; b < n_blocks; ++b)
+        {
+        const ConstraintBlock& block = m_blocks[b];
+        if (block.size <= max_dense_block_size)
+            continue;
+
+        std::vector< Triplet<double> > triplets;
+        for (unsigned int k = block.first_nz; k < block.first_nz + block.nnz; ++k)
+            triplets.push_back(Triplet<double>(m_block_nz[k].second, m_block_nz[k].first, 1.0));
+
+        m_block_solver[b].reset(new SparseBlockSolver());
+        SparseBlockSolver& block_solver = *m_block_solver[b];
+        block_solver.matrix.resize(block.size, block.size);
+        block_solver.matrix.setFromTriplets(triplets.begin(), triplets.end());
+        block_solver.matrix.makeCompressed();
+        assert(block_solver.matrix.nonZeros() == (int)block.nnz);
+
+        // the symbolic analysis is reused until the blocks change
+        block_solver.solver.analyzePattern(block_solver.matrix);
         }
+
+    m_exec_conf->msg->notice(7) << "ForceDistanceConstraint: " << n_blocks << " blocks, "
+        << m_block_nz.size() << " non-zeros" << std::endl;
     }
 
 void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
@@ -262,7 +403,97 @@ void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
         }
     }
 
+/*! Every block of the constraint matrix is solved independently, in parallel when TBB is available.
+*/
 void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
+    {
+    typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
+    typedef Matrix<double, Dynamic, 1> vec_t;
+
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0) return;
+
+    if (m_prof)
+        m_prof->push("solve");
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
+    // access RHS and solution vector
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
+
+    std::atomic<bool> singular(false);
+
+    auto solve_block = [&](unsigned int b)
+        {
+        const ConstraintBlock& block = m_blocks[b];
+        const unsigned int *constraints = &m_block_constraints[block.first];
+
+        vec_t rhs(block.size);
+        for (unsigned int i = 0; i < block.size; ++i)
+            rhs(i) = h_cvec.data[constraints[i]];
+
+        vec_t x;
+        if (!m_block_solver[b])
+            {
+            // dense LU decomposition of a small block
+            matrix_t a = matrix_t::Zero(block.size, block.size);
+            for (unsigned int k = block.first_nz; k < block.first_nz + block.nnz; ++k)
+                a(m_block_nz[k].second, m_block_nz[k].first) = m_block_val[k];
+
+            FullPivLU<matrix_t> lu(a);
+            if (!lu.isInvertible())
+                {
+                singular = true;
+                return;
+                }
+            x = lu.solve(rhs);
+            }
+        else
+            {
+            // numerical refactorization with the analyzed pattern
+            SparseBlockSolver& block_solver = *m_block_solver[b];
+            std::copy(m_block_val.begin() + block.first_nz, m_block_val.begin() + block.first_nz + block.nnz,
+                block_solver.matrix.valuePtr());
+
+            block_solver.solver.factorize(block_solver.matrix);
+            if (block_solver.solver.info() != Success)
+                {
+                singular = true;
+                return;
+                }
+            x = block_solver.solver.solve(rhs);
+            }
+
+        for (unsigned int i = 0; i < block.size; ++i)
+            h_lagrange.data[constraints[i]] = x(i);
+        };
+
+    unsigned int n_blocks = m_blocks.size();
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, n_blocks, solve_block);
+    #else
+    for (unsigned int b = 0; b < n_blocks; ++b)
+        solve_block(b);
+    #endif
+
+    if (singular)
+        {
+        m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
+        throw std::runtime_error("Error evaluating constraint forces.\n");
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! The global matrix in m_cmatrix is converted into a sparse matrix when the sparsity pattern changes, as flagged by
+    m_condition. Otherwise, the values in m_sparse are expected to be up to date.
+*/
+void ForceDistanceConstraint::solveSparseLU(unsigned int timestep)
     {
     // use Eigen dense matrix algebra (slow for large matrices)
     typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
@@ -474,50 +705,6 @@ CommFlags ForceDistanceConstraint::getRequestedCommFlags(unsigned int timestep)
     }
 #endif
 
-//! Return maximum extent of molecule
-Scalar ForceDistanceConstraint::dfs(unsigned int iconstraint, unsigned int molecule, std::vector<int>& visited,
-    unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length)
-    {
-    assert(iconstraint < groups.size());
-
-    // don't mark constraints already visited
-    assert(visited.size() > iconstraint);
-    if (visited[iconstraint])
-        {
-        return Scalar(0.0);
-        }
-
-    // mark this constraint as visited
-    visited[iconstraint] = 1;
-
-    const ConstraintData::members_t constraint = groups[iconstraint];
-    assert(constraint.tag[0] <= m_pdata->getMaximumTag());
-    assert(constraint.tag[1] <= m_pdata->getMaximumTag());
-
-    label[constraint.tag[0]] = molecule;
-    label[constraint.tag[1]] = molecule;
-
-    // NOTE: this loop could be optimized with a reverse-lookup table ptl idx -> constraint
-    assert(iconstraint < length.size());
-    Scalar dmax = length[iconstraint];
-
-    for (unsigned int jconstraint = 0; jconstraint < groups.size(); ++jconstraint)
-        {
-        ConstraintData::members_t tags_j = groups[jconstraint];
-
-        if (iconstraint == jconstraint) continue;
-
-        if (tags_j.tag[0] == constraint.tag[0] || tags_j.tag[1] == constraint.tag[0] ||
-            tags_j.tag[0] == constraint.tag[1] || tags_j.tag[1] == constraint.tag[1])
-            {
-            // recursively mark connected constraint with current label
-            dmax += dfs(jconstraint, molecule, visited, label, groups, length);
-            }
-        }
-
-    return dmax;
-    }
-
 Scalar ForceDistanceConstraint::askGhostLayerWidth(unsigned int type)
     {
     // only rebuild global tag list if necessary
@@ -549,10 +736,26 @@ void ForceDistanceConstraint::assignMoleculeTags()
         }
     #endif
 
-    // walk through the global constraints and connect molecules
+    // connect the global constraints that share a particle into molecules
 
     unsigned int nconstraint_global = snap.size;
-    std::vector<int> visited(nconstraint_global,0);
+    std::vector< std::pair<unsigned int, unsigned int> > tag_constraint(2*nconstraint_global);
+    for (unsigned int iconstraint = 0; iconstraint < nconstraint_global; ++iconstraint)
+        {
+        tag_constraint[2*iconstraint] = std::make_pair(groups[iconstraint].tag[0], iconstraint);
+        tag_constraint[2*iconstraint+1] = std::make_pair(groups[iconstraint].tag[1], iconstraint);
+        }
+    std::sort(tag_constraint.begin(), tag_constraint.end());
+
+    std::vector<unsigned int> parent(nconstraint_global);
+    for (unsigned int iconstraint = 0; iconstraint < nconstraint_global; ++iconstraint)
+        parent[iconstraint] = iconstraint;
+
+    for (unsigned int i = 1; i < tag_constraint.size(); ++i)
+        {
+        if (tag_constraint[i].first == tag_constraint[i-1].first)
+            unite(parent, tag_constraint[i].second, tag_constraint[i-1].second);
+        }
 
     // label per ptl (-1 == no label)
     m_molecule_tag.resize(m_pdata->getNGlobal());
@@ -566,24 +769,38 @@ void ForceDistanceConstraint::assignMoleculeTags()
         h_molecule_tag.data[i] = NO_MOLECULE;
         }
 
-    int molecule = 0;
+    unsigned int molecule = 0;
 
     // maximum molecule diameter
     m_d_max = Scalar(0.0);
 
         {
-        // label ptls by connected component index
+        // label ptls by connected component index, in the order of the first constraint of each component
+        std::vector<unsigned int> label(nconstraint_global);
+        std::vector<Scalar> extent;
         for (unsigned int iconstraint = 0; iconstraint < nconstraint_global; ++iconstraint)
             {
-            if (! visited[iconstraint])
+            unsigned int root = find_root(parent, iconstraint);
+            if (root == iconstraint)
                 {
-                // depth first search
-                Scalar d = dfs(iconstraint, molecule++, visited, h_molecule_tag.data, groups, length);
-                if (d > m_d_max)
-                    {
-                    m_d_max = d;
-                    }
+                label[iconstraint] = molecule++;
+                extent.push_back(Scalar(0.0));
                 }
+            else
+                {
+                label[iconstraint] = label[root];
+                }
+
+            const ConstraintData::members_t constraint = groups[iconstraint];
+            assert(constraint.tag[0] <= m_pdata->getMaximumTag());
+            assert(constraint.tag[1] <= m_pdata->getMaximumTag());
+
+            h_molecule_tag.data[constraint.tag[0]] = label[iconstraint];
+            h_molecule_tag.data[constraint.tag[1]] = label[iconstraint];
+
+            // the sum of the constraint lengths bounds the extent of the molecule
+            extent[label[iconstraint]] += length[iconstraint];
+            m_d_max = std::max(m_d_max, extent[label[iconstraint]]);
             }
         }
 
@@ -25,11 +25,23 @@
 #include "hoomd/extern/Eigen/Eigen/Dense"
 #include "hoomd/extern/Eigen/Eigen/SparseLU"
 
+#include <memory>
+#include <vector>
+
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for Constraint Molecular Dynamics Simulations,” Mol. Simul., vol. 13, no. 6, pp. 395–405, 1994.
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    The constraint matrix couples only constraints that share a particle, so it is block diagonal with one block per
+    molecule (connected set of constraints). On the CPU, the local and ghost constraints are grouped into these blocks
+    whenever the constraint order changes (initBlocks()), together with the structural non-zeros of every block. Each
+    block is then solved independently, in parallel when TBB is available: small blocks with a dense LU decomposition,
+    larger ones with a sparse LU decomposition whose symbolic analysis is kept until the blocks change. Memory and time
+    scale linearly with the number of constraints.
+
+    The GPU implementation assembles the global matrix and uses solveSparseLU() when cuSOLVER is not available.
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -65,13 +77,37 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     protected:
         std::shared_ptr<ConstraintData> m_cdata; //! The constraint data
 
-        GPUVector<double> m_cmatrix;                //!< The matrix for the constraint force equation (column-major)
+        //! Block of the constraint matrix
+        struct ConstraintBlock
+            {
+            unsigned int first;     //!< Offset of the first constraint in m_block_constraints
+            unsigned int size;      //!< Number of constraints in the block
+            unsigned int first_nz;  //!< Offset of the first structural non-zero in m_block_nz
+            unsigned int nnz;       //!< Number of structural non-zeros
+            };
+
+        //! Sparse LU decomposition of a large block
+        struct SparseBlockSolver
+            {
+            Eigen::SparseMatrix<double, Eigen::ColMajor> matrix;    //!< Block matrix with the structural pattern
+            Eigen::SparseLU<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::COLAMDOrdering<int> > solver;
+                //!< Solver with the analyzed pattern
+            };
+
+        std::vector<ConstraintBlock> m_blocks;                  //!< Blocks of the local constraint matrix
+        std::vector<unsigned int> m_block_constraints;          //!< Constraint indices grouped by block
+        std::vector< std::pair<unsigned int, unsigned int> > m_block_nz; //!< (column, row) in the block, column-major
+        std::vector<double> m_block_val;                        //!< Values of the structural non-zeros
+        std::vector< std::unique_ptr<SparseBlockSolver> > m_block_solver; //!< Sparse solver per block (NULL if dense)
+
+        GPUVector<double> m_cmatrix;                //!< The global constraint matrix on the GPU (column-major)
         GPUVector<double> m_cvec;                   //!< The vector on the RHS of the constraint equation
         GPUVector<double> m_lagrange;               //!< The solution for the lagrange multipliers
 
         Scalar m_rel_tol;                           //!< Rel. tolerance for constraint violation warning
         GPUFlags<unsigned int> m_constraint_violated; //!< The id of the violated constraint + 1
 
+        // global sparse matrix used by the GPU implementation
         GPUFlags<unsigned int> m_condition; //!< ==1 if sparsity pattern has changed
         Eigen::SparseMatrix<double, Eigen::ColMajor> m_sparse;    //!< The sparse constraint matrix representation
         Eigen::SparseLU<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::COLAMDOrdering<int> > m_sparse_solver;
@@ -95,6 +131,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         //! Solve the constraint matrix equation
         virtual void solveConstraints(unsigned int timestep);
 
+        //! Solve the global constraint matrix equation with a sparse LU decomposition
+        void solveSparseLU(unsigned int timestep);
+
+        //! Group the constraints into blocks of the constraint matrix
+        void initBlocks();
+
         //! Solve the linear matrix-vector equation
         virtual void computeConstraintForces(unsigned int timestep);
 
@@ -132,10 +174,6 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         #endif
 
     private:
-        //! Helper function to perform a depth-first search
-        Scalar dfs(unsigned int iconstraint, unsigned int molecule, std::vector<int>& visited,
-            unsigned int *label, std::vector<ConstraintData::members_t>& groups, std::vector<Scalar>& length);
-
         #ifdef ENABLE_MPI
         bool m_comm_ghost_layer_connected = false; //!< Track if we have already connected to ghost layer width requests
         #endif
@@ -95,6 +95,9 @@ void ForceDistanceConstraintGPU::fillMatrixVector(unsigned int timestep)
     // fill the matrix in row-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
+    // reallocate through amortized resizing
+    m_cmatrix.resize(n_constraint*n_constraint);
+
     if (m_constraint_reorder)
         {
         // reset flag
@@ -193,7 +196,7 @@ void ForceDistanceConstraintGPU::solveConstraints(unsigned int timestep)
         }
 
     // solve on CPU
-    ForceDistanceConstraint::solveConstraints(timestep);
+    solveSparseLU(timestep);
 
     // a sparse matrix should have been constructed, resize values array
     m_sparse_val.resize(m_sparse.data().size());
@@ -138,33 +138,13 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // compute the forces on the three particles, and a third of the energy and virial of an angle
+    auto eval_angle = [&](const unsigned int *idx, unsigned int angle_type, Scalar3 *f, Scalar& angle_eng,
+                          Scalar *angle_virial)
         {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[2] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
-                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in angle calculation");
-            }
-
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -177,20 +157,11 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
         dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
 
-        Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
-
-        // apply minimum image conventions to all 3 vectors
+        // apply minimum image conventions to both vectors
         dab = box.minImage(dab);
         dcb = box.minImage(dcb);
-        dac = box.minImage(dac);
 
         // on paper, the formula turns out to be: F = K*\vec{r} * (r_0/r - 1)
-        // FLOPS: 14 / MEM TRANSFER: 2 Scalars
-
-
         // FLOPS: 42 / MEM TRANSFER: 6 Scalars
         Scalar rsqab = dab.x*dab.x+dab.y*dab.y+dab.z*dab.z;
         Scalar rab = sqrt(rsqab);
@@ -208,7 +179,6 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         s_abbc = 1.0/s_abbc;
 
         // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
         Scalar dth = acos(c_abbc) - m_t_0[angle_type];
         Scalar tk = m_K[angle_type]*dth;
 
@@ -228,11 +198,10 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         fcb[2] = a22*dcb.z + a12*dab.z;
 
         // compute 1/3 of the energy, 1/3 for each atom in the angle
-        Scalar angle_eng = (tk*dth)*Scalar(1.0/6.0);
+        angle_eng = (tk*dth)*Scalar(1.0/6.0);
 
         // compute 1/3 of the virial, 1/3 for each atom in the angle
         // upper triangular version of virial tensor
-        Scalar angle_virial[6];
         angle_virial[0] = Scalar(1./3.) * ( dab.x*fab[0] + dcb.x*fcb[0] );
         angle_virial[1] = Scalar(1./3.) * ( dab.y*fab[0] + dcb.y*fcb[0] );
         angle_virial[2] = Scalar(1./3.) * ( dab.z*fab[0] + dcb.z*fcb[0] );
@@ -240,36 +209,81 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         angle_virial[4] = Scalar(1./3.) * ( dab.z*fab[1] + dcb.z*fcb[1] );
         angle_virial[5] = Scalar(1./3.) * ( dab.z*fab[2] + dcb.z*fcb[2] );
 
-        // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
-        // do not update ghost particles
-        if (idx_a < m_pdata->getN())
-            {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_a]  += angle_virial[j];
-            }
+        f[0] = make_scalar3(fab[0], fab[1], fab[2]);
+        f[1] = make_scalar3(-fab[0] - fcb[0], -fab[1] - fcb[1], -fab[2] - fcb[2]);
+        f[2] = make_scalar3(fcb[0], fcb[1], fcb[2]);
+        };
 
-        if (idx_b < m_pdata->getN())
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // every particle sums the angles it belongs to, so the threads write to disjoint particles
+        m_angle_data->forEachParticleGroup([&](unsigned int idx, const unsigned int *members, unsigned int pos,
+                                               unsigned int angle_type)
             {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
+            Scalar3 f[3];
+            Scalar angle_eng;
+            Scalar angle_virial[6];
+            eval_angle(members, angle_type, f, angle_eng, angle_virial);
+
+            h_force.data[idx].x += f[pos].x;
+            h_force.data[idx].y += f[pos].y;
+            h_force.data[idx].z += f[pos].z;
+            h_force.data[idx].w += angle_eng;
             for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_b]  += angle_virial[j];
-            }
-
-        if (idx_c < m_pdata->getN())
+                h_virial.data[j*virial_pitch+idx]  += angle_virial[j];
+            });
+        }
+    else
+    #endif
+        {
+        // for each of the angles
+        const unsigned int size = (unsigned int)m_angle_data->getN();
+        for (unsigned int i = 0; i < size; i++)
             {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
+            // lookup the tag of each of the particles participating in the angle
+            const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
+            assert(angle.tag[0] <= m_pdata->getMaximumTag());
+            assert(angle.tag[1] <= m_pdata->getMaximumTag());
+            assert(angle.tag[2] <= m_pdata->getMaximumTag());
+
+            // transform a, b, and c into indices into the particle data arrays
+            // MEM TRANSFER: 6 ints
+            unsigned int idx[3];
+            for (unsigned int j = 0; j < 3; j++)
+                idx[j] = h_rtag.data[angle.tag[j]];
+
+            // throw an error if this angle is incomplete
+            if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL)
+                {
+                this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
+                    angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
+                throw std::runtime_error("Error in angle calculation");
+                }
+
+            assert(idx[0] < m_pdata->getN()+m_pdata->getNGhosts());
+            assert(idx[1] < m_pdata->getN()+m_pdata->getNGhosts());
+            assert(idx[2] < m_pdata->getN()+m_pdata->getNGhosts());
+
+            Scalar3 f[3];
+            Scalar angle_eng;
+            Scalar angle_virial[6];
+            eval_angle(idx, m_angle_data->getTypeByIndex(i), f, angle_eng, angle_virial);
+
+            // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
+            // do not update ghost particles
+            for (unsigned int k = 0; k < 3; k++)
+                {
+                if (idx[k] >= m_pdata->getN())
+                    continue;
+
+                h_force.data[idx[k]].x += f[k].x;
+                h_force.data[idx[k]].y += f[k].y;
+                h_force.data[idx[k]].z += f[k].z;
+                h_force.data[idx[k]].w += angle_eng;
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j*virial_pitch+idx[k]]  += angle_virial[j];
+                }
             }
         }
 
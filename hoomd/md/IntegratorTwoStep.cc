@@ -239,6 +239,32 @@ void IntegratorTwoStep::removeForceComputes()
     m_composite_forces.clear();
     }
 
+/*! \param fc Force compute previously added with addForceCompute()
+    \param period Number of time steps between evaluations of \a fc
+
+    The forces of \a fc are evaluated every \a period steps and applied with a weight of \a period on those steps.
+*/
+void IntegratorTwoStep::setRESPAPeriod(std::shared_ptr<ForceCompute> fc, unsigned int period)
+    {
+    if (period < 1)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_standard: RESPA period must be at least 1" << endl;
+        throw runtime_error("Error setting RESPA period");
+        }
+
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (m_forces[i] == fc)
+            {
+            m_force_periods[i] = period;
+            return;
+            }
+        }
+
+    m_exec_conf->msg->error() << "integrate.mode_standard: Force is not part of the integrator" << endl;
+    throw runtime_error("Error setting RESPA period");
+    }
+
 
 /*! \returns true If all added integration methods have valid restart information
 */
@@ -468,6 +494,7 @@ void export_IntegratorTwoStep(py::module& m)
         .def("setAnisotropicMode", &IntegratorTwoStep::setAnisotropicMode)
         .def("addForceComposite", &IntegratorTwoStep::addForceComposite)
         .def("removeForceComputes", &IntegratorTwoStep::removeForceComputes)
+        .def("setRESPAPeriod", &IntegratorTwoStep::setRESPAPeriod)
         .def("initializeIntegrationMethods", &IntegratorTwoStep::initializeIntegrationMethods)
         ;
 
@@ -39,6 +39,11 @@
     one and two, and which can use the updated particle positions and velocities to update any slaved degrees
     of freedom (rigid bodies).
 
+    setRESPAPeriod() assigns a multiple time step period to a force compute for an impulse r-RESPA splitting.
+    Forces with period 1 are evaluated on every (inner) step. A force with period p is evaluated every p steps and
+    its impulse is applied with a weight of p in the half steps of the integration methods around that step, so
+    all methods operate within the splitting unchanged.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
@@ -99,6 +104,9 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
         //! Removes all ForceComputes from the list
         virtual void removeForceComputes();
 
+        //! Set the multiple time step period of a force compute
+        void setRESPAPeriod(std::shared_ptr<ForceCompute> fc, unsigned int period);
+
 #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -15,6 +15,7 @@ namespace py = pybind11;
 
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 
 using namespace std;
 
@@ -51,6 +52,7 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_last_check_result = false;
     m_every = 0;
     m_exclusions_set = false;
+    m_exclusions_in_build = false;
 
     m_need_reallocate_exlist = false;
 
@@ -363,7 +365,7 @@ void NeighborList::compute(unsigned int timestep)
                 }
             } while (overflowed);
 
-        if (m_exclusions_set)
+        if (m_exclusions_set && !m_exclusions_in_build)
             filterNlist();
 
         setLastUpdatedPos();
@@ -1381,6 +1383,9 @@ void NeighborList::buildNlist(unsigned int timestep)
     }
 
 /*! Translates the exclusions set in \c m_n_ex_tag and \c m_ex_list_tag to indices in \c m_n_ex_idx and \c m_ex_list_idx
+
+    The exclusions of each particle are sorted by index, so that buildNlist() can look up candidate neighbors with a
+    binary search. Excluded particles that are not present on this rank have the largest index and come last.
 */
 void NeighborList::updateExListIdx()
     {
@@ -1398,6 +1403,9 @@ void NeighborList::updateExListIdx()
     ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::overwrite);
 
+    // temporary storage for sorting the exclusions of one particle
+    std::vector<unsigned int> ex(m_ex_list_indexer.getH());
+
     // translate the number and exclusions from one array to the other
     for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
         {
@@ -1412,11 +1420,14 @@ void NeighborList::updateExListIdx()
         for (unsigned int offset = 0; offset < n; offset++)
             {
             unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag,offset)];
-            unsigned int ex_idx = h_rtag.data[ex_tag];
-
-            // store excluded particle idx
-            h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex_idx;
+            ex[offset] = h_rtag.data[ex_tag];
             }
+
+        std::sort(ex.begin(), ex.begin() + n);
+
+        // store excluded particle idx
+        for (unsigned int offset = 0; offset < n; offset++)
+            h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex[offset];
         }
 
     if (m_prof)
@@ -99,6 +99,10 @@
     through the neighbor list and removes any particles that are excluded. This allows an arbitrary number of exclusions
     to be processed without slowing the performance of the buildNlist() step itself.
 
+    On the CPU, updateExListIdx() sorts the exclusions of every particle by index. Derived classes that skip the
+    excluded pairs in buildNlist() (with loadExclusions() and a binary search of the candidate neighbor) set
+    \a m_exclusions_in_build, which saves the second pass over the neighbor list in filterNlist().
+
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition is stored in the
     GlobalArray \a d_conditions.
@@ -488,6 +492,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         Index2D m_ex_list_indexer;             //!< Indexer for accessing the exclusion list
         Index2D m_ex_list_indexer_tag;         //!< Indexer for accessing the by-tag exclusion list
         bool m_exclusions_set;                 //!< True if any exclusions have been set
+        bool m_exclusions_in_build;            //!< True if buildNlist() skips excluded pairs, so no filtering is needed
         bool m_need_reallocate_exlist;         //!< True if global exclusion list needs to be reallocated
 
         //! Return true if we are supposed to do a distance check in this time step
@@ -514,6 +519,29 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Filter the neighbor list of excluded particles
         virtual void filterNlist();
 
+        //! Copy the exclusions of a particle into contiguous memory
+        /*! \param idx Index of the particle
+            \param h_n_ex_idx Number of exclusions per particle index
+            \param h_ex_list_idx Exclusion list by index
+            \param ex Output list of excluded particle indices, with room for m_ex_list_indexer.getH() elements
+            \returns The number of exclusions of the particle
+
+            The output is sorted by index on the CPU (see updateExListIdx()).
+        */
+        unsigned int loadExclusions(unsigned int idx,
+                                    const unsigned int *h_n_ex_idx,
+                                    const unsigned int *h_ex_list_idx,
+                                    unsigned int *ex) const
+            {
+            if (!m_exclusions_set)
+                return 0;
+
+            const unsigned int n_ex = h_n_ex_idx[idx];
+            for (unsigned int k = 0; k < n_ex; ++k)
+                ex[k] = h_ex_list_idx[m_ex_list_indexer(idx, k)];
+            return n_ex;
+            }
+
         //! Build the head list to allocated memory
         virtual void buildHeadList();
 
@@ -10,6 +10,8 @@
 
 #include "NeighborListBinned.h"
 
+#include <algorithm>
+
 #ifdef ENABLE_MPI
 #include "hoomd/Communicator.h"
 #endif
@@ -22,7 +24,7 @@ NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef,
                                        Scalar r_cut,
                                        Scalar r_buff,
                                        std::shared_ptr<CellList> cl)
-    : NeighborList(sysdef, r_cut, r_buff), m_cl(cl)
+    : NeighborList(sysdef, r_cut, r_buff), m_cl(cl), m_mixed_precision(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListBinned" << endl;
 
@@ -35,6 +37,9 @@ NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef,
     m_cl->setComputeTDB(false);
     m_cl->setFlagIndex();
 
+    // exclusions are applied in buildNlist()
+    m_exclusions_in_build = true;
+
     // call this class's special setRCut
     setRCut(r_cut, r_buff);
     }
@@ -122,6 +127,11 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // access the exclusions, excluded pairs are skipped during the build
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+    std::vector<unsigned int> ex_i(m_ex_list_indexer.getH());
+
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
@@ -130,6 +140,21 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
+    // the cell origins only determine the minimum image when there are at least three cells along periodic directions
+    bool mixed = m_mixed_precision;
+    if ((periodic.x && dim.x < 3) || (periodic.y && dim.y < 3) ||
+        (m_sysdef->getNDimensions() == 3 && periodic.z && dim.z < 3))
+        mixed = false;
+
+    ArrayHandle<float4> h_cell_offset(m_cl->getOffsetArray(), access_location::host, access_mode::read);
+
+    // bound the single precision rounding error of dr_sq, the separations are at most two cell widths long
+    Scalar3 cell_width = m_cl->getCellWidth();
+    Scalar max_width = std::max(cell_width.x, cell_width.y);
+    if (m_sysdef->getNDimensions() == 3)
+        max_width = std::max(max_width, cell_width.z);
+    const Scalar mixed_margin = Scalar(1e-5)*max_width*max_width;
+
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
@@ -144,6 +169,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int head_idx_i = h_head_list.data[i];
+        const unsigned int n_ex_i = loadExclusions(i, h_n_ex_idx.data, h_ex_list_idx.data, ex_i.data());
 
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos,ghost_width);
@@ -151,6 +177,16 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
         int jb = (unsigned int)(f.y * dim.y);
         int kb = (unsigned int)(f.z * dim.z);
 
+        // offset from the cell origin, taken before wrapping as in the cell list
+        Scalar3 my_origin = make_scalar3(0,0,0);
+        float3 my_offset = make_float3(0,0,0);
+        if (mixed)
+            {
+            my_origin = m_cl->getCellOrigin(box, ib, jb, kb);
+            Scalar3 d = my_pos - my_origin;
+            my_offset = make_float3(float(d.x), float(d.y), float(d.z));
+            }
+
         // need to handle the case where the particle is exactly at the box hi
         if (ib == (int)dim.x && periodic.x)
             ib = 0;
@@ -167,12 +203,24 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
             {
             unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
 
+            // separation of the particle from the origin of the neighboring cell, up to the offset of the neighbor
+            float3 cell_dx = make_float3(0,0,0);
+            if (mixed)
+                {
+                uint3 neigh_ijk = ci.getTriple(neigh_cell);
+                Scalar3 d = box.minImage(my_origin - m_cl->getCellOrigin(box, neigh_ijk.x, neigh_ijk.y, neigh_ijk.z));
+                cell_dx = make_float3(float(d.x) + my_offset.x, float(d.y) + my_offset.y, float(d.z) + my_offset.z);
+                }
+
             // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                 {
-                Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
-                unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
+                unsigned int cur_neigh;
+                if (mixed)
+                    cur_neigh = __float_as_int(h_cell_offset.data[cli(cur_offset, neigh_cell)].w);
+                else
+                    cur_neigh = __scalar_as_int(h_cell_xyzf.data[cli(cur_offset, neigh_cell)].w);
 
                 // get the current neighbor type from the position data (will use tdb on the GPU)
                 unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
@@ -188,10 +236,6 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                 if (excluded)
                     continue;
 
-                Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
-                Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
-
                 Scalar r_list = r_cut + m_r_buff;
                 Scalar sqshift = Scalar(0.0);
                 if (m_diameter_shift)
@@ -202,12 +246,34 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                     sqshift = (delta + Scalar(2.0) * r_list) * delta;
                     }
 
-                Scalar dr_sq = dot(dx,dx);
-
                 // move the squared rlist by the diameter shift if necessary
                 Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i,cur_neigh_type)];
+
+                Scalar dr_sq;
+                if (mixed)
+                    {
+                    const float4& cur_offset_f = h_cell_offset.data[cli(cur_offset, neigh_cell)];
+                    float dx = cell_dx.x - cur_offset_f.x;
+                    float dy = cell_dx.y - cur_offset_f.y;
+                    float dz = cell_dx.z - cur_offset_f.z;
+
+                    // include pairs within the rounding error of the cutoff
+                    dr_sq = Scalar(dx*dx + dy*dy + dz*dz) - mixed_margin;
+                    }
+                else
+                    {
+                    const Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                    Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                    Scalar3 dx = box.minImage(my_pos - neigh_pos);
+                    dr_sq = dot(dx,dx);
+                    }
+
                 if (dr_sq <= (r_listsq + sqshift) && !excluded)
                     {
+                    // skip the pairs excluded by the user (only the few that are within range are looked up)
+                    if (n_ex_i && std::binary_search(ex_i.begin(), ex_i.begin() + n_ex_i, cur_neigh))
+                        continue;
+
                     if (m_storage_mode == full || i < (int)cur_neigh)
                         {
                         // local neighbor
@@ -235,5 +301,7 @@ void export_NeighborListBinned(py::module& m)
     {
     py::class_<NeighborListBinned, std::shared_ptr<NeighborListBinned> >(m, "NeighborListBinned", py::base<NeighborList>())
     .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, Scalar, std::shared_ptr<CellList> >())
+    .def("setMixedPrecision", &NeighborListBinned::setMixedPrecision)
+    .def("getMixedPrecision", &NeighborListBinned::getMixedPrecision)
                      ;
     }
@@ -23,6 +23,14 @@
 //! Efficient neighbor list build on the CPU
 /*! Implements the O(N) neighbor list build on the CPU using a cell list.
 
+    In mixed precision mode (setMixedPrecision()), the distance checks are performed in single precision. The cell
+    list then provides the particle positions as float offsets from the origin of their cell, and the separation of
+    two particles is the minimum image separation of their cell origins (computed once per pair of cells in full
+    precision) plus the difference of their offsets. All terms are bounded by a few cell widths, so the rounding
+    error is independent of the box size. The cutoff comparison includes a small margin for that error, so no
+    neighbor is ever missed and the pair forces, which recheck the cutoff in full precision, are unaffected. Boxes
+    with fewer than three cells along a periodic direction fall back to the full precision check.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT NeighborListBinned : public NeighborList
@@ -46,8 +54,22 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
         //! Set the maximum diameter to use in computing neighbor lists
         virtual void setMaximumDiameter(Scalar d_max);
 
+        //! Enable or disable single precision distance checks
+        void setMixedPrecision(bool mixed)
+            {
+            m_mixed_precision = mixed;
+            m_cl->setComputeOffset(mixed);
+            }
+
+        //! Get whether the distance checks are performed in single precision
+        bool getMixedPrecision() const
+            {
+            return m_mixed_precision;
+            }
+
     protected:
         std::shared_ptr<CellList> m_cl;   //!< The cell list
+        bool m_mixed_precision;           //!< True if the distance checks are performed in single precision
 
         //! Builds the neighbor list
         virtual void buildNlist(unsigned int timestep);
@@ -10,6 +10,8 @@
 
 #include "NeighborListStencil.h"
 
+#include <algorithm>
+
 #ifdef ENABLE_MPI
 #include "hoomd/Communicator.h"
 #endif
@@ -48,6 +50,9 @@ NeighborListStencil::NeighborListStencil(std::shared_ptr<SystemDefinition> sysde
     m_cl->setFlagIndex();
     m_cl->setComputeAdjList(false);
 
+    // exclusions are applied in buildNlist()
+    m_exclusions_in_build = true;
+
     // call this class's special setRCut
     setRCut(r_cut, r_buff);
 
@@ -187,6 +192,11 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // access the exclusions, excluded pairs are skipped during the build
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+    std::vector<unsigned int> ex_i(m_ex_list_indexer.getH());
+
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
@@ -205,6 +215,7 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int head_idx_i = h_head_list.data[i];
+        const unsigned int n_ex_i = loadExclusions(i, h_n_ex_idx.data, h_ex_list_idx.data, ex_i.data());
 
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos,ghost_width);
@@ -318,6 +329,10 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
                 if (dr_sq <= r_listsq)
                     {
+                    // skip the pairs excluded by the user
+                    if (n_ex_i && std::binary_search(ex_i.begin(), ex_i.begin() + n_ex_i, cur_neigh))
+                        continue;
+
                     if (m_storage_mode == full || i < (int)cur_neigh)
                         {
                         // local neighbor
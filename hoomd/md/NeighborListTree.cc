@@ -11,6 +11,8 @@
 #include "NeighborListTree.h"
 #include "hoomd/SystemDefinition.h"
 
+#include <algorithm>
+
 namespace py = pybind11;
 
 #ifdef ENABLE_MPI
@@ -28,6 +30,9 @@ NeighborListTree::NeighborListTree(std::shared_ptr<SystemDefinition> sysdef,
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListTree" << endl;
 
+    // exclusions are applied in traverseTree()
+    m_exclusions_in_build = true;
+
     m_pdata->getNumTypesChangeSignal().connect<NeighborListTree, &NeighborListTree::slotNumTypesChanged>(this);
     m_pdata->getBoxChangeSignal().connect<NeighborListTree, &NeighborListTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal().connect<NeighborListTree, &NeighborListTree::slotMaxNumChanged>(this);
@@ -275,6 +280,11 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // access the exclusions, excluded pairs are skipped during the traversal
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+    std::vector<unsigned int> ex_i(m_ex_list_indexer.getH());
+
     // Loop over all particles
     for (unsigned int i=0; i < m_pdata->getN(); ++i)
         {
@@ -287,6 +297,7 @@ void NeighborListTree::traverseTree()
 
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int nlist_head_i = h_head_list.data[i];
+        const unsigned int n_ex_i = loadExclusions(i, h_n_ex_idx.data, h_ex_list_idx.data, ex_i.data());
 
         unsigned int n_neigh_i = 0;
         for (unsigned int cur_pair_type=0; cur_pair_type < m_pdata->getNTypes(); ++cur_pair_type) // loop on pair types
@@ -356,7 +367,9 @@ void NeighborListTree::traverseTree()
                                                    - vec_to_scalar3(pos_i_image);
                                     Scalar dr_sq = dot(drij,drij);
 
-                                    if (dr_sq <= (r_cutsq_i + sqshift))
+                                    // skip the pairs excluded by the user
+                                    if (dr_sq <= (r_cutsq_i + sqshift) &&
+                                        !(n_ex_i && std::binary_search(ex_i.begin(), ex_i.begin() + n_ex_i, j)))
                                         {
                                         if (m_storage_mode == full || i < j)
                                             {
@@ -88,6 +88,24 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         #endif
 
 
+        //! Get the computes that this force brings up to date in compute()
+        virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+            {
+            return std::vector< std::shared_ptr<Compute> >(1, m_nlist);
+            }
+
+        //! Returns true if compute() may run concurrently with other ForceComputes
+        /*! The distributed FFT communicates with MPI
+        */
+        virtual bool isConcurrent()
+            {
+            #ifdef ENABLE_MPI
+            if (m_comm)
+                return false;
+            #endif
+            return true;
+            }
+
     protected:
         /*! Compute the biased forces for this collective variable.
             The force that is written to the force arrays must be
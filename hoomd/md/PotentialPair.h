@@ -10,6 +10,10 @@
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #include "hoomd/extern/pybind/include/pybind11/numpy.h"
 
@@ -78,6 +82,21 @@
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    <b>Tabulation</b>
+
+    Potentials with transcendental functions can be evaluated from interpolation tables instead, see setTabulation().
+    The force \a force_divr and the energy are sampled per type pair on a uniform grid in r^2 between r_min^2 and
+    r_cut^2. Every grid interval stores the coefficients of the cubic Hermite interpolants of both quantities as two
+    consecutive Scalar4, so a lookup is two aligned loads and two polynomial evaluations. The node derivatives of the
+    energy are exact (dV/dr^2 = -force_divr/2), those of the force are fourth order finite differences of the samples.
+    The grid is refined until the interpolation error at the interval midpoints is below the tolerance for all type
+    pairs. Pairs closer than r_min are evaluated directly. Evaluators that depend on the diameter or charge cannot be
+    tabulated, and the tables are only used on the CPU.
+
+    In mixed precision mode, a single precision copy of the tables is interpolated in single precision, which halves
+    the memory traffic of the lookups. The pair distance is still computed, and the forces, energies, and virials are
+    still accumulated, in full precision.
+
     For profiling and logging, PotentialPair needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
@@ -128,8 +147,12 @@ class PotentialPair : public ForceCompute
         void setShiftMode(energyShiftMode mode)
             {
             m_shift_mode = mode;
+            m_tab_dirty = true;
             }
 
+        //! Evaluate the potential from interpolation tables
+        void setTabulation(Scalar tol, Scalar r_min, bool mixed=false);
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -156,6 +179,21 @@ class PotentialPair : public ForceCompute
             return type_shape_mapping;
             }
 
+        //! Get the computes that this force brings up to date in compute()
+        virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+            {
+            return std::vector< std::shared_ptr<Compute> >(1, m_nlist);
+            }
+
+        //! Returns true if compute() may run concurrently with other ForceComputes
+        /*! The neighbor list is a dependency and is up to date before compute() starts, so NeighborList::compute()
+            only reads its state when called from computeForces(). All other state written belongs to this object.
+        */
+        virtual bool isConcurrent()
+            {
+            return true;
+            }
+
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         energyShiftMode m_shift_mode;               //!< Store the mode with which to handle the energy shift at r_cut
@@ -166,9 +204,45 @@ class PotentialPair : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        Scalar m_tab_tol;                           //!< Tolerance of the interpolation tables (0 when disabled)
+        Scalar m_tab_rmin;                          //!< Smallest pair distance covered by the tables
+        bool m_tab_mixed;                           //!< True if the tables are interpolated in single precision
+        bool m_tab_dirty;                           //!< True when the tables need to be rebuilt
+        unsigned int m_tab_width;                   //!< Number of table intervals per type pair
+        bool m_energy_valid;                        //!< True if the force array holds the energies of the last compute
+        Index2D m_tab_idx;                          //!< Indexes the table coefficients per type pair
+        GlobalArray<Scalar4> m_tab_coeff;           //!< Cubic coefficients of the force and energy per interval
+        GlobalArray<float4> m_tab_coeff_mixed;      //!< Single precision copy of m_tab_coeff (mixed precision only)
+        GlobalArray<Scalar2> m_tab_range;           //!< r_min^2 and the inverse interval width per type pair
+
+        //! Maximum number of table intervals per type pair
+        static const unsigned int m_tab_max_width = 16384;
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the energies if the last call to computeForces() skipped them
+        virtual void ensureEnergies();
+
+        //! Compute the forces, and the energies and virials if requested
+        void computePairForces(bool compute_energy, bool compute_virial);
+
+        //! Sample the potential into the interpolation tables
+        void buildTables();
+
+        //! Tabulate a single type pair
+        Scalar tabulateTypePair(const param_type& param, Scalar rcutsq, bool energy_shift, unsigned int width,
+                                Scalar4 *coeff, Scalar2& range);
+
+        //! Compute the forces with the inner loop specialized for the shift mode and tabulation
+        template<unsigned int compute_energy, unsigned int compute_virial, unsigned int third_law>
+        void computeForcesShift();
+
+        //! Compute the forces with an inner loop specialized for the given options
+        template<unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial,
+                 unsigned int third_law, unsigned int tabulated>
+        void computeForcesLoop();
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -180,6 +254,7 @@ class PotentialPair : public ForceCompute
 
             // if the number of types is different, built a new indexer and reallocate memory
             m_typpair_idx = Index2D(m_pdata->getNTypes());
+            m_tab_dirty = true;
 
             // reallocate parameter arrays
             GlobalArray<Scalar> rcutsq(m_typpair_idx.getNumElements(), m_exec_conf);
@@ -220,7 +295,9 @@ template < class evaluator >
 PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes()),
+      m_tab_tol(0.0), m_tab_rmin(0.0), m_tab_mixed(false), m_tab_dirty(true), m_tab_width(0),
+      m_energy_valid(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
@@ -289,6 +366,7 @@ void PotentialPair< evaluator >::setParams(unsigned int typ1, unsigned int typ2,
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::readwrite);
     h_params.data[m_typpair_idx(typ1, typ2)] = param;
     h_params.data[m_typpair_idx(typ2, typ1)] = param;
+    m_tab_dirty = true;
     }
 
 /*! \param typ1 First type index in the pair
@@ -310,6 +388,7 @@ void PotentialPair< evaluator >::setRcut(unsigned int typ1, unsigned int typ2, S
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::readwrite);
     h_rcutsq.data[m_typpair_idx(typ1, typ2)] = rcut * rcut;
     h_rcutsq.data[m_typpair_idx(typ2, typ1)] = rcut * rcut;
+    m_tab_dirty = true;
     }
 
 /*! \param typ1 First type index in the pair
@@ -331,6 +410,250 @@ void PotentialPair< evaluator >::setRon(unsigned int typ1, unsigned int typ2, Sc
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::readwrite);
     h_ronsq.data[m_typpair_idx(typ1, typ2)] = ron * ron;
     h_ronsq.data[m_typpair_idx(typ2, typ1)] = ron * ron;
+    m_tab_dirty = true;
+    }
+
+/*! \param tol Largest interpolation error of the force and energy, or 0 to evaluate the potential directly
+    \param r_min Smallest pair distance covered by the tables, closer pairs are evaluated directly
+    \param mixed True to interpolate the tables in single precision
+
+    The error is measured relative to the magnitude of the force (or energy), but at least relative to 1. The tables
+    are built in the next call to compute().
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::setTabulation(Scalar tol, Scalar r_min, bool mixed)
+    {
+    if (tol > Scalar(0.0))
+        {
+        if (evaluator::needsDiameter() || evaluator::needsCharge())
+            {
+            m_exec_conf->msg->error() << "pair." << evaluator::getName()
+                                      << ": Cannot tabulate a potential that depends on the diameter or charge" << std::endl;
+            throw std::runtime_error("Error setting tabulation in PotentialPair");
+            }
+
+        if (r_min < Scalar(0.0))
+            {
+            m_exec_conf->msg->error() << "pair." << evaluator::getName() << ": r_min must not be negative" << std::endl;
+            throw std::runtime_error("Error setting tabulation in PotentialPair");
+            }
+
+        if (m_exec_conf->isCUDAEnabled())
+            m_exec_conf->msg->warning() << "pair." << evaluator::getName()
+                                        << ": Tabulation is only implemented on the CPU" << std::endl;
+        }
+
+    m_tab_tol = std::max(tol, Scalar(0.0));
+    m_tab_rmin = r_min;
+    m_tab_mixed = mixed;
+    m_tab_dirty = true;
+    }
+
+/*! The number of intervals is doubled, starting from 64, until the largest interpolation error of all type pairs is
+    below the tolerance or the maximum width is reached. The resulting width and error are reported.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::buildTables()
+    {
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+
+    unsigned int n_typpair = m_typpair_idx.getNumElements();
+    std::vector<Scalar4> coeff;
+    std::vector<Scalar2> range(n_typpair);
+
+    unsigned int width = 64;
+    Scalar max_err = Scalar(0.0);
+    while (true)
+        {
+        coeff.resize(2*width*n_typpair);
+        max_err = Scalar(0.0);
+        for (unsigned int cur_typpair = 0; cur_typpair < n_typpair; cur_typpair++)
+            {
+            // the energy is shifted in the same cases as in computeForcesLoop()
+            bool energy_shift = (m_shift_mode == shift) ||
+                (m_shift_mode == xplor && h_ronsq.data[cur_typpair] > h_rcutsq.data[cur_typpair]);
+            Scalar err = tabulateTypePair(h_params.data[cur_typpair], h_rcutsq.data[cur_typpair], energy_shift, width,
+                                          &coeff[2*width*cur_typpair], range[cur_typpair]);
+            max_err = std::max(max_err, err);
+            }
+
+        if (max_err <= m_tab_tol || width >= m_tab_max_width)
+            break;
+        width *= 2;
+        }
+
+    m_tab_width = width;
+    m_tab_idx = Index2D(2*width, n_typpair);
+
+    GlobalArray<Scalar4> tab_coeff(m_tab_idx.getNumElements(), m_exec_conf);
+    m_tab_coeff.swap(tab_coeff);
+    GlobalArray<Scalar2> tab_range(n_typpair, m_exec_conf);
+    m_tab_range.swap(tab_range);
+
+        {
+        ArrayHandle<Scalar4> h_tab_coeff(m_tab_coeff, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar2> h_tab_range(m_tab_range, access_location::host, access_mode::overwrite);
+        std::copy(coeff.begin(), coeff.end(), h_tab_coeff.data);
+        std::copy(range.begin(), range.end(), h_tab_range.data);
+        }
+
+    if (m_tab_mixed)
+        {
+        GlobalArray<float4> tab_coeff_mixed(m_tab_idx.getNumElements(), m_exec_conf);
+        m_tab_coeff_mixed.swap(tab_coeff_mixed);
+
+        ArrayHandle<float4> h_tab_coeff_mixed(m_tab_coeff_mixed, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < coeff.size(); i++)
+            h_tab_coeff_mixed.data[i] = make_float4(float(coeff[i].x), float(coeff[i].y), float(coeff[i].z),
+                                                    float(coeff[i].w));
+        }
+    else
+        {
+        // array is not needed, discard it
+        GlobalArray<float4> tab_coeff_mixed;
+        m_tab_coeff_mixed.swap(tab_coeff_mixed);
+        }
+
+    m_exec_conf->msg->notice(2) << "pair." << evaluator::getName() << ": Tabulated with " << width
+                                << " intervals per type pair, maximum error " << max_err << std::endl;
+    if (max_err > m_tab_tol)
+        m_exec_conf->msg->warning() << "pair." << evaluator::getName() << ": Interpolation error " << max_err
+                                    << " exceeds the tolerance " << m_tab_tol << std::endl;
+
+    m_tab_dirty = false;
+    }
+
+/*! \param param Parameters of the type pair
+    \param rcutsq Cutoff radius squared of the type pair
+    \param energy_shift True if the energy is shifted to zero at the cutoff
+    \param width Number of intervals
+    \param coeff Output array of 2*\a width coefficients (force and energy per interval)
+    \param range Output r_min^2 and inverse interval width of the table
+    \returns The largest interpolation error at the interval midpoints, infinite if a midpoint is not finite
+
+    Type pairs with r_cut <= r_min get an empty table starting at r_cut^2, so every pair inside the cutoff is evaluated
+    directly. Potentials that are singular at small distances (e.g. at the default r_min = 0) are not finite at the
+    first samples. The table then starts at the first finite sample of the grid, and closer pairs are evaluated
+    directly.
+*/
+template< class evaluator >
+Scalar PotentialPair< evaluator >::tabulateTypePair(const param_type& param,
+                                                    Scalar rcutsq,
+                                                    bool energy_shift,
+                                                    unsigned int width,
+                                                    Scalar4 *coeff,
+                                                    Scalar2& range)
+    {
+    Scalar rminsq = m_tab_rmin*m_tab_rmin;
+    if (rcutsq <= rminsq)
+        {
+        range = make_scalar2(rcutsq, Scalar(0.0));
+        std::fill(coeff, coeff + 2*width, make_scalar4(0, 0, 0, 0));
+        return Scalar(0.0);
+        }
+
+    // sample the potential, the last node is taken just inside the cutoff
+    Scalar rsq_max = std::nextafter(rcutsq, Scalar(0.0));
+    auto sample = [&](Scalar rsq, Scalar& force_divr, Scalar& pair_eng)
+        {
+        evaluator eval(std::min(rsq, rsq_max), rcutsq, param);
+        if (!eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift))
+            {
+            force_divr = Scalar(0.0);
+            pair_eng = Scalar(0.0);
+            }
+        };
+
+    // skip the nodes of the grid at which a singular potential is not finite
+    Scalar ds = (rcutsq - rminsq) / Scalar(width);
+    unsigned int first = 0;
+    for (; first < width; first++)
+        {
+        Scalar force_divr, pair_eng;
+        sample(rminsq + Scalar(first)*ds, force_divr, pair_eng);
+        if (std::isfinite(force_divr) && std::isfinite(pair_eng))
+            break;
+        }
+
+    if (first == width)
+        {
+        m_exec_conf->msg->error() << "pair." << evaluator::getName()
+                                  << ": The potential is not finite anywhere between r_min and r_cut" << std::endl;
+        throw std::runtime_error("Error tabulating PotentialPair");
+        }
+
+    rminsq += Scalar(first)*ds;
+    ds = (rcutsq - rminsq) / Scalar(width);
+    range = make_scalar2(rminsq, Scalar(1.0) / ds);
+
+    std::vector<Scalar> F(width+1);
+    std::vector<Scalar> V(width+1);
+    for (unsigned int k = 0; k <= width; k++)
+        {
+        sample(rminsq + Scalar(k)*ds, F[k], V[k]);
+        if (!std::isfinite(F[k]) || !std::isfinite(V[k]))
+            {
+            m_exec_conf->msg->error() << "pair." << evaluator::getName() << ": The potential is not finite at r = "
+                                      << fast::sqrt(rminsq + Scalar(k)*ds) << ", set r_min above this distance"
+                                      << std::endl;
+            throw std::runtime_error("Error tabulating PotentialPair");
+            }
+        }
+
+    // derivatives of the force per interval width (fourth order, one-sided at the ends)
+    std::vector<Scalar> dF(width+1);
+    const unsigned int n = width;
+    dF[0] = (Scalar(-25.0)*F[0] + Scalar(48.0)*F[1] - Scalar(36.0)*F[2] + Scalar(16.0)*F[3] - Scalar(3.0)*F[4])
+        / Scalar(12.0);
+    dF[1] = (Scalar(-3.0)*F[0] - Scalar(10.0)*F[1] + Scalar(18.0)*F[2] - Scalar(6.0)*F[3] + F[4]) / Scalar(12.0);
+    for (unsigned int k = 2; k <= n-2; k++)
+        dF[k] = (F[k-2] - Scalar(8.0)*F[k-1] + Scalar(8.0)*F[k+1] - F[k+2]) / Scalar(12.0);
+    dF[n-1] = (Scalar(3.0)*F[n] + Scalar(10.0)*F[n-1] - Scalar(18.0)*F[n-2] + Scalar(6.0)*F[n-3] - F[n-4])
+        / Scalar(12.0);
+    dF[n] = (Scalar(25.0)*F[n] - Scalar(48.0)*F[n-1] + Scalar(36.0)*F[n-2] - Scalar(16.0)*F[n-3] + Scalar(3.0)*F[n-4])
+        / Scalar(12.0);
+
+    // cubic Hermite coefficients in the local coordinate t in [0,1)
+    auto hermite = [](Scalar p0, Scalar p1, Scalar m0, Scalar m1)
+        {
+        return make_scalar4(p0,
+                            m0,
+                            Scalar(3.0)*(p1 - p0) - Scalar(2.0)*m0 - m1,
+                            Scalar(2.0)*(p0 - p1) + m0 + m1);
+        };
+
+    Scalar max_err = Scalar(0.0);
+    for (unsigned int k = 0; k < width; k++)
+        {
+        // dV/dr^2 = -force_divr/2
+        coeff[2*k] = hermite(F[k], F[k+1], dF[k], dF[k+1]);
+        coeff[2*k+1] = hermite(V[k], V[k+1], Scalar(-0.5)*ds*F[k], Scalar(-0.5)*ds*F[k+1]);
+
+        // measure the error at the midpoint of the interval
+        Scalar rsq = rminsq + (Scalar(k) + Scalar(0.5))*ds;
+        Scalar force_divr, pair_eng;
+        sample(rsq, force_divr, pair_eng);
+
+        const Scalar4& cf = coeff[2*k];
+        const Scalar4& cv = coeff[2*k+1];
+        Scalar t = Scalar(0.5);
+        Scalar force_divr_tab = cf.x + t*(cf.y + t*(cf.z + t*cf.w));
+        Scalar pair_eng_tab = cv.x + t*(cv.y + t*(cv.z + t*cv.w));
+
+        Scalar r = fast::sqrt(rsq);
+        Scalar err_f = std::abs(force_divr_tab - force_divr)*r / std::max(std::abs(force_divr)*r, Scalar(1.0));
+        Scalar err_v = std::abs(pair_eng_tab - pair_eng) / std::max(std::abs(pair_eng), Scalar(1.0));
+
+        // std::max would drop a NaN, a non-finite error must fail the tolerance check
+        if (!std::isfinite(err_f) || !std::isfinite(err_v))
+            max_err = std::numeric_limits<Scalar>::infinity();
+        else
+            max_err = std::max(max_err, std::max(err_f, err_v));
+        }
+
+    return max_err;
     }
 
 template <class evaluator>
@@ -385,6 +708,10 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
 /*! \post The pair forces are computed for the given timestep. The neighborlist's compute method is called to ensure
     that it is up to date before proceeding.
 
+    The potential energy and the virial are only computed when requested by the pdata_flag::potential_energy and
+    pdata_flag::pressure_tensor or pdata_flag::isotropic_virial flags, otherwise they are left zero. Skipped energies
+    are computed on demand by ensureEnergies() when they are read through ForceCompute.
+
     \param timestep specifies the current time step of the simulation
 */
 template< class evaluator >
@@ -396,10 +723,138 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
 
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_energy = flags[pdata_flag::potential_energy];
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    computePairForces(compute_energy, compute_virial);
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! The forces, energies and virials are recomputed from the current neighbor list when the last call to
+    computeForces() skipped the energies.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::ensureEnergies()
+    {
+    if (m_energy_valid)
+        return;
+
+    if (m_prof) m_prof->push(m_prof_name);
+    computePairForces(true, true);
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param compute_energy True if the potential energy is computed
+    \param compute_virial True if the virial is computed
+
+    The inner loop is instantiated for every combination of these options, the shift mode, tabulation, and the
+    neighbor list storage mode, so that a force-only step carries no branches or accumulations for the quantities that
+    are not needed.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computePairForces(bool compute_energy, bool compute_virial)
+    {
+    // sample the potential if tabulation was enabled or the parameters changed
+    if (m_tab_tol > Scalar(0.0) && m_tab_dirty)
+        buildTables();
+
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    // dispatch to the inner loop specialized for the requested quantities
+    switch (4*compute_energy + 2*compute_virial + third_law)
+        {
+        case 0:
+            computeForcesShift<0,0,0>();
+            break;
+        case 1:
+            computeForcesShift<0,0,1>();
+            break;
+        case 2:
+            computeForcesShift<0,1,0>();
+            break;
+        case 3:
+            computeForcesShift<0,1,1>();
+            break;
+        case 4:
+            computeForcesShift<1,0,0>();
+            break;
+        case 5:
+            computeForcesShift<1,0,1>();
+            break;
+        case 6:
+            computeForcesShift<1,1,0>();
+            break;
+        case 7:
+            computeForcesShift<1,1,1>();
+            break;
+        }
+
+    m_energy_valid = compute_energy;
+    }
+
+/*! \tparam compute_energy When non-zero, the potential energy is computed
+    \tparam compute_virial When non-zero, the virial tensor is computed
+    \tparam third_law When non-zero, the neighbor list is half and forces are also applied to the neighbors
+*/
+template< class evaluator >
+template<unsigned int compute_energy, unsigned int compute_virial, unsigned int third_law>
+void PotentialPair< evaluator >::computeForcesShift()
+    {
+    // 0: evaluate directly, 1: interpolate the tables, 2: interpolate the tables in single precision
+    unsigned int tabulated = 0;
+    if (m_tab_tol > Scalar(0.0))
+        tabulated = m_tab_mixed ? 2 : 1;
+
+    switch (3*m_shift_mode + tabulated)
+        {
+        case 3*no_shift:
+            computeForcesLoop<no_shift, compute_energy, compute_virial, third_law, 0>();
+            break;
+        case 3*no_shift+1:
+            computeForcesLoop<no_shift, compute_energy, compute_virial, third_law, 1>();
+            break;
+        case 3*no_shift+2:
+            computeForcesLoop<no_shift, compute_energy, compute_virial, third_law, 2>();
+            break;
+        case 3*shift:
+            computeForcesLoop<shift, compute_energy, compute_virial, third_law, 0>();
+            break;
+        case 3*shift+1:
+            computeForcesLoop<shift, compute_energy, compute_virial, third_law, 1>();
+            break;
+        case 3*shift+2:
+            computeForcesLoop<shift, compute_energy, compute_virial, third_law, 2>();
+            break;
+        case 3*xplor:
+            computeForcesLoop<xplor, compute_energy, compute_virial, third_law, 0>();
+            break;
+        case 3*xplor+1:
+            computeForcesLoop<xplor, compute_energy, compute_virial, third_law, 1>();
+            break;
+        case 3*xplor+2:
+            computeForcesLoop<xplor, compute_energy, compute_virial, third_law, 2>();
+            break;
+        }
+    }
+
+/*! \tparam shift_mode One of the energyShiftMode values
+    \tparam compute_energy When non-zero, the potential energy is computed
+    \tparam compute_virial When non-zero, the virial tensor is computed
+    \tparam third_law When non-zero, the neighbor list is half and forces are also applied to the neighbors
+    \tparam tabulated When non-zero, the force and energy are interpolated from the tables built by buildTables(), in
+                      single precision when it is 2
+
+    When the energy is not needed, the evaluator still returns it, but the compiler is free to drop its computation
+    once the evaluator is inlined (except for XPLOR smoothing, where the force depends on the energy).
+*/
+template< class evaluator >
+template<unsigned int shift_mode, unsigned int compute_energy, unsigned int compute_virial, unsigned int third_law,
+         unsigned int tabulated>
+void PotentialPair< evaluator >::computeForcesLoop()
+    {
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
@@ -420,9 +875,9 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
-
-    PDataFlags flags = this->m_pdata->getFlags();
-    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+    ArrayHandle<Scalar4> h_tab_coeff(m_tab_coeff, access_location::host, access_mode::read);
+    ArrayHandle<Scalar2> h_tab_range(m_tab_range, access_location::host, access_mode::read);
+    ArrayHandle<float4> h_tab_coeff_mixed(m_tab_coeff_mixed, access_location::host, access_mode::read);
 
     // need to start from a zero force, energy and virial
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
@@ -492,16 +947,16 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
             param_type param = h_params.data[typpair_idx];
             Scalar rcutsq = h_rcutsq.data[typpair_idx];
             Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
+            if (shift_mode == xplor)
                 ronsq = h_ronsq.data[typpair_idx];
 
             // design specifies that energies are shifted if
             // 1) shift mode is set to shift
             // or 2) shift mode is explor and ron > rcut
             bool energy_shift = false;
-            if (m_shift_mode == shift)
+            if (shift_mode == shift)
                 energy_shift = true;
-            else if (m_shift_mode == xplor)
+            else if (shift_mode == xplor)
                 {
                 if (ronsq > rcutsq)
                     energy_shift = true;
@@ -510,18 +965,50 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
             // compute the force and potential energy
             Scalar force_divr = Scalar(0.0);
             Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
+            bool evaluated = false;
+            if (tabulated && rsq >= h_tab_range.data[typpair_idx].x)
+                {
+                // interpolate from the table (MEM TRANSFER: 10 scalars / FLOPS: 16)
+                evaluated = rsq < rcutsq;
+                if (evaluated)
+                    {
+                    Scalar2 range = h_tab_range.data[typpair_idx];
+                    Scalar x = (rsq - range.x) * range.y;
+                    unsigned int bin = std::min((unsigned int)x, m_tab_width - 1);
+                    if (tabulated == 2)
+                        {
+                        // the position within the interval is in [0,1], so it loses nothing in single precision
+                        float t = float(x - Scalar(bin));
+                        const float4 cf = h_tab_coeff_mixed.data[m_tab_idx(2*bin, typpair_idx)];
+                        const float4 cv = h_tab_coeff_mixed.data[m_tab_idx(2*bin+1, typpair_idx)];
+                        force_divr = cf.x + t*(cf.y + t*(cf.z + t*cf.w));
+                        pair_eng = cv.x + t*(cv.y + t*(cv.z + t*cv.w));
+                        }
+                    else
+                        {
+                        Scalar t = x - Scalar(bin);
+                        const Scalar4 cf = h_tab_coeff.data[m_tab_idx(2*bin, typpair_idx)];
+                        const Scalar4 cv = h_tab_coeff.data[m_tab_idx(2*bin+1, typpair_idx)];
+                        force_divr = cf.x + t*(cf.y + t*(cf.z + t*cf.w));
+                        pair_eng = cv.x + t*(cv.y + t*(cv.z + t*cv.w));
+                        }
+                    }
+                }
+            else
+                {
+                evaluator eval(rsq, rcutsq, param);
+                if (evaluator::needsDiameter())
+                    eval.setDiameter(di, dj);
+                if (evaluator::needsCharge())
+                    eval.setCharge(qi, qj);
 
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+                evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+                }
 
             if (evaluated)
                 {
                 // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                if (shift_mode == xplor)
                     {
                     if (rsq >= ronsq && rsq < rcutsq)
                         {
@@ -550,7 +1037,8 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
                 fi += dx*force_divr;
-                pei += pair_eng * Scalar(0.5);
+                if (compute_energy)
+                    pei += pair_eng * Scalar(0.5);
                 if (compute_virial)
                     {
                     virialxxi += force_div2r*dx.x*dx.x;
@@ -569,7 +1057,8 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
                     h_force.data[mem_idx].x -= dx.x*force_divr;
                     h_force.data[mem_idx].y -= dx.y*force_divr;
                     h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    if (compute_energy)
+                        h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
                         h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
@@ -588,7 +1077,8 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
         h_force.data[mem_idx].x += fi.x;
         h_force.data[mem_idx].y += fi.y;
         h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        if (compute_energy)
+            h_force.data[mem_idx].w += pei;
         if (compute_virial)
             {
             h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
@@ -599,8 +1089,6 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
             h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
             }
         }
-
-    if (m_prof) m_prof->pop();
     }
 
 #ifdef ENABLE_MPI
@@ -822,6 +1310,7 @@ template < class T > void export_PotentialPair(pybind11::module& m, const std::s
         .def("setRcut", &T::setRcut)
         .def("setRon", &T::setRon)
         .def("setShiftMode", &T::setShiftMode)
+        .def("setTabulation", &T::setTabulation)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
         .def("slotWriteGSDShapeSpec", &T::slotWriteGSDShapeSpec)
         .def("connectGSDShapeSpec", &T::connectGSDShapeSpec)
@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <memory>
 #include <fstream>
+#include <vector>
 
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
@@ -46,6 +47,11 @@
 
     <b>Implementation details</b>
 
+    The triplets are looped over from their central particle i. The distance vectors to all neighbors of i are
+    computed once and cached, since every neighbor takes part in the ij, chi, and ik loops of all other neighbors.
+    With more than one TBB thread, the central particles are distributed over the threads. Forces on the neighbors are
+    then scattered into per-thread buffers, which are summed into the force and virial arrays afterwards.
+
     Unlike the pair potentials, the three-body potentials offer two force directions: ij and ik.
     In addition, some three-body potentials (such as the Tersoff potential) compute unique forces on
     each of the three particles involved.  Three-body evaluators must thus return six force magnitudes:
@@ -99,7 +105,23 @@ class PotentialTersoff : public ForceCompute
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
         #endif
 
+        //! Get the computes that this force brings up to date in compute()
+        virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+            {
+            return std::vector< std::shared_ptr<Compute> >(1, m_nlist);
+            }
+
     protected:
+        //! Cached distance to a neighbor of the current particle
+        struct neighbor_t
+            {
+            Scalar3 dx;                 //!< Minimum image vector from the neighbor to the particle
+            Scalar rsq;                 //!< Squared distance
+            unsigned int idx;           //!< Index of the neighbor
+            unsigned int type;          //!< Type of the neighbor
+            bool interactive;           //!< True if the type pair interacts at all
+            };
+
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
         Index2D m_typpair_idx;                      //!< Helper class for indexing per type pair arrays
         GPUArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
@@ -108,6 +130,19 @@ class PotentialTersoff : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        #ifdef ENABLE_TBB
+        //! Per-thread force and virial accumulators
+        struct thread_buffer_t
+            {
+            std::vector<Scalar4> force;         //!< Forces in the layout of m_force
+            std::vector<Scalar> virial;         //!< Virials in the layout of m_virial
+            std::vector<neighbor_t> neigh;      //!< Neighbor cache of the current particle
+            };
+
+        //! Accumulators of the threads, zero between calls to computeForces()
+        tbb::enumerable_thread_specific<thread_buffer_t> m_thread_buffers;
+        #endif
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
@@ -311,9 +346,11 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
     memset(h_virial.data, 0, sizeof(Scalar)*6*m_virial_pitch);
 
     unsigned int ntypes = m_pdata->getNTypes();
+    unsigned int n_total = m_pdata->getN() + m_pdata->getNGhosts();
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    // compute the contributions of all triplets centered on particle i, forces on the neighbors are added to force
+    // and virial, which have the layout of h_force and h_virial
+    auto compute_particle = [&](unsigned int i, Scalar4 *force, Scalar *virial, std::vector<neighbor_t>& neigh)
         {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -343,36 +380,49 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
         // all neighbors of this particle
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        if (evaluator::hasPerParticleEnergy())
+
+        // cache the distance vectors of all neighbors, they are reused in the ij, chi, and ik loops
+        neigh.resize(size);
+        for (unsigned int j = 0; j < size; j++)
             {
-            for (unsigned int j = 0; j < size; j++)
-                {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+            // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+            unsigned int jj = h_nlist.data[head_i + j];
+            assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+
+            // access the position and type of particle j
+            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+            unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
+            assert(typej < m_pdata->getNTypes());
 
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
+            // calculate dr_ij and apply periodic boundary conditions
+            Scalar3 dxij = box.minImage(posi - posj);
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
+            neighbor_t& n = neigh[j];
+            n.dx = dxij;
+            n.rsq = dot(dxij, dxij);
+            n.idx = jj;
+            n.type = typej;
 
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
+            // areInteractive() only depends on the type pair parameters
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            evaluator temp_eval(n.rsq, h_rcutsq.data[typpair_idx], h_params.data[typpair_idx]);
+            n.interactive = temp_eval.areInteractive();
+            }
 
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+        if (evaluator::hasPerParticleEnergy())
+            {
+            for (unsigned int j = 0; j < size; j++)
+                {
+                const neighbor_t& nj = neigh[j];
 
                 // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                unsigned int typpair_idx = m_typpair_idx(typei, nj.type);
                 param_type param = h_params.data[typpair_idx];
                 Scalar rcutsq = h_rcutsq.data[typpair_idx];
 
                 // evaluate the scalar per-neighbor contribution
-                evaluator eval(rij_sq, rcutsq, param);
-                eval.evalPhi(phi_ab[typej]);
+                evaluator eval(nj.rsq, rcutsq, param);
+                eval.evalPhi(phi_ab[nj.type]);
                 }
 
             // self-energy
@@ -391,27 +441,16 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
         // loop over all of the neighbors of this particle
         for (unsigned int j = 0; j < size; j++)
             {
-            // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-            unsigned int jj = h_nlist.data[head_i + j];
-            assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // access the position and type of particle j
-            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-            unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-            assert(typej < m_pdata->getNTypes());
+            const neighbor_t& nj = neigh[j];
+            unsigned int jj = nj.idx;
+            unsigned int typej = nj.type;
 
             // initialize the current force and potential energy of particle j to 0
             Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
             Scalar pej = 0.0;
 
-            // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 dxij = posi - posj;
-
-            // apply periodic boundary conditions
-            dxij = box.minImage(dxij);
-
-            // compute rij_sq (FLOPS: 5)
-            Scalar rij_sq = dot(dxij, dxij);
+            const Scalar3 dxij = nj.dx;
+            Scalar rij_sq = nj.rsq;
 
             // get parameters for this type pair
             unsigned int typpair_idx = m_typpair_idx(typei, typej);
@@ -439,32 +478,12 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                     {
                     for (unsigned int k = 0; k < size; k++)
                         {
-                        // access the index of neighbor k
-                        unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                        unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                        assert(typek < m_pdata->getNTypes());
-
-                        // access the type pair parameters for i and k
-                        typpair_idx = m_typpair_idx(typei, typek);
-                        param_type temp_param = h_params.data[typpair_idx];
-
-                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                        bool temp_evaluated = temp_eval.areInteractive();
+                        const neighbor_t& nk = neigh[k];
 
-                        if (kk != jj && temp_evaluated)
+                        if (nk.idx != jj && nk.interactive)
                             {
-                            // compute drik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply periodic boundary conditions
-                            dxik = box.minImage(dxik);
-
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            const Scalar3 dxik = nk.dx;
+                            Scalar rik_sq = nk.rsq;
 
                             // compute the bond angle (if needed)
                             Scalar cos_th = Scalar(0.0);
@@ -524,35 +543,16 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                     // evaluate the force from the ik interactions
                     for (unsigned int k = 0; k < size; k++)
                         {
-                        // access the index of neighbor k
-                        unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                        unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                        assert(typek < m_pdata->getNTypes());
-
-                        // access the type pair parameters for i and k
-                        typpair_idx = m_typpair_idx(typei, typek);
-                        param_type temp_param = h_params.data[typpair_idx];
+                        const neighbor_t& nk = neigh[k];
+                        unsigned int kk = nk.idx;
 
-                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                        bool temp_evaluated = temp_eval.areInteractive();
-
-                        if (kk != jj && temp_evaluated)
+                        if (kk != jj && nk.interactive)
                             {
                             // create variable for the force on k
                             Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
 
-                            // compute dr_ik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply periodic boundary conditions
-                            dxik = box.minImage(dxik);
-
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            const Scalar3 dxik = nk.dx;
+                            Scalar rik_sq = nk.rsq;
 
                             // compute the bond angle (if needed)
                             Scalar cos_th = Scalar(0.0);
@@ -613,20 +613,20 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
                             // increment the force for particle k
                             unsigned int mem_idx = kk;
-                            h_force.data[mem_idx].x += fk.x;
-                            h_force.data[mem_idx].y += fk.y;
-                            h_force.data[mem_idx].z += fk.z;
+                            force[mem_idx].x += fk.x;
+                            force[mem_idx].y += fk.y;
+                            force[mem_idx].z += fk.z;
 
                             if (compute_virial)
                                 {
                                 Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.z;
                                 Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.z;
-                                h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
-                                h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
-                                h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
-                                h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
-                                h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
-                                h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
+                                virial[0*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
+                                virial[1*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
+                                virial[2*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
+                                virial[3*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
+                                virial[4*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
+                                virial[5*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
                                 }
                             }
                         }
@@ -634,37 +634,93 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                 }
             // increment the force and potential energy for particle j
             unsigned int mem_idx = jj;
-            h_force.data[mem_idx].x += fj.x;
-            h_force.data[mem_idx].y += fj.y;
-            h_force.data[mem_idx].z += fj.z;
-            h_force.data[mem_idx].w += pej;
+            force[mem_idx].x += fj.x;
+            force[mem_idx].y += fj.y;
+            force[mem_idx].z += fj.z;
+            force[mem_idx].w += pej;
 
             if (compute_virial)
                 {
-                h_virial.data[0*m_virial_pitch+mem_idx] += virialj_xx;
-                h_virial.data[1*m_virial_pitch+mem_idx] += virialj_xy;
-                h_virial.data[2*m_virial_pitch+mem_idx] += virialj_xz;
-                h_virial.data[3*m_virial_pitch+mem_idx] += virialj_yy;
-                h_virial.data[4*m_virial_pitch+mem_idx] += virialj_yz;
-                h_virial.data[5*m_virial_pitch+mem_idx] += virialj_zz;
+                virial[0*m_virial_pitch+mem_idx] += virialj_xx;
+                virial[1*m_virial_pitch+mem_idx] += virialj_xy;
+                virial[2*m_virial_pitch+mem_idx] += virialj_xz;
+                virial[3*m_virial_pitch+mem_idx] += virialj_yy;
+                virial[4*m_virial_pitch+mem_idx] += virialj_yz;
+                virial[5*m_virial_pitch+mem_idx] += virialj_zz;
                 }
             }
         // finally, increment the force and potential energy for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
 
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += viriali_xx;
-            h_virial.data[1*m_virial_pitch+mem_idx] += viriali_xy;
-            h_virial.data[2*m_virial_pitch+mem_idx] += viriali_xz;
-            h_virial.data[3*m_virial_pitch+mem_idx] += viriali_yy;
-            h_virial.data[4*m_virial_pitch+mem_idx] += viriali_yz;
-            h_virial.data[5*m_virial_pitch+mem_idx] += viriali_zz;
+            virial[0*m_virial_pitch+mem_idx] += viriali_xx;
+            virial[1*m_virial_pitch+mem_idx] += viriali_xy;
+            virial[2*m_virial_pitch+mem_idx] += viriali_xz;
+            virial[3*m_virial_pitch+mem_idx] += viriali_yy;
+            virial[4*m_virial_pitch+mem_idx] += viriali_yz;
+            virial[5*m_virial_pitch+mem_idx] += viriali_zz;
             }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // every thread scatters into its own buffers, which are summed up afterwards
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            thread_buffer_t& buf = m_thread_buffers.local();
+            if (buf.force.size() < n_total)
+                buf.force.resize(n_total, make_scalar4(0.0, 0.0, 0.0, 0.0));
+            if (compute_virial && buf.virial.size() < 6*m_virial_pitch)
+                buf.virial.resize(6*m_virial_pitch, Scalar(0.0));
+
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                compute_particle(i, &buf.force[0], compute_virial ? &buf.virial[0] : nullptr, buf.neigh);
+            });
+
+        // reduce the buffers and clear them for the next step
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_total),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (auto buf = m_thread_buffers.begin(); buf != m_thread_buffers.end(); ++buf)
+                {
+                if (buf->force.size() < n_total)
+                    continue;
+
+                for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+                    {
+                    h_force.data[idx].x += buf->force[idx].x;
+                    h_force.data[idx].y += buf->force[idx].y;
+                    h_force.data[idx].z += buf->force[idx].z;
+                    h_force.data[idx].w += buf->force[idx].w;
+                    buf->force[idx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+                    }
+
+                if (compute_virial && buf->virial.size() >= 6*m_virial_pitch)
+                    {
+                    for (unsigned int k = 0; k < 6; ++k)
+                        for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+                            {
+                            h_virial.data[k*m_virial_pitch+idx] += buf->virial[k*m_virial_pitch+idx];
+                            buf->virial[k*m_virial_pitch+idx] = Scalar(0.0);
+                            }
+                    }
+                }
+            });
+        }
+    else
+    #endif
+        {
+        // for each particle
+        std::vector<neighbor_t> neigh;
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            compute_particle(i, h_force.data, h_virial.data, neigh);
         }
 
     if (m_prof) m_prof->pop();
@@ -156,37 +156,14 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // compute the forces on the four particles, and a quarter of the energy and virial of a dihedral
+    auto eval_dihedral = [&](const unsigned int *idx, unsigned int dihedral_type, Scalar3 *f, Scalar& dihedral_eng,
+                             Scalar *dihedral_virial)
         {
-        // lookup the tag of each of the particles participating in the dihedral
-        const DihedralData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
-        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[dihedral.tag[0]];
-        unsigned int idx_b = h_rtag.data[dihedral.tag[1]];
-        unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
-        unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
-
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN()+m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
+        unsigned int idx_d = idx[3];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -276,7 +253,6 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         // compute index into the table and read in values
 
         /// Here we use the table!!
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
         unsigned int value_i = value_f;
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
@@ -287,11 +263,11 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         Scalar T1 = VT1.y;
 
         // compute the linear interpolation coefficient
-        Scalar f = value_f - Scalar(value_i);
+        Scalar frac = value_f - Scalar(value_i);
 
         // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V = V0 + frac * (V1 - V0);
+        Scalar T = T0 + frac * (T1 - T0);
 
         // from Blondel and Karplus 1995
         vec3<Scalar> A = cross(vec3<Scalar>(dab),vec3<Scalar>(dcbm));
@@ -308,11 +284,10 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         // Now, apply the force to each individual atom a,b,c,d
         // and accumulate the energy/virial
         // compute 1/4 of the energy, 1/4 for each atom in the dihedral
-        Scalar dihedral_eng = V*Scalar(0.25);  // the .125 term comes from distributing over the four particles
+        dihedral_eng = V*Scalar(0.25);  // the .125 term comes from distributing over the four particles
 
         // compute 1/4 of the virial, 1/4 for each atom in the dihedral
         // upper triangular version of virial tensor
-        Scalar dihedral_virial[6];
         dihedral_virial[0] = (1./4.)*(dab.x*f_a.x + dcb.x*f_c.x + (ddc.x+dcb.x)*f_d.x);
         dihedral_virial[1] = (1./4.)*(dab.y*f_a.x + dcb.y*f_c.x + (ddc.y+dcb.y)*f_d.x);
         dihedral_virial[2] = (1./4.)*(dab.z*f_a.x + dcb.z*f_c.x + (ddc.z+dcb.z)*f_d.x);
@@ -320,34 +295,84 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         dihedral_virial[4] = (1./4.)*(dab.z*f_a.y + dcb.z*f_c.y + (ddc.z+dcb.z)*f_d.y);
         dihedral_virial[5] = (1./4.)*(dab.z*f_a.z + dcb.z*f_c.z + (ddc.z+dcb.z)*f_d.z);
 
-        h_force.data[idx_a].x += f_a.x;
-        h_force.data[idx_a].y += f_a.y;
-        h_force.data[idx_a].z += f_a.z;
-        h_force.data[idx_a].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_a]  += dihedral_virial[k];
-
-        h_force.data[idx_b].x += f_b.x;
-        h_force.data[idx_b].y += f_b.y;
-        h_force.data[idx_b].z += f_b.z;
-        h_force.data[idx_b].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_b]  += dihedral_virial[k];
-
-        h_force.data[idx_c].x += f_c.x;
-        h_force.data[idx_c].y += f_c.y;
-        h_force.data[idx_c].z += f_c.z;
-        h_force.data[idx_c].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_c]  += dihedral_virial[k];
-
-        h_force.data[idx_d].x += f_d.x;
-        h_force.data[idx_d].y += f_d.y;
-        h_force.data[idx_d].z += f_d.z;
-        h_force.data[idx_d].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
-       }
+        f[0] = f_a;
+        f[1] = f_b;
+        f[2] = f_c;
+        f[3] = f_d;
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // every particle sums the dihedrals it belongs to, so the threads write to disjoint particles
+        m_dihedral_data->forEachParticleGroup([&](unsigned int idx, const unsigned int *members, unsigned int pos,
+                                                  unsigned int dihedral_type)
+            {
+            Scalar3 f[4];
+            Scalar dihedral_eng;
+            Scalar dihedral_virial[6];
+            eval_dihedral(members, dihedral_type, f, dihedral_eng, dihedral_virial);
+
+            h_force.data[idx].x += f[pos].x;
+            h_force.data[idx].y += f[pos].y;
+            h_force.data[idx].z += f[pos].z;
+            h_force.data[idx].w += dihedral_eng;
+            for (int k = 0; k < 6; k++)
+                h_virial.data[virial_pitch*k+idx]  += dihedral_virial[k];
+            });
+        }
+    else
+    #endif
+        {
+        // for each of the dihedrals
+        const unsigned int size = (unsigned int)m_dihedral_data->getN();
+        for (unsigned int i = 0; i < size; i++)
+            {
+            // lookup the tag of each of the particles participating in the dihedral
+            const DihedralData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+            assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
+            assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
+            assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
+            assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
+
+            // transform a and b into indices into the particle data arrays
+            // (MEM TRANSFER: 4 integers)
+            unsigned int idx[4];
+            for (unsigned int j = 0; j < 4; j++)
+                idx[j] = h_rtag.data[dihedral.tag[j]];
+
+            // throw an error if this angle is incomplete
+            if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL || idx[3] == NOT_LOCAL)
+                {
+                this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
+                    dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
+                    << " incomplete." << endl << endl;
+                throw std::runtime_error("Error in dihedral calculation");
+                }
+
+            assert(idx[0] < m_pdata->getN()+m_pdata->getNGhosts());
+            assert(idx[1] < m_pdata->getN()+m_pdata->getNGhosts());
+            assert(idx[2] < m_pdata->getN()+m_pdata->getNGhosts());
+            assert(idx[3] < m_pdata->getN()+m_pdata->getNGhosts());
+
+            Scalar3 f[4];
+            Scalar dihedral_eng;
+            Scalar dihedral_virial[6];
+            eval_dihedral(idx, m_dihedral_data->getTypeByIndex(i), f, dihedral_eng, dihedral_virial);
+
+            // Now, apply the force to each individual atom a,b,c,d
+            // and accumulate the energy/virial
+            for (unsigned int j = 0; j < 4; j++)
+                {
+                h_force.data[idx[j]].x += f[j].x;
+                h_force.data[idx[j]].y += f[j].y;
+                h_force.data[idx[j]].z += f[j].z;
+                h_force.data[idx[j]].w += dihedral_eng;
+                for (int k = 0; k < 6; k++)
+                   h_virial.data[virial_pitch*k+idx[j]]  += dihedral_virial[k];
+                }
+            }
+        }
 
     if (m_prof) m_prof->pop();
     }
@@ -62,8 +62,6 @@ TwoStepBD::~TwoStepBD()
 */
 void TwoStepBD::integrateStepOne(unsigned int timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     // profile this step
     if (m_prof)
         m_prof->push("BD step 1");
@@ -94,9 +92,8 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
     // perform the first half step
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // v(t+deltaT) = random distribution consistent with T
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    m_group->forEachMember([&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
         unsigned int ptag = h_tag.data[j];
 
         // Initialize the RNG
@@ -214,7 +211,7 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
                 h_angmom.data[j] = quat_to_scalar4(p);
                 }
             }
-        }
+        });
 
     // done profiling
     if (m_prof)
@@ -118,8 +118,6 @@ void TwoStepNPTMTK::integrateStepOne(unsigned int timestep)
 
     m_V = m_pdata->getGlobalBox().getVolume(twod);  // current volume
 
-    unsigned int group_size = m_group->getNumMembers();
-
     // profile this step
     if (m_prof)
         m_prof->push("NPT step 1");
@@ -207,10 +205,8 @@ void TwoStepNPTMTK::integrateStepOne(unsigned int timestep)
         Scalar xi_trans = v.variable[1];
         Scalar exp_thermo_fac = exp(-Scalar(1.0/2.0)*(xi_trans+mtk)*m_deltaT);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        m_group->forEachMember([&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
             Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
             Scalar3 accel = h_accel.data[j];
             Scalar3 r = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
@@ -246,7 +242,7 @@ void TwoStepNPTMTK::integrateStepOne(unsigned int timestep)
             h_pos.data[j].x = r.x;
             h_pos.data[j].y = r.y;
             h_pos.data[j].z = r.z;
-            }
+            });
         } // end of GPUArray scope
 
     // Get new local box
@@ -274,10 +270,8 @@ void TwoStepNPTMTK::integrateStepOne(unsigned int timestep)
         ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::read);
         ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        m_group->forEachMember([&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
             quat<Scalar> q(h_orientation.data[j]);
             quat<Scalar> p(h_angmom.data[j]);
             vec3<Scalar> t(h_net_torque.data[j]);
@@ -372,7 +366,7 @@ void TwoStepNPTMTK::integrateStepOne(unsigned int timestep)
 
             h_orientation.data[j] = quat_to_scalar4(q);
             h_angmom.data[j] = quat_to_scalar4(p);
-            }
+            });
         }
 
     if (! m_nph)
@@ -401,8 +395,6 @@ void TwoStepNPTMTK::integrateStepOne(unsigned int timestep)
 */
 void TwoStepNPTMTK::integrateStepTwo(unsigned int timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     const GlobalArray< Scalar4 >& net_force = m_pdata->getNetForce();
 
    // profile this step
@@ -425,10 +417,8 @@ void TwoStepNPTMTK::integrateStepTwo(unsigned int timestep)
     Scalar exp_thermo_fac = exp(-Scalar(1.0/2.0)*(xi_trans+mtk)*m_deltaT);
 
     // perform second half step of NPT integration
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    m_group->forEachMember([&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
         // first, calculate acceleration from the net force
         Scalar m = h_vel.data[j].w;
         Scalar minv = Scalar(1.0) / m;
@@ -454,7 +444,7 @@ void TwoStepNPTMTK::integrateStepTwo(unsigned int timestep)
 
         // store velocity
         h_vel.data[j].x = v.x; h_vel.data[j].y = v.y; h_vel.data[j].z = v.z;
-        }
+        });
 
     if (m_aniso)
         {
@@ -469,10 +459,8 @@ void TwoStepNPTMTK::integrateStepTwo(unsigned int timestep)
         Scalar exp_thermo_fac_rot = exp(-(xi_rot+mtk)*m_deltaT/Scalar(2.0));
 
         // apply rotational (NO_SQUISH) equations of motion
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        m_group->forEachMember([&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
             quat<Scalar> q(h_orientation.data[j]);
             quat<Scalar> p(h_angmom.data[j]);
             vec3<Scalar> t(h_net_torque.data[j]);
@@ -497,7 +485,7 @@ void TwoStepNPTMTK::integrateStepTwo(unsigned int timestep)
             p += m_deltaT*q*t;
 
             h_angmom.data[j] = quat_to_scalar4(p);
-            }
+            });
         }
     } // end GPUArray scope
 
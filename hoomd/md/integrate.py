@@ -82,6 +82,9 @@ class mode_standard(_integrator):
     a new :py:func:`hoomd.run()` will continue from the old state and the integrator variables will re-equilibrate.
     To ensure equilibration from a unique reference state (such as all integrator variables set to zero),
     the method :py:method:reset_methods() can be use to re-initialize the variables.
+
+    Use :py:meth:`set_respa` to evaluate slowly varying forces less often than every time step in a multiple time step
+    (r-RESPA) splitting.
     """
     def __init__(self, dt, aniso=None):
         hoomd.util.print_status_line();
@@ -98,6 +101,9 @@ class mode_standard(_integrator):
         self.cpp_integrator = _md.IntegratorTwoStep(hoomd.context.current.system_definition, dt);
         self.supports_methods = True;
 
+        # multiple time step periods of the forces
+        self.respa_periods = {};
+
         hoomd.context.current.system.setIntegrator(self.cpp_integrator);
 
         hoomd.util.quiet_status();
@@ -159,6 +165,55 @@ class mode_standard(_integrator):
         self.check_initialization();
         self.cpp_integrator.initializeIntegrationMethods();
 
+    def set_respa(self, force, period):
+        R""" Evaluate a force in a multiple time step (r-RESPA) splitting.
+
+        Args:
+            force (:py:mod:`hoomd.md.force`): Force (such as a pair potential or :py:class:`hoomd.md.charge.pppm`)
+                to evaluate less often.
+            period (int): Evaluate *force* every *period* time steps.
+
+        .. versionadded:: 2.9
+
+        By default, all forces are evaluated on every time step of length *dt*. :py:meth:`set_respa` splits off a
+        slowly varying force, such as the long range electrostatics, and evaluates it every *period* time steps only.
+        Its impulse is applied with a weight of *period* on those steps (impulse r-RESPA, see
+        `M. Tuckerman, B. J. Berne, and G. J. Martyna 1992 <http://dx.doi.org/10.1063/1.463137>`_), so *dt* becomes
+        the inner time step of the splitting and *period* \* *dt* the outer time step. All integration methods and
+        rigid bodies work within the splitting. Set *period* to 1 to evaluate the force every step again.
+
+        The force is still evaluated on the time steps on which an analyzer or updater requests the potential energy
+        or the pressure, without contributing to the equations of motion. Integration methods that need the pressure
+        on every step (:py:class:`npt` and :py:class:`nph`) therefore evaluate all forces every step.
+
+        Warning:
+            Choose *period* \* *dt* well below the period of the fastest motion that *force* drives, otherwise the
+            splitting is unstable due to resonances.
+
+        Examples::
+
+            integrator_mode = integrate.mode_standard(dt=0.002)
+            integrator_mode.set_respa(pppm, period=4)
+
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        if int(period) < 1:
+            hoomd.context.msg.error("integrate.mode_standard: RESPA period must be at least 1.\n");
+            raise ValueError("Error setting RESPA period.");
+
+        self.respa_periods[force] = int(period);
+
+    ## \internal
+    # \brief Updates the forces and their multiple time step periods in the reflected c++ class
+    def update_forces(self):
+        _integrator.update_forces(self);
+
+        for force, period in self.respa_periods.items():
+            if force.enabled and period > 1:
+                self.cpp_integrator.setRESPAPeriod(force.cpp_force, period);
+
 
 class nvt(_integration_method):
     R""" NVT Integration via the Nosé-Hoover thermostat.
@@ -560,6 +560,7 @@ class cell(nlist):
         dist_check (bool): Flag to enable / disable distance checking.
         name (str): Optional name for this neighbor list instance.
         deterministic (bool): When True, enable deterministic runs on the GPU by sorting the cell list.
+        mixed_precision (bool): When True, perform the distance checks on the CPU in single precision.
 
     :py:class:`cell` creates a cell list based neighbor list object to which pair potentials can be attached for computing
     non-bonded pairwise interactions. Cell listing allows for *O(N)* construction of the neighbor list. Particles are first
@@ -578,12 +579,18 @@ class cell(nlist):
         nl_c.reset_exclusions([]);
         nl_c.tune()
 
+    With *mixed_precision*, the cell list stores the particle positions as single precision offsets from the corner of
+    their cell, and the distance checks are performed in single precision. Because the offsets are bounded by the cell
+    width, the rounding error does not grow with the box size. The cutoff is padded by the rounding error, so no
+    neighbors are missed. This option has no effect on the GPU.
+
     Note:
         *d_max* should only be set when slj diameter shifting is required by a pair potential. Currently, slj
         is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
         significantly degraded performance or incorrect results.
     """
-    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, deterministic=False):
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, deterministic=False,
+                 mixed_precision=False):
         hoomd.util.print_status_line()
 
         nlist.__init__(self)
@@ -599,6 +606,7 @@ class cell(nlist):
             self.cpp_cl = _hoomd.CellList(hoomd.context.current.system_definition)
             hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
             self.cpp_nlist = _md.NeighborListBinned(hoomd.context.current.system_definition, 0.0, r_buff, self.cpp_cl )
+            self.cpp_nlist.setMixedPrecision(mixed_precision)
         else:
             self.cpp_cl  = _hoomd.CellListGPU(hoomd.context.current.system_definition)
             hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
@@ -409,6 +409,49 @@ class pair(force._force):
                 hoomd.context.msg.error("Invalid mode\n");
                 raise RuntimeError("Error changing parameters in pair force");
 
+    def set_tabulation(self, tolerance, r_min=0.0, mixed_precision=False):
+        R""" Evaluate the potential from interpolation tables.
+
+        Args:
+            tolerance (float): Largest interpolation error of the force and energy. Set to None to evaluate the
+              potential directly again.
+            r_min (float): Smallest pair distance covered by the tables (in distance units). Closer pairs are evaluated
+              directly. When the potential is not finite at *r_min* (e.g. at the default of 0), the tables start at
+              the first finite sample instead.
+            mixed_precision (bool): When True, interpolate the tables in single precision. Forces, energies, and
+              virials are still accumulated in double precision.
+
+        The potential is sampled per type pair on a uniform grid in :math:`r^2` between :math:`r_{\mathrm{min}}` and
+        :math:`r_{\mathrm{cut}}` and evaluated by cubic Hermite interpolation. The grid is refined until the error,
+        measured relative to the magnitude of the force and energy (but at least relative to 1), is below *tolerance*.
+        The resulting number of grid points and error are reported when the tables are built. This makes potentials
+        with exponentials, powers, or trigonometric functions about as cheap as Lennard-Jones. Singular potentials
+        change rapidly near the first finite sample, so set *r_min* close to the smallest expected pair distance to
+        meet the tolerance with a coarse grid.
+
+        Tabulation is only implemented on the CPU, and is not available for potentials that depend on the particle
+        diameter or charge. Single precision interpolation halves the memory traffic of the table lookups and adds a
+        relative error of about :math:`10^{-7}`, so it is only useful with tolerances well above that.
+
+        Examples::
+
+            mypair.set_tabulation(tolerance=1e-6, r_min=0.5)
+            mypair.set_tabulation(tolerance=1e-5, mixed_precision=True)
+            mypair.set_tabulation(tolerance=None)
+
+        """
+        hoomd.util.print_status_line();
+
+        # anisotropic and many-body potentials are not evaluated per pair distance
+        if not hasattr(self.cpp_force, 'setTabulation'):
+            hoomd.context.msg.error("This pair potential cannot be tabulated\n");
+            raise RuntimeError("Error setting tabulation in pair force");
+
+        if tolerance is None:
+            tolerance = 0.0;
+
+        self.cpp_force.setTabulation(tolerance, r_min, mixed_precision);
+
     def process_coeff(self, coeff):
         hoomd.context.msg.error("Bug in hoomd, please report\n");
         raise RuntimeError("Error processing coefficients");
@@ -253,6 +253,22 @@ class analyze_log_hdf5_tests (unittest.TestCase):
             ana.set_params(matrix_quantities = ["mtest1"])
             hoomd.run(100);
 
+    # test that buffered values are written in blocks and at the end of the run
+    def test_buffer(self):
+        def callback(timestep):
+            return numpy.full((2, 3), timestep, dtype=numpy.float32)
+        with hoomd.hdf5.File(self.tmp_file,"a") as h5file:
+            ana = hoomd.hdf5.log(h5file, quantities = ['test1', 'test2'], matrix_quantities=["mtest1"], period = 10, buffer_size=4);
+            ana.register_callback("test1", lambda timestep: timestep)
+            ana.register_callback("mtest1", callback, matrix=True)
+            hoomd.run(95);
+
+            if hoomd.comm.get_rank() == 0:
+                self.assertEqual(h5file["quantities"].shape, (10, 2));
+                numpy.testing.assert_array_equal(h5file["quantities"][:, 0], numpy.arange(0, 100, 10));
+                self.assertEqual(h5file["mtest1"].shape, (10, 2, 3));
+                self.assertEqual(h5file["mtest1"][3, 1, 2], 30);
+
     # test the initialization checks
     def test_init_checks(self):
         with hoomd.hdf5.File(self.tmp_file,"a") as h5file:
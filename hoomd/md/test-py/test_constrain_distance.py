@@ -132,5 +132,58 @@ class constrain_distance_tests (unittest.TestCase):
         del self.nl
         context.initialize();
 
+# test many independent molecules, including one large enough for the sparse block solver
+class constrain_distance_block_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        n_triangle = 20
+        n_chain = 41
+        snap = data.make_snapshot(N=3*n_triangle+n_chain,box=data.boxdim(L=60),particle_types=['A'])
+
+        if comm.get_rank() == 0:
+            for i in range(n_triangle):
+                x = -25 + 2.5*(i % 10)
+                y = -20 + 5*(i // 10)
+                snap.particles.position[3*i] = (x,y,0)
+                snap.particles.position[3*i+1] = (x+1,y,0)
+                snap.particles.position[3*i+2] = (x,y+1,0)
+
+            for i in range(n_chain):
+                snap.particles.position[3*n_triangle+i] = (-25+i,10,(i % 2)*0.5)
+
+            snap.particles.velocity[:] = [((i*7 % 5)-2, (i*3 % 5)-2, (i % 3)-1) for i in range(snap.particles.N)]
+            snap.particles.velocity[:] *= 0.2
+
+        self.system = init.read_snapshot(snap)
+
+        self.lengths = []
+        for i in range(n_triangle):
+            for a,b,d in [(0,1,1.0),(0,2,1.0),(1,2,math.sqrt(2.0))]:
+                self.system.constraints.add(3*i+a,3*i+b,d)
+                self.lengths.append((3*i+a,3*i+b,d))
+
+        d = math.sqrt(1+0.5**2)
+        for i in range(n_chain-1):
+            self.system.constraints.add(3*n_triangle+i,3*n_triangle+i+1,d)
+            self.lengths.append((3*n_triangle+i,3*n_triangle+i+1,d))
+
+    # test that the distances in all molecules are maintained
+    def test_distances(self):
+        md.constrain.distance()
+        md.integrate.mode_standard(dt=0.002)
+        md.integrate.nve(group=group.all())
+        run(200)
+
+        box = self.system.box
+        for a,b,d in self.lengths:
+            pa = self.system.particles[a].position
+            pb = self.system.particles[b].position
+            r = box.min_image((pa[0]-pb[0], pa[1]-pb[1], pa[2]-pb[2]))
+            self.assertAlmostEqual(math.sqrt(r[0]*r[0]+r[1]*r[1]+r[2]*r[2]),d,3)
+
+    def tearDown(self):
+        del self.system
+        context.initialize();
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
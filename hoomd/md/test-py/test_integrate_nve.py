@@ -11,8 +11,8 @@ import os
 class integrate_nve_tests (unittest.TestCase):
     def setUp(self):
         print
-        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
-        md.force.constant(fx=0.1, fy=0.1, fz=0.1)
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+        self.const = md.force.constant(fx=0.1, fy=0.1, fz=0.1)
 
         context.current.sorter.set_params(grid=8)
 
@@ -65,6 +65,27 @@ class integrate_nve_tests (unittest.TestCase):
         # second call does nothing
         nve.enable()
 
+    # test that a force in a RESPA splitting gives the same impulse over a whole number of outer steps
+    def test_respa(self):
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+        mode.set_respa(self.const, period=4);
+        run(100);
+
+        snap = self.s.take_snapshot()
+        if comm.get_rank() == 0:
+            for v in snap.particles.velocity:
+                self.assertAlmostEqual(v[0], 100*0.005*0.1, 5);
+
+        # the period can be reset
+        mode.set_respa(self.const, period=1);
+        run(1);
+
+    # test invalid RESPA periods
+    def test_respa_invalid(self):
+        mode = md.integrate.mode_standard(dt=0.005);
+        self.assertRaises(ValueError, mode.set_respa, self.const, 0);
+
     def tearDown(self):
         context.initialize();
 
@@ -40,6 +40,24 @@ class pair_morse_tests (unittest.TestCase):
         p.set_params(mode="xplor");
         self.assertRaises(RuntimeError, p.set_params, mode="blah");
 
+    # test that the tabulated potential reproduces the energy
+    def test_tabulation(self):
+        p = md.pair.morse(r_cut=3.0, nlist = self.nl);
+        p.pair_coeff.set('A', 'A', D0=1.0, alpha=3.0, r0=1.0);
+        log = analyze.log(filename=None, quantities=['potential_energy'], period=1);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(group=group.all());
+        run(1);
+        e_direct = log.query('potential_energy');
+
+        p.set_tabulation(tolerance=1e-6, r_min=0.5);
+        run(1);
+        self.assertAlmostEqual(e_direct, log.query('potential_energy'), 3);
+
+        p.set_tabulation(tolerance=None);
+        run(1);
+        self.assertAlmostEqual(e_direct, log.query('potential_energy'), 3);
+
     # test nlist subscribe
     def test_nlist_subscribe(self):
         p = md.pair.morse(r_cut=2.5, nlist = self.nl);
@@ -0,0 +1,69 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md;
+context.initialize()
+import unittest
+import os
+import tempfile
+import numpy
+
+# hoomd.replay
+class replay_tests (unittest.TestCase):
+    def setUp(self):
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.gsd');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+        self.s = init.create_lattice(lattice.sc(a=1.2),n=[4,4,4]);
+        for i in range(0, len(self.s.particles), 3):
+            self.s.particles[i].velocity = (1.0, -0.5, 0.25);
+
+        nl = md.nlist.cell()
+        self.lj = md.pair.lj(r_cut=2.5, nlist = nl);
+        self.lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+        self.log = analyze.log(filename=None, quantities=['potential_energy', 'pressure'], period=10);
+
+    # energies evaluated on the frames match the ones of the simulation
+    def test_energy(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=10, overwrite=True, dynamic=['momentum']);
+
+        ref = [];
+        run(31, callback_period=10, callback=lambda step: ref.append((step, self.log.query('potential_energy'))));
+
+        replayed = [];
+        replay(self.tmp_file, callback=lambda step: replayed.append((step, self.log.query('potential_energy'))));
+
+        self.assertEqual(len(replayed), 4);
+        self.assertEqual(get_step(), 31);
+        for (s1, e1), (s2, e2) in zip(ref, replayed):
+            self.assertEqual(s1, s2);
+            self.assertAlmostEqual(e1, e2, places=3);
+
+    # a stride selects frames and a negative callback value ends the replay
+    def test_stride(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=10, overwrite=True);
+        run(41);
+
+        steps = [];
+        replay(self.tmp_file, start=1, stride=2, callback=lambda step: steps.append(step));
+        self.assertEqual(steps, [10, 30]);
+
+        steps = [];
+        def stop(step):
+            steps.append(step);
+            return -1;
+        replay(self.tmp_file, callback=stop);
+        self.assertEqual(steps, [0]);
+
+    def tearDown(self):
+        if comm.get_rank() == 0:
+            os.remove(self.tmp_file);
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
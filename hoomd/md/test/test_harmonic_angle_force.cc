@@ -24,6 +24,7 @@ using namespace std;
 using namespace std::placeholders;
 
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/thread_test_utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -388,6 +389,45 @@ void angle_force_comparison_tests(angleforce_creator af_creator1, angleforce_cre
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compares the forces computed with one and with several threads
+void angle_force_thread_tests(angleforce_creator af_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // randomly place particles and connect them into a chain of angles
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->angle_data.type_mapping.push_back("A");
+
+    // the threads sum the contributions of each particle in a different order
+    check_threads_close(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        sysdef->getParticleData()->setFlags(~PDataFlags(0));
+
+        std::shared_ptr<HarmonicAngleForceCompute> fc = af_creator(sysdef);
+        fc->setParams(0, Scalar(1.0), Scalar(1.348));
+
+        for (unsigned int i = 0; i < N-2; i++)
+            {
+            sysdef->getAngleData()->addBondedGroup(Angle(0, i, i+1, i+2));
+            }
+
+        fc->compute(0);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch = fc->getVirialArray().getPitch();
+        append_values(values, h_force.data, N);
+        for (unsigned int k = 0; k < 6; k++)
+            append_values(values, h_virial.data + k*pitch, N);
+        return values;
+        }, double(tol_small));
+    }
+#endif
+
 //! HarmonicAngleForceCompute creator for angle_force_basic_tests()
 std::shared_ptr<HarmonicAngleForceCompute> base_class_af_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -412,6 +452,15 @@ UP_TEST( HarmonicAngleForceCompute_basic )
     angle_force_basic_tests(af_creator, exec_conf);
     }
 
+#ifdef ENABLE_TBB
+//! test case for threaded angle forces on the CPU
+UP_TEST( HarmonicAngleForceCompute_threads )
+    {
+    angleforce_creator af_creator = bind(base_class_af_creator, _1);
+    angle_force_thread_tests(af_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for angle forces on the GPU
 UP_TEST( HarmonicAngleForceComputeGPU_basic )
@@ -25,6 +25,7 @@ using namespace std::placeholders;
 */
 
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/thread_test_utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -443,6 +444,45 @@ void const_force_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
     }
     }
 
+#ifdef ENABLE_TBB
+//! Compares the forces computed with one and with several threads
+void bond_force_thread_tests(bondforce_creator bf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // randomly place particles and connect them into a chain of bonds
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->bond_data.type_mapping.push_back("A");
+
+    // the threads sum the contributions of each particle in a different order
+    check_threads_close(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        sysdef->getParticleData()->setFlags(~PDataFlags(0));
+
+        std::shared_ptr<PotentialBondHarmonic> fc = bf_creator(sysdef);
+        fc->setParams(0, make_scalar2(Scalar(300.0), Scalar(1.6)));
+
+        for (unsigned int i = 0; i < N-1; i++)
+            {
+            sysdef->getBondData()->addBondedGroup(Bond(0, i, i+1));
+            }
+
+        fc->compute(0);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch = fc->getVirialArray().getPitch();
+        append_values(values, h_force.data, N);
+        for (unsigned int k = 0; k < 6; k++)
+            append_values(values, h_virial.data + k*pitch, N);
+        return values;
+        }, double(tol_small));
+    }
+#endif
+
 //! PotentialBondHarmonic creator for bond_force_basic_tests()
 std::shared_ptr<PotentialBondHarmonic> base_class_bf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -464,6 +504,15 @@ UP_TEST( PotentialBondHarmonic_basic )
     bond_force_basic_tests(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for threaded bond forces on the CPU
+UP_TEST( PotentialBondHarmonic_threads )
+    {
+    bondforce_creator bf_creator = bind(base_class_bf_creator, _1);
+    bond_force_thread_tests(bf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for bond forces on the GPU
 UP_TEST( PotentialBondHarmonicGPU_basic )
@@ -24,6 +24,7 @@ using namespace std;
 using namespace std::placeholders;
 
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/thread_test_utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
@@ -542,6 +543,45 @@ void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
     }
 
 
+#ifdef ENABLE_TBB
+//! Compares the forces computed with one and with several threads
+void dihedral_force_thread_tests(dihedralforce_creator tf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // randomly place particles and connect them into a chain of dihedrals
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    snap->dihedral_data.type_mapping.push_back("A");
+
+    // the threads sum the contributions of each particle in a different order
+    check_threads_close(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        sysdef->getParticleData()->setFlags(~PDataFlags(0));
+
+        std::shared_ptr<HarmonicDihedralForceCompute> fc = tf_creator(sysdef);
+        fc->setParams(0, Scalar(3.0), -1, 3, Scalar(0.0));
+
+        for (unsigned int i = 0; i < N-3; i++)
+            {
+            sysdef->getDihedralData()->addBondedGroup(Dihedral(0, i, i+1, i+2, i+3));
+            }
+
+        fc->compute(0);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch = fc->getVirialArray().getPitch();
+        append_values(values, h_force.data, N);
+        for (unsigned int k = 0; k < 6; k++)
+            append_values(values, h_virial.data + k*pitch, N);
+        return values;
+        }, double(tol_small));
+    }
+#endif
+
 //! HarmonicDihedralForceCompute creator for dihedral_force_basic_tests()
 std::shared_ptr<HarmonicDihedralForceCompute> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -565,6 +605,15 @@ UP_TEST( HarmonicDihedralForceCompute_basic )
     dihedral_force_phase_shift(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for threaded dihedral forces on the CPU
+UP_TEST( HarmonicDihedralForceCompute_threads )
+    {
+    dihedralforce_creator tf_creator = bind(base_class_tf_creator, _1);
+    dihedral_force_thread_tests(tf_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for dihedral forces on the GPU
 UP_TEST( HarmonicDihedralForceComputeGPU_basic )
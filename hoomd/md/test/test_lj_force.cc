@@ -176,6 +176,116 @@ void lj_force_particle_test(ljforce_creator lj_creator, std::shared_ptr<Executio
     }
     }
 
+//! Tests that the energy and virial are only computed when requested by the particle data flags, or on demand
+void lj_force_flags_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_3(new SystemDefinition(3, BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_3 = sysdef_3->getParticleData();
+    pdata_3->setFlags(PDataFlags(0));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_3->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 0.0;
+    h_pos.data[1].x = Scalar(pow(2.0,1.0/6.0)); h_pos.data[1].y = h_pos.data[1].z = 0.0;
+    h_pos.data[2].x = Scalar(2.0*pow(2.0,1.0/6.0)); h_pos.data[2].y = h_pos.data[2].z = 0.0;
+    }
+    std::shared_ptr<NeighborListTree> nlist_3(new NeighborListTree(sysdef_3, Scalar(1.3), Scalar(3.0)));
+    std::shared_ptr<PotentialPairLJ> fc_3 = lj_creator(sysdef_3, nlist_3);
+    fc_3->setRcut(0, 0, Scalar(1.3));
+    fc_3->setShiftMode(PotentialPairLJ::xplor);
+
+    Scalar epsilon = Scalar(1.15);
+    Scalar sigma = Scalar(1.2);
+    Scalar alpha = Scalar(0.45);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = alpha * Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    fc_3->setParams(0,0,make_scalar2(lj1,lj2));
+    fc_3->setRon(0, 0, Scalar(1.0));
+
+    // forces only
+    fc_3->compute(0);
+
+    Scalar fx[3];
+    {
+    ArrayHandle<Scalar4> h_force(fc_3->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial(fc_3->getVirialArray(),access_location::host,access_mode::read);
+    unsigned int pitch = fc_3->getVirialArray().getPitch();
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        fx[i] = h_force.data[i].x;
+        MY_CHECK_SMALL(h_force.data[i].w, tol_small);
+        MY_CHECK_SMALL(h_virial.data[0*pitch+i], tol_small);
+        }
+    }
+
+    // request the energy and virial, the forces must not change
+    pdata_3->setFlags(~PDataFlags(0));
+    fc_3->compute(1);
+
+    {
+    ArrayHandle<Scalar4> h_force(fc_3->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial(fc_3->getVirialArray(),access_location::host,access_mode::read);
+    unsigned int pitch = fc_3->getVirialArray().getPitch();
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        MY_CHECK_SMALL(h_force.data[i].x - fx[i], tol_small);
+        UP_ASSERT(h_force.data[i].w != Scalar(0.0));
+        UP_ASSERT(h_virial.data[0*pitch+i] != Scalar(0.0));
+        }
+    }
+    Scalar energy = fc_3->calcEnergySum();
+
+    // skip the energy again, reading it computes it on demand
+    pdata_3->setFlags(PDataFlags(0));
+    fc_3->compute(2);
+    MY_CHECK_CLOSE(fc_3->calcEnergySum(), energy, tol);
+    }
+
+//! Tests that tabulating LJ from the default r_min = 0 skips the singularity
+void lj_force_tabulation_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // a pair in the first intervals of the table and a pair at a typical distance
+    std::shared_ptr<SystemDefinition> sysdef_4(new SystemDefinition(4, BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_4 = sysdef_4->getParticleData();
+    pdata_4->setFlags(~PDataFlags(0));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_4->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 0.0;
+    h_pos.data[1].x = Scalar(0.012); h_pos.data[1].y = h_pos.data[1].z = 0.0;
+    h_pos.data[2].x = Scalar(10.0); h_pos.data[2].y = h_pos.data[2].z = 0.0;
+    h_pos.data[3].x = Scalar(11.0); h_pos.data[3].y = h_pos.data[3].z = 0.0;
+    }
+    std::shared_ptr<NeighborListTree> nlist_4(new NeighborListTree(sysdef_4, Scalar(1.3), Scalar(3.0)));
+    std::shared_ptr<PotentialPairLJ> fc_direct = lj_creator(sysdef_4, nlist_4);
+    std::shared_ptr<PotentialPairLJ> fc_tab = lj_creator(sysdef_4, nlist_4);
+    fc_tab->setTabulation(Scalar(1e-5), Scalar(0.0));
+
+    fc_direct->setRcut(0, 0, Scalar(1.3));
+    fc_tab->setRcut(0, 0, Scalar(1.3));
+    fc_direct->setParams(0, 0, make_scalar2(Scalar(4.0), Scalar(4.0)));
+    fc_tab->setParams(0, 0, make_scalar2(Scalar(4.0), Scalar(4.0)));
+    fc_direct->compute(0);
+    fc_tab->compute(0);
+
+    ArrayHandle<Scalar4> h_force_direct(fc_direct->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_tab(fc_tab->getForceArray(), access_location::host, access_mode::read);
+
+    // the table starts at the first finite sample, closer to the singularity it is not accurate but finite
+    for (unsigned int i = 0; i < 2; i++)
+        {
+        UP_ASSERT(std::isfinite(h_force_tab.data[i].x));
+        UP_ASSERT(std::isfinite(h_force_tab.data[i].w));
+        }
+
+    // at typical distances the table matches the direct evaluation
+    for (unsigned int i = 2; i < 4; i++)
+        {
+        MY_CHECK_CLOSE(h_force_tab.data[i].x, h_force_direct.data[i].x, tol);
+        MY_CHECK_SMALL(h_force_tab.data[i].w - h_force_direct.data[i].w, tol_small);
+        }
+    }
+
 //! Tests the ability of a LJForceCompute to handle periodic boundary conditions
 void lj_force_periodic_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -563,6 +673,20 @@ UP_TEST( PotentialPairLJ_periodic )
     lj_force_periodic_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for the energy and virial flags on CPU
+UP_TEST( PotentialPairLJ_flags )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_flags_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for tabulation from the default r_min on CPU
+UP_TEST( PotentialPairLJ_tabulation )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_tabulation_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 //! test case for particle test on CPU
 UP_TEST( PotentialPairLJ_shift )
     {
@@ -209,6 +209,24 @@ std::shared_ptr<PotentialPairMorse> base_class_morse_creator(std::shared_ptr<Sys
     return std::shared_ptr<PotentialPairMorse>(new PotentialPairMorse(sysdef, nlist));
     }
 
+//! PotentialPairMorse creator for unit tests, with tabulation enabled
+std::shared_ptr<PotentialPairMorse> tabulated_morse_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                            std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairMorse> morse(new PotentialPairMorse(sysdef, nlist));
+    morse->setTabulation(Scalar(1e-5), Scalar(0.5));
+    return morse;
+    }
+
+//! PotentialPairMorse creator for unit tests, with tabulation in mixed precision
+std::shared_ptr<PotentialPairMorse> mixed_tabulated_morse_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                                  std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairMorse> morse(new PotentialPairMorse(sysdef, nlist));
+    morse->setTabulation(Scalar(1e-5), Scalar(0.5), true);
+    return morse;
+    }
+
 #ifdef ENABLE_CUDA
 //! PotentialPairMorseGPU creator for unit tests
 std::shared_ptr<PotentialPairMorseGPU> gpu_morse_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -227,6 +245,33 @@ UP_TEST( MorseForce_particle )
     morse_force_particle_test(morse_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for particle test on CPU with tabulation
+UP_TEST( MorseForceTabulated_particle )
+    {
+    morseforce_creator morse_creator_tab = bind(tabulated_morse_creator, _1, _2);
+    morse_force_particle_test(morse_creator_tab, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing the tabulated to the directly evaluated potential
+UP_TEST( MorseForceTabulated_compare )
+    {
+    morseforce_creator morse_creator_tab = bind(tabulated_morse_creator, _1, _2);
+    morseforce_creator morse_creator_base = bind(base_class_morse_creator, _1, _2);
+    morse_force_comparison_test(morse_creator_base,
+                                morse_creator_tab,
+                                std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing the tabulated potential in mixed precision to the directly evaluated potential
+UP_TEST( MorseForceTabulatedMixed_compare )
+    {
+    morseforce_creator morse_creator_mixed = bind(mixed_tabulated_morse_creator, _1, _2);
+    morseforce_creator morse_creator_base = bind(base_class_morse_creator, _1, _2);
+    morse_force_comparison_test(morse_creator_base,
+                                morse_creator_mixed,
+                                std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 # ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( MorseForceGPU_particle )
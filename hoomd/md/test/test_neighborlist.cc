@@ -989,6 +989,17 @@ void neighborlist_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+//! NeighborListBinned with single precision distance checks
+class NeighborListBinnedMixed : public NeighborListBinned
+    {
+    public:
+        NeighborListBinnedMixed(std::shared_ptr<SystemDefinition> sysdef, Scalar r_cut, Scalar r_buff)
+            : NeighborListBinned(sysdef, r_cut, r_buff)
+            {
+            setMixedPrecision(true);
+            }
+    };
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template <class NL>
 void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1303,6 +1314,11 @@ UP_TEST( NeighborListBinned_2d )
     {
     neighborlist_2d_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! comparison test case for binned class with single precision distance checks
+UP_TEST( NeighborListBinnedMixed_comparison )
+    {
+    neighborlist_comparison_test<NeighborListBinned, NeighborListBinnedMixed>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 
 ////////////////////
 // STENCIL CPU
@@ -16,6 +16,7 @@
 #include "hoomd/md/TwoStepNVEGPU.h"
 #endif
 
+#include "hoomd/md/TwoStepLangevin.h"
 #include "hoomd/md/IntegratorTwoStep.h"
 
 #include "hoomd/md/AllPairPotentials.h"
@@ -37,6 +38,7 @@ using namespace std::placeholders;
 */
 
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/thread_test_utils.h"
 HOOMD_UP_MAIN();
 
 //! Typedef'd NVEUpdater class factory
@@ -435,6 +437,139 @@ void nve_updater_aniso_test(std::shared_ptr<ExecutionConfiguration> exec_conf, t
         }
     }
 
+#ifdef ENABLE_TBB
+//! Compare the net force of force computes evaluated in sequence and concurrently
+void nve_updater_concurrent_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    SimpleCubicInitializer cubic_init(10, Scalar(1.2), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = cubic_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    // two pair potentials share the neighbor list, the constant force is independent
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    std::shared_ptr<PotentialPairLJ> fc1(new PotentialPairLJ(sysdef, nlist));
+    fc1->setRcut(0, 0, Scalar(3.0));
+    fc1->setParams(0,0,make_scalar2(Scalar(4.0)*pow(Scalar(1.2),Scalar(12.0)), Scalar(4.0)*pow(Scalar(1.2),Scalar(6.0))));
+    std::shared_ptr<PotentialPairYukawa> fc2(new PotentialPairYukawa(sysdef, nlist));
+    fc2->setRcut(0, 0, Scalar(2.5));
+    fc2->setParams(0,0,make_scalar2(Scalar(1.0),Scalar(0.5)));
+    std::shared_ptr<ConstForceCompute> fc3(new ConstForceCompute(sysdef, 0.5, -0.25, 1.0));
+
+    std::shared_ptr<IntegratorTwoStep> integrator(new IntegratorTwoStep(sysdef, Scalar(0.005)));
+    integrator->addForceCompute(fc1);
+    integrator->addForceCompute(fc2);
+    integrator->addForceCompute(fc3);
+
+    // the forces are summed in the same order, so the results agree to the last bit
+    unsigned int timestep = 0;
+    check_threads_identical(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        integrator->evaluateForces(timestep++);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(pdata->getNetVirial(), access_location::host, access_mode::read);
+        unsigned int pitch = pdata->getNetVirial().getPitch();
+        append_values(values, h_net_force.data, pdata->getN());
+        for (unsigned int k = 0; k < 6; k++)
+            append_values(values, h_net_virial.data + k*pitch, pdata->getN());
+        return values;
+        });
+    }
+
+//! Check that the integrated trajectory and the kinetic energy do not depend on the number of threads
+void nve_updater_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    SimpleCubicInitializer cubic_init(12, Scalar(1.2), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = cubic_init.getSnapshot();
+    for (unsigned int i = 0; i < snap->particle_data.size; i++)
+        snap->particle_data.vel[i] = vec3<Scalar>(sin(Scalar(i)), cos(Scalar(3*i)), sin(Scalar(7*i)));
+
+    // the members are summed in the same order, so the results agree to the last bit
+    check_threads_identical(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+        std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, pdata->getN()-1));
+        std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+        std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+        std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+        fc->setRcut(0, 0, Scalar(3.0));
+        fc->setParams(0,0,make_scalar2(Scalar(4.0)*pow(Scalar(1.2),Scalar(12.0)), Scalar(4.0)*pow(Scalar(1.2),Scalar(6.0))));
+
+        std::shared_ptr<IntegratorTwoStep> nve(new IntegratorTwoStep(sysdef, Scalar(0.005)));
+        nve->addIntegrationMethod(std::shared_ptr<TwoStepNVE>(new TwoStepNVE(sysdef, group_all)));
+        nve->addForceCompute(fc);
+        std::shared_ptr<ComputeThermo> thermo(new ComputeThermo(sysdef, group_all));
+        thermo->setNDOF(nve->getNDOF(group_all));
+
+        nve->prepRun(0);
+        for (unsigned int i = 0; i < 20; i++)
+            nve->update(i);
+        thermo->compute(20);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        append_values(values, h_pos.data, pdata->getN());
+        append_values(values, h_vel.data, pdata->getN());
+        values.push_back(thermo->getTranslationalKineticEnergy());
+        return values;
+        });
+    }
+
+//! Check that the Langevin trajectory and the tallied reservoir energy do not depend on the number of threads
+void langevin_updater_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    SimpleCubicInitializer cubic_init(12, Scalar(1.2), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = cubic_init.getSnapshot();
+    for (unsigned int i = 0; i < snap->particle_data.size; i++)
+        snap->particle_data.vel[i] = vec3<Scalar>(sin(Scalar(i)), cos(Scalar(3*i)), sin(Scalar(7*i)));
+
+    // the random forces depend only on the seed, tag and time step, and the reservoir energy is summed in fixed
+    // blocks, so the results agree to the last bit
+    check_threads_identical(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+        std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, pdata->getN()-1));
+        std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+        std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+        std::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+        fc->setRcut(0, 0, Scalar(3.0));
+        fc->setParams(0,0,make_scalar2(Scalar(4.0)*pow(Scalar(1.2),Scalar(12.0)), Scalar(4.0)*pow(Scalar(1.2),Scalar(6.0))));
+
+        std::shared_ptr<Variant> T(new VariantConst(1.5));
+        std::shared_ptr<TwoStepLangevin> langevin(new TwoStepLangevin(sysdef, group_all, T, 123, false, Scalar(1.0),
+                                                                      false, false, ""));
+        langevin->setTally(true);
+
+        std::shared_ptr<IntegratorTwoStep> integrator(new IntegratorTwoStep(sysdef, Scalar(0.005)));
+        integrator->addIntegrationMethod(langevin);
+        integrator->addForceCompute(fc);
+
+        integrator->prepRun(0);
+        for (unsigned int i = 0; i < 20; i++)
+            integrator->update(i);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        append_values(values, h_pos.data, pdata->getN());
+        append_values(values, h_vel.data, pdata->getN());
+
+        bool my_quantity_flag = false;
+        values.push_back(langevin->getLogValue("langevin_reservoir_energy", 20, my_quantity_flag));
+        UP_ASSERT(my_quantity_flag);
+        return values;
+        });
+    }
+#endif
+
 //! TwoStepNVE factory for the unit tests
 std::shared_ptr<TwoStepNVE> base_class_nve_creator(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<ParticleGroup> group)
     {
@@ -477,6 +612,26 @@ UP_TEST( TwoStepNVE_aniso_test )
     nve_updater_aniso_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),bind(base_class_nve_creator, _1, _2));
     }
 
+#ifdef ENABLE_TBB
+//! Compares sequential and concurrent evaluation of the force computes
+UP_TEST( TwoStepNVE_concurrent_test )
+    {
+    nve_updater_concurrent_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! Compares trajectories integrated with one and several threads
+UP_TEST( TwoStepNVE_threads_test )
+    {
+    nve_updater_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! Compares Langevin trajectories and reservoir energies integrated with one and several threads
+UP_TEST( TwoStepLangevin_threads_test )
+    {
+    langevin_updater_threads_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 //! Need work on NVEUpdaterGPU with rigid bodies to test these cases
 #ifdef ENABLE_CUDA
 //! test case for base class integration tests
@@ -0,0 +1,82 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+
+#include <functional>
+#include <memory>
+
+#include "hoomd/md/AllTripletPotentials.h"
+
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/Initializers.h"
+#include "hoomd/SnapshotSystemData.h"
+
+using namespace std;
+using namespace std::placeholders;
+
+/*! \file test_tersoff_force.cc
+    \brief Implements unit tests for PotentialTripletTersoff
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+#include "hoomd/test/thread_test_utils.h"
+
+HOOMD_UP_MAIN();
+
+#ifdef ENABLE_TBB
+//! Compares the forces, energies and virials computed with one and with several threads
+void tersoff_force_thread_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+
+    // the threads scatter into their own buffers, which sum the contributions in a different order
+    check_threads_close(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+        pdata->setFlags(~PDataFlags(0));
+
+        // the three-body potential needs a full neighbor list
+        std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(2.0), Scalar(0.4)));
+        nlist->setStorageMode(NeighborList::full);
+
+        std::shared_ptr<PotentialTripletTersoff> fc(new PotentialTripletTersoff(sysdef, nlist));
+        fc->setRcut(0, 0, Scalar(2.0));
+        fc->setParams(0, 0, make_tersoff_params(Scalar(0.2),
+                                                make_scalar2(Scalar(1.0), Scalar(1.0)),
+                                                make_scalar2(Scalar(2.0), Scalar(1.0)),
+                                                Scalar(1.5),
+                                                Scalar(1.0),
+                                                Scalar(0.5),
+                                                Scalar(1.0),
+                                                make_scalar3(Scalar(1.0), Scalar(1.0), Scalar(0.0)),
+                                                Scalar(3.0)));
+        fc->compute(0);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        unsigned int pitch = fc->getVirialArray().getPitch();
+        append_values(values, h_force.data, pdata->getN());
+        for (unsigned int k = 0; k < 6; k++)
+            append_values(values, h_virial.data + k*pitch, pdata->getN());
+        return values;
+        }, double(tol_small));
+    }
+
+//! test case for comparing the forces computed with one and several threads
+UP_TEST( PotentialTripletTersoff_threads )
+    {
+    tersoff_force_thread_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
@@ -68,6 +68,12 @@ public:
     //! Load EAM potential file
     virtual void loadFile(char *filename, int type_of_file);
 
+    //! Get the computes that this force brings up to date in compute()
+    virtual std::vector< std::shared_ptr<Compute> > getDependencies()
+        {
+        return std::vector< std::shared_ptr<Compute> >(1, m_nlist);
+        }
+
 protected:
     std::shared_ptr<NeighborList> m_nlist; //!< the neighborlist to use for the computation
     Scalar m_r_cut;                        //!< cut-off radius
@@ -33,6 +33,10 @@ mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
     m_max_grid_shift = 0.5 * m_cell_size;
     m_origin_idx = make_int3(0,0,0);
 
+    m_prebinned = false;
+    m_prebin_shift = make_scalar3(0.0,0.0,0.0);
+    m_prebin_N = 0;
+
     resetConditions();
 
     #ifdef ENABLE_MPI
@@ -290,6 +294,9 @@ void mpcd::CellList::computeDimensions()
     // reallocate per-cell memory
     reallocate();
 
+    // any cells computed outside the cell list refer to the old dimensions
+    m_prebinned = false;
+
     // dimensions are now current
     m_needs_compute_dim = false;
     notifySizeChange();
@@ -494,10 +501,39 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
 /*!
  * \param timestep Current simulation timestep
  */
+/*!
+ * \param shift Grid shift to bin with
+ * \returns A binner for the local cells of the current dimensions
+ */
+mpcd::detail::CellBinner mpcd::CellList::getBinner(const Scalar3& shift)
+    {
+    computeDimensions();
+
+    mpcd::detail::CellBinner binner;
+    binner.shift = shift;
+    binner.global_lo = m_pdata->getGlobalBox().getLo();
+    binner.cell_size = m_cell_size;
+
+    // total effective number of cells in the global box, optionally padded by
+    // extra cells in MPI simulations
+    binner.n_global_cells = m_global_cell_dim;
+    #ifdef ENABLE_MPI
+    if (isCommunicating(mpcd::detail::face::east)) binner.n_global_cells.x += 2*m_num_extra;
+    if (isCommunicating(mpcd::detail::face::north)) binner.n_global_cells.y += 2*m_num_extra;
+    if (isCommunicating(mpcd::detail::face::up)) binner.n_global_cells.z += 2*m_num_extra;
+    #endif // ENABLE_MPI
+
+    binner.periodic = m_pdata->getBox().getPeriodic();
+    binner.origin_idx = m_origin_idx;
+    binner.cell_dim = m_cell_dim;
+    binner.cell_indexer = m_cell_indexer;
+
+    return binner;
+    }
+
 void mpcd::CellList::buildCellList()
     {
-    const BoxDim& box = m_pdata->getBox();
-    const uchar3 periodic = box.getPeriodic();
+    const mpcd::detail::CellBinner binner = getBinner(m_grid_shift);
 
     ArrayHandle<unsigned int> h_cell_list(m_cell_list, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
@@ -511,6 +547,12 @@ void mpcd::CellList::buildCellList()
     unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
+    // particles binned during streaming only need to be scattered into their cells,
+    // otherwise the cells are overwritten below and no longer match the prebinned shift
+    const unsigned int N_prebinned = (isPrebinned()) ? m_prebin_N : 0;
+    if (N_prebinned == 0)
+        m_prebinned = false;
+
     // we can't modify the velocity of embedded particles, so we only read their position
     std::unique_ptr< ArrayHandle<unsigned int> > h_embed_cell_ids;
     std::unique_ptr< ArrayHandle<Scalar4> > h_pos_embed;
@@ -523,82 +565,42 @@ void mpcd::CellList::buildCellList()
         N_tot += m_embed_group->getNumMembers();
         }
 
-    // total effective number of cells in the global box, optionally padded by
-    // extra cells in MPI simulations
-    uint3 n_global_cells = m_global_cell_dim;
-    #ifdef ENABLE_MPI
-    if (isCommunicating(mpcd::detail::face::east)) n_global_cells.x += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::north)) n_global_cells.y += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::up)) n_global_cells.z += 2*m_num_extra;
-    #endif // ENABLE_MPI
-
-    const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
-
     for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
         {
-        Scalar4 postype_i;
-        if (cur_p < N_mpcd)
-            {
-            postype_i = h_pos.data[cur_p];
-            }
-        else
-            {
-            postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
-            }
-        Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
-
-        if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
+        unsigned int bin_idx = mpcd::detail::NO_CELL;
+        if (cur_p < N_prebinned)
             {
-            conditions.y = cur_p + 1;
-            continue;
+            bin_idx = __scalar_as_int(h_vel.data[cur_p].w);
             }
 
-        // bin particle assuming orthorhombic box (already validated)
-        const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
-        int3 global_bin = make_int3(std::floor(delta.x / m_cell_size),
-                                    std::floor(delta.y / m_cell_size),
-                                    std::floor(delta.z / m_cell_size));
-
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-        // this is done using periodic from the "local" box, since this will be periodic
-        // only when there is one rank along the dimension
-        if (periodic.x)
-            {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
-            }
-        if (periodic.y)
-            {
-            if (global_bin.y == (int)n_global_cells.y)
-                global_bin.y = 0;
-            else if (global_bin.y == -1)
-                global_bin.y = n_global_cells.y - 1;
-            }
-        if (periodic.z)
+        if (bin_idx == mpcd::detail::NO_CELL)
             {
-            if (global_bin.z == (int)n_global_cells.z)
-                global_bin.z = 0;
-            else if (global_bin.z == -1)
-                global_bin.z = n_global_cells.z - 1;
-            }
+            Scalar4 postype_i;
+            if (cur_p < N_mpcd)
+                {
+                postype_i = h_pos.data[cur_p];
+                }
+            else
+                {
+                postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+                }
+            Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-        // compute the local cell
-        int3 bin = make_int3(global_bin.x - m_origin_idx.x,
-                             global_bin.y - m_origin_idx.y,
-                             global_bin.z - m_origin_idx.z);
+            if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
+                {
+                conditions.y = cur_p + 1;
+                continue;
+                }
 
-        // validate and make sure no particles blew out of the box
-        if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) ||
-            (bin.y < 0 || bin.y >= (int)m_cell_dim.y) ||
-            (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
-            {
-            conditions.z = cur_p + 1;
-            continue;
+            // validate and make sure no particles blew out of the box
+            bin_idx = binner(pos_i);
+            if (bin_idx == mpcd::detail::NO_CELL)
+                {
+                conditions.z = cur_p + 1;
+                continue;
+                }
             }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
         unsigned int offset = h_cell_np.data[bin_idx];
         if (offset < m_cell_np_max)
             {
@@ -26,9 +26,80 @@
 #include "hoomd/extern/pybind/include/pybind11/pybind11.h"
 
 #include <array>
+#include <cmath>
 
 namespace mpcd
 {
+namespace detail
+{
+//! Bins positions into the local cells of a grid-shifted MPCD cell list
+/*!
+ * The binner holds a copy of the cell list geometry so that a streaming method can compute cell membership
+ * while it moves the particles. Positions that are NaN or lie outside the local cells are binned to NO_CELL.
+ */
+struct CellBinner
+    {
+    Scalar3 shift;          //!< Grid shift
+    Scalar3 global_lo;      //!< Lower bound of the global box
+    Scalar cell_size;       //!< MPCD cell width
+    uint3 n_global_cells;   //!< Number of global cells, including any extra communication cells
+    uchar3 periodic;        //!< Periodic flags of the local box
+    int3 origin_idx;        //!< Global index of the local origin cell
+    uint3 cell_dim;         //!< Number of local cells in each dimension
+    Index3D cell_indexer;   //!< Indexer from 3D into local cell index
+
+    //! Compute the local cell index of a position
+    unsigned int operator()(const Scalar3& pos) const
+        {
+        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+            return NO_CELL;
+
+        // bin particle assuming orthorhombic box (already validated)
+        const Scalar3 delta = (pos - shift) - global_lo;
+        int3 global_bin = make_int3(std::floor(delta.x / cell_size),
+                                    std::floor(delta.y / cell_size),
+                                    std::floor(delta.z / cell_size));
+
+        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+        // this is done using periodic from the "local" box, since this will be periodic
+        // only when there is one rank along the dimension
+        if (periodic.x)
+            {
+            if (global_bin.x == (int)n_global_cells.x)
+                global_bin.x = 0;
+            else if (global_bin.x == -1)
+                global_bin.x = n_global_cells.x - 1;
+            }
+        if (periodic.y)
+            {
+            if (global_bin.y == (int)n_global_cells.y)
+                global_bin.y = 0;
+            else if (global_bin.y == -1)
+                global_bin.y = n_global_cells.y - 1;
+            }
+        if (periodic.z)
+            {
+            if (global_bin.z == (int)n_global_cells.z)
+                global_bin.z = 0;
+            else if (global_bin.z == -1)
+                global_bin.z = n_global_cells.z - 1;
+            }
+
+        // compute the local cell
+        const int3 bin = make_int3(global_bin.x - origin_idx.x,
+                                   global_bin.y - origin_idx.y,
+                                   global_bin.z - origin_idx.z);
+
+        // particles that blew out of the box have no cell
+        if ((bin.x < 0 || bin.x >= (int)cell_dim.x) ||
+            (bin.y < 0 || bin.y >= (int)cell_dim.y) ||
+            (bin.z < 0 || bin.z >= (int)cell_dim.z))
+            return NO_CELL;
+
+        return cell_indexer(bin.x, bin.y, bin.z);
+        }
+    };
+} // end namespace detail
 
 //! Computes the MPCD cell list on the CPU
 class PYBIND11_EXPORT CellList : public Compute
@@ -200,6 +271,31 @@ class PYBIND11_EXPORT CellList : public Compute
             return m_grid_shift;
             }
 
+        //! Get a binner for the local cells with a grid shift
+        mpcd::detail::CellBinner getBinner(const Scalar3& shift);
+
+        //! Mark the MPCD particles as already binned with a grid shift
+        /*!
+         * \param shift Grid shift used to bin the particles
+         * \param N Number of MPCD particles that were binned
+         *
+         * The cell index of each binned particle must be stored in the w component of its velocity.
+         * buildCellList() then only scatters these particles into the cells when it is called with the same
+         * grid shift, instead of binning them again.
+         */
+        void setPrebinned(const Scalar3& shift, unsigned int N)
+            {
+            m_prebinned = true;
+            m_prebin_shift = shift;
+            m_prebin_N = N;
+            }
+
+        //! Clear the binning done outside of the cell list
+        void clearPrebinned()
+            {
+            m_prebinned = false;
+            }
+
         //! Calculate current cell occupancy statistics
         virtual void getCellStatistics() const;
 
@@ -261,6 +357,20 @@ class PYBIND11_EXPORT CellList : public Compute
 
         int3 m_origin_idx;                  //!< Origin as a global index
 
+        bool m_prebinned;           //!< True if the MPCD particles have been binned outside the cell list
+        Scalar3 m_prebin_shift;     //!< Grid shift used to bin the MPCD particles
+        unsigned int m_prebin_N;    //!< Number of MPCD particles that were binned
+
+        //! Check if the MPCD particles can be scattered into the cells without binning them
+        bool isPrebinned() const
+            {
+            return (m_prebinned &&
+                    m_prebin_N == m_mpcd_pdata->getN() &&
+                    m_prebin_shift.x == m_grid_shift.x &&
+                    m_prebin_shift.y == m_grid_shift.y &&
+                    m_prebin_shift.z == m_grid_shift.z);
+            }
+
         #ifdef ENABLE_MPI
         unsigned int m_num_extra;               //!< Number of extra cells to communicate over
         std::array<unsigned int, 6> m_num_comm; //!< Number of cells to communicate on each face
@@ -132,18 +132,29 @@ bool mpcd::CollisionMethod::shouldCollide(unsigned int timestep)
  * \param timestep Timestep to set shifting for
  *
  * \post The MPCD cell list has its grid shift set for \a timestep.
+ */
+void mpcd::CollisionMethod::drawGridShift(unsigned int timestep)
+    {
+    m_cl->setGridShift(peekGridShift(timestep));
+    }
+
+/*!
+ * \param timestep Timestep to draw shifting for
+ * \returns The grid shift for \a timestep
  *
  * If grid shifting is enabled, three uniform random numbers are drawn using
  * the Mersenne twister generator. (In two dimensions, only two numbers are drawn.)
+ * The generator is seeded with the timestep, so the same shift is returned every time
+ * this is called for a given \a timestep.
  *
- * If grid shifting is disabled, a zero vector is instead set.
+ * If grid shifting is disabled, a zero vector is instead returned.
  */
-void mpcd::CollisionMethod::drawGridShift(unsigned int timestep)
+Scalar3 mpcd::CollisionMethod::peekGridShift(unsigned int timestep) const
     {
     // return zeros if shifting is off
     if (!m_enable_grid_shift)
         {
-        m_cl->setGridShift(make_scalar3(0.0,0.0,0.0));
+        return make_scalar3(0.0,0.0,0.0);
         }
     else
         {
@@ -158,7 +169,7 @@ void mpcd::CollisionMethod::drawGridShift(unsigned int timestep)
         shift.y = uniform(rng);
         shift.z = (m_sysdef->getNDimensions() == 3) ? uniform(rng) : Scalar(0.0);
 
-        m_cl->setGridShift(shift);
+        return shift;
         }
     }
 
@@ -71,6 +71,9 @@ class PYBIND11_EXPORT CollisionMethod
         //! Generates the random grid shift vector
         void drawGridShift(unsigned int timestep);
 
+        //! Peek at the grid shift vector that will be drawn on a timestep
+        Scalar3 peekGridShift(unsigned int timestep) const;
+
         //! Sets a group of particles that is coupled to the MPCD solvent through the collision step
         /*!
          * \param embed_group Group to embed
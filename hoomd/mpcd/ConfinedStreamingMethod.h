@@ -63,6 +63,21 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
         //! Implementation of the streaming rule
         virtual void stream(unsigned int timestep);
 
+        //! Returns true if stream() may run concurrently with the MD force computes
+        /*!
+         * Validating the geometry reduces over all ranks, so the first step after it changes runs in sequence.
+         */
+        virtual bool isConcurrent() const
+            {
+            return !m_validate_geom;
+            }
+
+        //! Returns true if stream() can bin the particles into the cells of the next collision
+        virtual bool supportsBinning() const
+            {
+            return true;
+            }
+
         //! Get the streaming geometry
         std::shared_ptr<const Geometry> getGeometry() const
             {
@@ -112,6 +127,10 @@ void ConfinedStreamingMethod<Geometry>::stream(unsigned int timestep)
     // acquire polymorphic pointer to the external field
     const mpcd::ExternalField* field = (m_field) ? m_field->get(access_location::host) : nullptr;
 
+    // optionally bin the particles into the cells of the next collision while they are in cache
+    const bool bin = m_bin_next;
+    m_bin_next = false;
+
     for (unsigned int cur_p = 0; cur_p < m_mpcd_pdata->getN(); ++cur_p)
         {
         const Scalar4 postype = h_pos.data[cur_p];
@@ -146,11 +165,16 @@ void ConfinedStreamingMethod<Geometry>::stream(unsigned int timestep)
         box.wrap(pos, image);
 
         h_pos.data[cur_p] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
-        h_vel.data[cur_p] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+        const unsigned int cell = (bin) ? m_binner(pos) : mpcd::detail::NO_CELL;
+        h_vel.data[cur_p] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(cell));
         }
 
     // particles have moved, so the cell cache is no longer valid
     m_mpcd_pdata->invalidateCellCache();
+    if (bin)
+        m_mpcd_sys->getCellList()->setPrebinned(m_binner.shift, m_mpcd_pdata->getN());
+    else
+        m_mpcd_sys->getCellList()->clearPrebinned();
     if (m_prof) m_prof->pop();
     }
 
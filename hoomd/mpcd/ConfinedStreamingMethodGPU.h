@@ -52,6 +52,12 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
         //! Implementation of the streaming rule
         virtual void stream(unsigned int timestep);
 
+        //! Particles are not binned while streaming on the GPU
+        virtual bool supportsBinning() const
+            {
+            return false;
+            }
+
         //! Set autotuner parameters
         /*!
          * \param enable Enable/disable autotuning
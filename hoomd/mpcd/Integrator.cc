@@ -116,19 +116,47 @@ void mpcd::Integrator::update(unsigned int timestep)
         updateRigidBodies(timestep+1);
         }
 
+    // bin the particles into the cells of the next collision while they stream
+    if (useStreamBinning(timestep))
+        {
+        const Scalar3 shift = m_collide->peekGridShift(timestep + m_stream->getPeriod());
+        m_stream->binNextStream(m_mpcd_sys->getCellList()->getBinner(shift));
+        }
+
     // execute the MPCD streaming step now that MD particles are communicated onto their final domains
-    if (m_stream)
+#ifdef ENABLE_TBB
+    if (useConcurrentStreaming(timestep))
         {
-        m_stream->stream(timestep);
+        // streaming only touches the MPCD particles, so it can overlap the MD force computes
+        tbb::task_group stream_task;
+        stream_task.run([this, timestep] { m_stream->stream(timestep); });
+        try
+            {
+            computeNetForce(timestep+1);
+            }
+        catch (...)
+            {
+            stream_task.wait();
+            throw;
+            }
+        stream_task.wait();
         }
+    else
+#endif
+        {
+        if (m_stream)
+            {
+            m_stream->stream(timestep);
+            }
 
-    // compute the net force on the MD particles
+        // compute the net force on the MD particles
 #ifdef ENABLE_CUDA
-    if (m_exec_conf->isCUDAEnabled())
-        computeNetForceGPU(timestep+1);
-    else
+        if (m_exec_conf->isCUDAEnabled())
+            computeNetForceGPU(timestep+1);
+        else
 #endif
-        computeNetForce(timestep+1);
+            computeNetForce(timestep+1);
+        }
 
     // perform the second step of the MD integration
     if (m_prof) m_prof->push("Integrate");
@@ -137,6 +165,49 @@ void mpcd::Integrator::update(unsigned int timestep)
     if (m_prof) m_prof->pop();
     }
 
+/*!
+ * \param timestep Current time step of the simulation
+ * \returns True if the streaming step runs on a TBB worker thread while the MD forces are computed
+ *
+ * Streaming reads and writes only the MPCD particle data, while the MD force computes do not touch it, so the
+ * overlap gives the same result as the sequential order. It is used only on the CPU with more than one TBB thread,
+ * without profiling, when the streaming method supports it and streams at \a timestep.
+ */
+bool mpcd::Integrator::useConcurrentStreaming(unsigned int timestep) const
+    {
+    #ifdef ENABLE_TBB
+    if (!m_stream || m_exec_conf->getNumThreads() <= 1 || m_prof || m_exec_conf->isCUDAEnabled())
+        return false;
+
+    return m_stream->isConcurrent() && m_stream->peekStream(timestep);
+    #else
+    return false;
+    #endif
+    }
+
+/*!
+ * \param timestep Current time step of the simulation
+ * \returns True if the streaming step at \a timestep bins the particles into the cells of the next collision
+ *
+ * The particles stream directly before a collision when the next streaming step is also a collision step, so
+ * their cells are computed with the grid shift of that collision while they are moved. Binning is only done on
+ * the CPU without MPCD communication, since communication migrates particles between streaming and collision.
+ */
+bool mpcd::Integrator::useStreamBinning(unsigned int timestep) const
+    {
+    if (!m_stream || !m_collide || m_exec_conf->isCUDAEnabled())
+        return false;
+
+    #ifdef ENABLE_MPI
+    if (m_mpcd_comm)
+        return false;
+    #endif // ENABLE_MPI
+
+    return (m_stream->supportsBinning() &&
+            m_stream->peekStream(timestep) &&
+            m_collide->peekCollide(timestep + m_stream->getPeriod()));
+    }
+
 /*!
  * \param deltaT new deltaT to set
  * \post \a deltaT is also set on all contained integration methods
@@ -168,6 +168,12 @@ class PYBIND11_EXPORT Integrator : public ::IntegratorTwoStep
             {
             return (m_collide && m_collide->peekCollide(timestep));
             }
+
+        //! Check if the streaming step runs concurrently with the MD force computes
+        bool useConcurrentStreaming(unsigned int timestep) const;
+
+        //! Check if the streaming step bins the particles for the next collision
+        bool useStreamBinning(unsigned int timestep) const;
     };
 
 namespace detail
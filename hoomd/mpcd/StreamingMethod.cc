@@ -25,7 +25,7 @@ mpcd::StreamingMethod::StreamingMethod(std::shared_ptr<mpcd::SystemData> sysdata
       m_pdata(m_sysdef->getParticleData()),
       m_mpcd_pdata(m_mpcd_sys->getParticleData()),
       m_exec_conf(m_pdata->getExecConf()),
-      m_mpcd_dt(0.0), m_period(period)
+      m_mpcd_dt(0.0), m_period(period), m_bin_next(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD StreamingMethod" << std::endl;
 
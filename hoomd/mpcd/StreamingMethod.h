@@ -46,6 +46,16 @@ class PYBIND11_EXPORT StreamingMethod
         //! Peek if the next step requires streaming
         virtual bool peekStream(unsigned int timestep) const;
 
+        //! Returns true if stream() may run concurrently with the MD force computes
+        /*!
+         * mpcd::Integrator runs stream() on a TBB worker thread while the MD forces are computed when this
+         * returns true. stream() may then only modify the MPCD particle data, and must not communicate.
+         */
+        virtual bool isConcurrent() const
+            {
+            return true;
+            }
+
         //! Sets the profiler for the integration method to use
         virtual void setProfiler(std::shared_ptr<Profiler> prof)
             {
@@ -97,6 +107,32 @@ class PYBIND11_EXPORT StreamingMethod
         //! Set the period of the streaming method
         void setPeriod(unsigned int cur_timestep, unsigned int period);
 
+        //! Get the period of the streaming method
+        unsigned int getPeriod() const
+            {
+            return m_period;
+            }
+
+        //! Returns true if stream() can bin the particles into the cells of the next collision
+        virtual bool supportsBinning() const
+            {
+            return false;
+            }
+
+        //! Bin the particles into cells during the next call to stream()
+        /*!
+         * \param binner Binner for the cells of the next collision
+         *
+         * Streaming methods that support binning store the cell of each particle in its velocity as they
+         * move it, and mark the cell list as prebinned so that the next build only scatters the particles.
+         * The request is cleared by the next call to stream().
+         */
+        void binNextStream(const mpcd::detail::CellBinner& binner)
+            {
+            m_binner = binner;
+            m_bin_next = true;
+            }
+
     protected:
         std::shared_ptr<mpcd::SystemData> m_mpcd_sys;                   //!< MPCD system data
         std::shared_ptr<SystemDefinition> m_sysdef;                     //!< HOOMD system definition
@@ -111,6 +147,9 @@ class PYBIND11_EXPORT StreamingMethod
 
         std::shared_ptr<hoomd::GPUPolymorph<mpcd::ExternalField>> m_field;  //!< External field
 
+        bool m_bin_next;                    //!< If true, bin the particles during the next stream
+        mpcd::detail::CellBinner m_binner;  //!< Binner for the cells of the next collision
+
         //! Check if streaming should occur
         virtual bool shouldStream(unsigned int timestep);
     };
@@ -9,8 +9,13 @@
 #include "hoomd/mpcd/ConfinedStreamingMethodGPU.h"
 #endif // ENABLE_CUDA
 
+#include "hoomd/mpcd/Integrator.h"
+#include "hoomd/md/TwoStepNVE.h"
+#include "hoomd/ConstForceCompute.h"
+
 #include "hoomd/SnapshotSystemData.h"
 #include "hoomd/test/upp11_config.h"
+#include "hoomd/test/thread_test_utils.h"
 
 HOOMD_UP_MAIN()
 
@@ -105,12 +110,138 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
         }
     }
 
+//! Test that binning the particles while streaming gives the same cell list as binning after streaming
+void streaming_method_binning_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(10.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(4);
+
+        mpcd_snap->position[0] = vec3<Scalar>(1.0, 4.85, 3.0);
+        mpcd_snap->position[1] = vec3<Scalar>(-3.0, -4.75, -1.0);
+        mpcd_snap->position[2] = vec3<Scalar>(4.9, 0.2, -4.9);
+        mpcd_snap->position[3] = vec3<Scalar>(0.45, 0.45, 0.45);
+
+        mpcd_snap->velocity[0] = vec3<Scalar>(1.0, 1.0, 1.0);
+        mpcd_snap->velocity[1] = vec3<Scalar>(-1.0, -1.0, -1.0);
+        mpcd_snap->velocity[2] = vec3<Scalar>(1.0, 0.0, -1.0);
+        mpcd_snap->velocity[3] = vec3<Scalar>(0.5, 0.5, -0.5);
+        }
+
+    // stream two copies of the system, binning only one of them while streaming
+    auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+    std::shared_ptr<mpcd::SystemData> mpcd_sys[2];
+    std::shared_ptr<mpcd::StreamingMethod> stream[2];
+    for (unsigned int i = 0; i < 2; ++i)
+        {
+        mpcd_sys[i] = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+        stream[i] = std::make_shared< mpcd::ConfinedStreamingMethod<mpcd::detail::BulkGeometry> >(mpcd_sys[i], 0, 1, -1, geom);
+        stream[i]->setDeltaT(0.1);
+        }
+    UP_ASSERT(stream[0]->supportsBinning());
+
+    // the second shift differs from the binned one, so the cell list has to bin the particles itself
+    const Scalar3 shifts[] = {make_scalar3(0.4, -0.3, 0.2), make_scalar3(-0.1, 0.25, 0.0)};
+    for (unsigned int step = 0; step < 2; ++step)
+        {
+        stream[0]->binNextStream(mpcd_sys[0]->getCellList()->getBinner(shifts[0]));
+        for (unsigned int i = 0; i < 2; ++i)
+            {
+            stream[i]->stream(step);
+            mpcd_sys[i]->getCellList()->setGridShift(shifts[step]);
+            mpcd_sys[i]->getCellList()->compute(step);
+            }
+
+        std::shared_ptr<mpcd::CellList> cl_0 = mpcd_sys[0]->getCellList();
+        std::shared_ptr<mpcd::CellList> cl_1 = mpcd_sys[1]->getCellList();
+        ArrayHandle<unsigned int> h_np_0(cl_0->getCellSizeArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_np_1(cl_1->getCellSizeArray(), access_location::host, access_mode::read);
+        for (unsigned int cell = 0; cell < cl_0->getNCells(); ++cell)
+            {
+            UP_ASSERT_EQUAL(h_np_0.data[cell], h_np_1.data[cell]);
+            }
+
+        ArrayHandle<Scalar4> h_vel_0(mpcd_sys[0]->getParticleData()->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel_1(mpcd_sys[1]->getParticleData()->getVelocities(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < 4; ++i)
+            {
+            UP_ASSERT_EQUAL(__scalar_as_int(h_vel_0.data[i].w), __scalar_as_int(h_vel_1.data[i].w));
+            }
+        }
+    }
+
+#ifdef ENABLE_TBB
+//! Test that streaming concurrently with the MD forces gives the same result as streaming in sequence
+void streaming_method_concurrent_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    check_threads_identical(exec_conf, [&]() -> std::vector<Scalar>
+        {
+        std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+        snap->global_box = BoxDim(10.0);
+        snap->particle_data.type_mapping.push_back("A");
+        snap->particle_data.resize(2);
+        snap->particle_data.pos[0] = vec3<Scalar>(1.0, 2.0, 3.0);
+        snap->particle_data.pos[1] = vec3<Scalar>(-2.0, -1.0, 0.5);
+        snap->particle_data.vel[0] = vec3<Scalar>(0.5, -0.5, 1.0);
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+        auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+            {
+            auto mpcd_snap = mpcd_sys_snap->particles;
+            mpcd_snap->resize(2);
+
+            mpcd_snap->position[0] = vec3<Scalar>(1.0, 4.85, 3.0);
+            mpcd_snap->position[1] = vec3<Scalar>(-3.0, -4.75, -1.0);
+
+            mpcd_snap->velocity[0] = vec3<Scalar>(1.0, 1.0, 1.0);
+            mpcd_snap->velocity[1] = vec3<Scalar>(-1.0, -1.0, -1.0);
+            }
+        auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+
+        // stream every step, alongside a constant force integrated with NVE
+        auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+        auto stream = std::make_shared< mpcd::ConfinedStreamingMethod<mpcd::detail::BulkGeometry> >(mpcd_sys, 0, 1, -1, geom);
+        std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorAll(sysdef));
+        std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+        auto nve = std::make_shared<TwoStepNVE>(sysdef, group_all);
+        auto force = std::make_shared<ConstForceCompute>(sysdef, 0.5, -0.25, 1.0);
+
+        auto integrator = std::make_shared<mpcd::Integrator>(mpcd_sys, 0.05);
+        integrator->addIntegrationMethod(nve);
+        integrator->addForceCompute(force);
+        integrator->setStreamingMethod(stream);
+        integrator->prepRun(0);
+        for (unsigned int i = 0; i < 5; i++)
+            integrator->update(i);
+
+        std::vector<Scalar> values;
+        ArrayHandle<Scalar4> h_md_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_mpcd_pos(mpcd_sys->getParticleData()->getPositions(), access_location::host, access_mode::read);
+        append_values(values, h_md_pos.data, 2);
+        append_values(values, h_mpcd_pos.data, 2);
+        return values;
+        });
+    }
+#endif // ENABLE_TBB
+
 //! basic test case for MPCD StreamingMethod class
 UP_TEST( mpcd_streaming_method_basic )
     {
     typedef mpcd::ConfinedStreamingMethod<mpcd::detail::BulkGeometry> method;
     streaming_method_basic_test<method>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
     }
+//! test case for binning the particles while streaming
+UP_TEST( mpcd_streaming_method_binning )
+    {
+    streaming_method_binning_test(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
 #ifdef ENABLE_CUDA
 //! basic test case for MPCD StreamingMethod class
 UP_TEST( mpcd_streaming_method_setup )
@@ -119,3 +250,11 @@ UP_TEST( mpcd_streaming_method_setup )
     streaming_method_basic_test<method>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
 #endif // ENABLE_CUDA
+
+#ifdef ENABLE_TBB
+//! test case for streaming concurrently with the MD force computes
+UP_TEST( mpcd_streaming_method_concurrent )
+    {
+    streaming_method_concurrent_test(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+#endif // ENABLE_TBB
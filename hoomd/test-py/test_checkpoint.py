@@ -0,0 +1,61 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+import hoomd;
+import unittest
+import os
+import numpy
+import tempfile
+
+# unit tests for dump.checkpoint and init.read_checkpoint
+class checkpoint_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+        # every rank writes its own file, the base name must be the same on all ranks
+        self.base = os.path.join(tempfile.gettempdir(), 'test_checkpoint');
+
+        snapshot = data.make_snapshot(N=4, box=data.boxdim(L=10), particle_types=['A', 'B'], bond_types=['b']);
+        if comm.get_rank() == 0:
+            snapshot.particles.position[:] = [[-2,-2,-2], [-2.5,-2,-2], [2,2,2], [2.5,2,2]];
+            snapshot.particles.velocity[:] = [[1,0,0], [0,1,0], [0,0,1], [1,1,1]];
+            snapshot.particles.typeid[:] = [0,1,0,1];
+            snapshot.bonds.resize(2);
+            snapshot.bonds.group[:] = [[0,1], [2,3]];
+        self.s = init.read_snapshot(snapshot);
+
+    # test that a checkpoint restores the particles, bonds, and time step
+    def test_round_trip(self):
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+        run(10);
+
+        cp = dump.checkpoint(filename=self.base, period=None);
+        cp.write();
+        ref = self.s.take_snapshot(bonds=True);
+
+        context.initialize();
+        s = init.read_checkpoint(self.base);
+        self.assertEqual(get_step(), 10);
+        snap = s.take_snapshot(bonds=True);
+
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, ref.particles.N);
+            self.assertEqual(snap.particles.types, ref.particles.types);
+            numpy.testing.assert_array_almost_equal(snap.particles.position, ref.particles.position);
+            numpy.testing.assert_array_almost_equal(snap.particles.velocity, ref.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.typeid, ref.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+            self.assertEqual(snap.bonds.N, 2);
+            numpy.testing.assert_array_equal(snap.bonds.group, ref.bonds.group);
+
+    def tearDown(self):
+        comm.barrier_all();
+        if comm.get_rank() == 0:
+            for i in range(comm.get_num_ranks()):
+                fname = self.base + '.' + str(i);
+                if os.path.exists(fname):
+                    os.remove(fname);
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -154,6 +154,67 @@ class gsd_write_tests (unittest.TestCase):
         if comm.get_rank() == 0:
             self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=1);
 
+    # test compressed and quantized chunks
+    def test_compress(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, time_step=0, overwrite=True,
+                 compress=True, precision=1e-4);
+        snap = data.gsd_snapshot(self.tmp_file, frame=0);
+        if comm.get_rank() == 0:
+            numpy.testing.assert_array_equal(snap.particles.typeid, [0,0,1,1]);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+            numpy.testing.assert_array_equal(snap.dihedrals.group, self.snapshot.dihedrals.group);
+            numpy.testing.assert_allclose(snap.particles.position, self.snapshot.particles.position, atol=1e-4*30);
+            numpy.testing.assert_allclose(snap.particles.velocity, self.snapshot.particles.velocity, atol=1e-4*15);
+
+    # test that quantization is only available with the explicit compression option
+    def test_precision_requires_compress(self):
+        self.assertRaises(ValueError, dump.gsd, filename=self.tmp_file, group=group.all(), period=None, time_step=0,
+                          overwrite=True, precision=1e-4);
+
+    # test delta frames and field groups
+    def test_delta(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, dynamic=['momentum'],
+                 keyframe_period=3, tolerance=0.05, field_groups={'particles/velocity': group.tags(0, 1)});
+
+        positions = []
+        for i in range(5):
+            positions.append([list(self.s.particles[j].position) for j in range(4)]);
+            run(1);
+            p = self.s.particles[0].position;
+            self.s.particles[0].position = (p[0] + 0.1, p[1], p[2]);
+            p = self.s.particles[1].position;
+            self.s.particles[1].position = (p[0] + 0.02, p[1], p[2]);
+
+        for i in range(5):
+            snap = data.gsd_snapshot(self.tmp_file, frame=i);
+            if comm.get_rank() == 0:
+                numpy.testing.assert_allclose(snap.particles.position[0], positions[i][0], atol=1e-5);
+                numpy.testing.assert_allclose(snap.particles.position, positions[i], atol=0.05);
+                numpy.testing.assert_allclose(snap.particles.velocity[0:2], self.snapshot.particles.velocity[0:2]);
+                numpy.testing.assert_array_equal(snap.particles.velocity[2:4], numpy.zeros((2,3)));
+
+        if comm.get_rank() == 0:
+            self.assertRaises(ValueError, dump.gsd, filename=self.tmp_file, group=group.all(), period=None,
+                              keyframe_period=0);
+
+    # test that unchanged topology is skipped and changed topology is written
+    def test_dynamic_topology(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, dynamic=['topology']);
+        run(3);
+        self.s.bonds.add('b1', 0, 2);
+        run(2);
+
+        for i in range(5):
+            snap = data.gsd_snapshot(self.tmp_file, frame=i);
+            if comm.get_rank() == 0:
+                if i < 3:
+                    numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+                else:
+                    self.assertEqual(snap.bonds.N, 3);
+                    numpy.testing.assert_array_equal(snap.bonds.group[2], [0, 2]);
+                numpy.testing.assert_array_equal(snap.angles.group, self.snapshot.angles.group);
+
     # tests init.read_gsd
     def test_read_gsd(self):
         dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True);
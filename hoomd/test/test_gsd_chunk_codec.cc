@@ -0,0 +1,104 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+
+#include "hoomd/GSDChunkCodec.h"
+
+using namespace std;
+
+/*! \file test_gsd_chunk_codec.cc
+    \brief Implements unit tests for GSDChunkCodec
+    \ingroup unit_tests
+*/
+
+//! Lossless round trip of an integer array spanning several blocks, including a partial decode
+UP_TEST( lossless_round_trip )
+    {
+    unsigned int N = GSDChunkCodec::getBlockRows()*2 + 17;
+    std::vector<int32_t> data(N*3);
+    for (unsigned int i = 0; i < N*3; i++)
+        data[i] = (i % 7 == 0) ? int32_t(i % 5) - 2 : 0;
+
+    std::vector<char> encoded;
+    GSDChunkCodec::encodeLossless(data.data(), GSD_TYPE_INT32, N, 3, encoded);
+    UP_ASSERT(encoded.size() < data.size()*sizeof(int32_t));
+
+    GSDChunkCodec::Header header = GSDChunkCodec::readHeader(encoded.data(), encoded.size());
+    UP_ASSERT_EQUAL(header.N, N);
+    UP_ASSERT_EQUAL(header.M, (unsigned int)3);
+    UP_ASSERT_EQUAL(header.type, (unsigned int)GSD_TYPE_INT32);
+
+    std::vector<int32_t> decoded(N*3);
+    GSDChunkCodec::decode(encoded.data(), encoded.size(), 0, N, decoded.data());
+    UP_ASSERT(decoded == data);
+
+    // decode a range of rows that crosses a block boundary
+    unsigned int first = GSDChunkCodec::getBlockRows() - 5;
+    unsigned int count = 100;
+    std::vector<int32_t> partial(count*3);
+    GSDChunkCodec::decode(encoded.data(), encoded.size(), first, count, partial.data());
+    for (unsigned int i = 0; i < count*3; i++)
+        UP_ASSERT_EQUAL(partial[i], data[first*3 + i]);
+    }
+
+//! Quantized values are within half a quantum of the input
+UP_TEST( quantized_error_bound )
+    {
+    unsigned int N = 1000;
+    std::vector<float> data(N*3);
+    for (unsigned int i = 0; i < N*3; i++)
+        data[i] = float(i % 97) * 0.1037f - 5.0f;
+
+    std::vector<double> quantum {1e-3, 2e-3, 4e-3};
+    std::vector<char> encoded;
+    GSDChunkCodec::encodeQuantized(data.data(), N, 3, quantum, encoded);
+    UP_ASSERT(encoded.size() < data.size()*sizeof(float)/2);
+
+    std::vector<float> decoded(N*3);
+    GSDChunkCodec::decode(encoded.data(), encoded.size(), 0, N, decoded.data());
+    for (unsigned int i = 0; i < N*3; i++)
+        UP_ASSERT(std::abs(decoded[i] - data[i]) <= quantum[i % 3]/2 + 1e-6);
+    }
+
+//! Corrupt and out of range inputs raise exceptions
+UP_TEST( invalid_input )
+    {
+    std::vector<float> data {1.0f, 1e30f};
+    std::vector<char> encoded;
+    bool except = false;
+    try
+        {
+        GSDChunkCodec::encodeQuantized(data.data(), 2, 1, std::vector<double>(1, 1e-3), encoded);
+        }
+    catch (const std::runtime_error&)
+        {
+        except = true;
+        }
+    UP_ASSERT(except);
+
+    std::vector<uint32_t> ints {1, 2, 3};
+    GSDChunkCodec::encodeLossless(ints.data(), GSD_TYPE_UINT32, 3, 1, encoded);
+    encoded.resize(encoded.size() - 1);
+    std::vector<uint32_t> decoded(3);
+    except = false;
+    try
+        {
+        GSDChunkCodec::decode(encoded.data(), encoded.size(), 0, 3, decoded.data());
+        }
+    catch (const std::runtime_error&)
+        {
+        except = true;
+        }
+    UP_ASSERT(except);
+    }
@@ -0,0 +1,101 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file thread_test_utils.h
+    \brief Helpers for unit tests that compare results computed with one and with several threads
+    \note Include after upp11_config.h
+*/
+
+#ifndef __THREAD_TEST_UTILS_H__
+#define __THREAD_TEST_UTILS_H__
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+//! Append the components of \a n Scalar4 values to \a values
+inline void append_values(std::vector<Scalar>& values, const Scalar4 *data, unsigned int n)
+    {
+    for (unsigned int i = 0; i < n; i++)
+        {
+        values.push_back(data[i].x);
+        values.push_back(data[i].y);
+        values.push_back(data[i].z);
+        values.push_back(data[i].w);
+        }
+    }
+
+//! Append \a n Scalar values to \a values
+inline void append_values(std::vector<Scalar>& values, const Scalar *data, unsigned int n)
+    {
+    values.insert(values.end(), data, data + n);
+    }
+
+//! Run a test with one and with several threads and return both results
+/*! \param exec_conf Execution configuration of the test system
+    \param run Sets up and runs the test, returns the values to compare
+    \param n_threads Number of threads of the second run
+    \param ref Values returned by the serial run (output)
+    \param values Values returned by the threaded run (output)
+*/
+inline void run_serial_and_threaded(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                    const std::function<std::vector<Scalar> ()>& run,
+                                    unsigned int n_threads,
+                                    std::vector<Scalar>& ref,
+                                    std::vector<Scalar>& values)
+    {
+    exec_conf->setNumThreads(1);
+    ref = run();
+    exec_conf->setNumThreads(n_threads);
+    values = run();
+    exec_conf->setNumThreads(1);
+
+    UP_ASSERT_EQUAL(values.size(), ref.size());
+    }
+
+//! Check that a test gives bitwise identical results with one and with several threads
+/*! \param exec_conf Execution configuration of the test system
+    \param run Sets up and runs the test, returns the values to compare
+    \param n_threads Number of threads of the second run
+
+    Use this when the threaded code sums in the same order as the serial code.
+*/
+inline void check_threads_identical(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                    const std::function<std::vector<Scalar> ()>& run,
+                                    unsigned int n_threads = 4)
+    {
+    std::vector<Scalar> ref, values;
+    run_serial_and_threaded(exec_conf, run, n_threads, ref, values);
+
+    for (unsigned int i = 0; i < ref.size(); i++)
+        UP_ASSERT_EQUAL(values[i], ref[i]);
+    }
+
+//! Check that a test gives close results with one and with several threads
+/*! \param exec_conf Execution configuration of the test system
+    \param run Sets up and runs the test, returns the values to compare
+    \param eps Largest allowed mean squared deviation of the values
+    \param n_threads Number of threads of the second run
+
+    Use this when the threaded code sums contributions in a different order than the serial code.
+*/
+inline void check_threads_close(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                const std::function<std::vector<Scalar> ()>& run,
+                                double eps,
+                                unsigned int n_threads = 4)
+    {
+    std::vector<Scalar> ref, values;
+    run_serial_and_threaded(exec_conf, run, n_threads, ref, values);
+
+    double delta2 = 0.0;
+    for (unsigned int i = 0; i < ref.size(); i++)
+        delta2 += double(values[i] - ref[i]) * double(values[i] - ref[i]);
+
+    if (ref.size() > 0)
+        CHECK_SMALL(delta2 / double(ref.size()), eps);
+    }
+
+#endif // __THREAD_TEST_UTILS_H__